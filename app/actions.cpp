@@ -46,12 +46,17 @@
 #endif
 
 namespace fs = std::filesystem;
+using Action::taskErr;
+using Action::taskOut;
 
 // *****************************************************************************
 // local declarations
 namespace {
 std::mutex cs;
 
+thread_local std::ostream* taskOut_ = nullptr;  //!< Output stream of the tasks on this thread, null for std::cout
+thread_local std::ostream* taskErr_ = nullptr;  //!< Error stream of the tasks on this thread, null for std::cerr
+
 //! Helper class to set the timestamp of a file to that of another file
 class Timestamp {
  public:
@@ -129,11 +134,57 @@ std::ostream& operator<<(std::ostream& os, const std::pair<std::string, int>& st
 
 //! Print image Structure information
 int printStructure(std::ostream& out, Exiv2::PrintStructureOption option, const std::string& path);
+
+/*!
+  @brief Return a read filter for the metadata which Print::printList() can
+         print with options -K and -g: the keys of option -K, or only the
+         families selected with option -P with option -v or if option -g
+         is used, as its regular expressions cannot be pushed down.
+ */
+Exiv2::ReadFilter printFilter();
 }  // namespace
 
 // *****************************************************************************
 // class member definitions
 namespace Action {
+std::ostream& taskOut() {
+  return taskOut_ ? *taskOut_ : std::cout;
+}
+
+std::ostream& taskErr() {
+  return taskErr_ ? *taskErr_ : std::cerr;
+}
+
+void taskLogHandler(int level, const char* s) {
+  switch (static_cast<Exiv2::LogMsg::Level>(level)) {
+    case Exiv2::LogMsg::debug:
+      taskErr() << "Debug: ";
+      break;
+    case Exiv2::LogMsg::info:
+      taskErr() << "Info: ";
+      break;
+    case Exiv2::LogMsg::warn:
+      taskErr() << "Warning: ";
+      break;
+    case Exiv2::LogMsg::error:
+      taskErr() << "Error: ";
+      break;
+    default:
+      break;
+  }
+  taskErr() << s;
+}
+
+TaskOutput::TaskOutput(std::ostream& out, std::ostream& err) : prevOut_(taskOut_), prevErr_(taskErr_) {
+  taskOut_ = &out;
+  taskErr_ = &err;
+}
+
+TaskOutput::~TaskOutput() {
+  taskOut_ = prevOut_;
+  taskErr_ = prevErr_;
+}
+
 TaskFactory& TaskFactory::instance() {
   static TaskFactory instance_;
   return instance_;
@@ -180,13 +231,13 @@ static int setModeAndPrintStructure(Exiv2::PrintStructureOption option, const st
         size_t length = code.size();
         for (size_t start = 0; start < length; start += chunk) {
           auto count = std::min<size_t>(chunk, length - start);
-          std::cout << code.substr(start, count) << '\n';
+          taskOut() << code.substr(start, count) << '\n';
         }
       }
     }
   } else {
     _setmode(_fileno(stdout), O_BINARY);
-    result = printStructure(std::cout, option, path);
+    result = printStructure(taskOut(), option, path);
   }
 
   return result;
@@ -205,9 +256,9 @@ int Print::run(const std::string& path) {
       case Params::pmPreview:
         return printPreviewList();
       case Params::pmStructure:
-        return printStructure(std::cout, Exiv2::kpsBasic, path_);
+        return printStructure(taskOut(), Exiv2::kpsBasic, path_);
       case Params::pmRecursive:
-        return printStructure(std::cout, Exiv2::kpsRecursive, path_);
+        return printStructure(taskOut(), Exiv2::kpsRecursive, path_);
       case Params::pmXMP:
         return setModeAndPrintStructure(Exiv2::kpsXMP, path_, binary());
       case Params::pmIccProfile:
@@ -215,17 +266,17 @@ int Print::run(const std::string& path) {
     }
     return 0;
   } catch (const Exiv2::Error& e) {
-    std::cerr << "Exiv2 exception in print action for file " << path << ":\n" << e << "\n";
+    taskErr() << "Exiv2 exception in print action for file " << path << ":\n" << e << "\n";
     return 1;
   } catch (const std::overflow_error& e) {
-    std::cerr << "std::overflow_error exception in print action for file " << path << ":\n" << e.what() << "\n";
+    taskErr() << "std::overflow_error exception in print action for file " << path << ":\n" << e.what() << "\n";
     return 1;
   }
 }
 
 int Print::printSummary() {
   if (!Exiv2::fileExists(path_)) {
-    std::cerr << path_ << ": " << _("Failed to open the file") << "\n";
+    taskErr() << path_ << ": " << _("Failed to open the file") << "\n";
     return -1;
   }
 
@@ -236,22 +287,22 @@ int Print::printSummary() {
 
   // Filename
   printLabel(_("File name"));
-  std::cout << path_ << '\n';
+  taskOut() << path_ << '\n';
 
   // Filesize
   printLabel(_("File size"));
-  std::cout << fs::file_size(path_) << " " << _("Bytes") << '\n';
+  taskOut() << fs::file_size(path_) << " " << _("Bytes") << '\n';
 
   // MIME type
   printLabel(_("MIME type"));
-  std::cout << image->mimeType() << '\n';
+  taskOut() << image->mimeType() << '\n';
 
   // Image size
   printLabel(_("Image size"));
-  std::cout << image->pixelWidth() << " x " << image->pixelHeight() << '\n';
+  taskOut() << image->pixelWidth() << " x " << image->pixelHeight() << '\n';
 
   if (exifData.empty()) {
-    std::cerr << path_ << ": " << _("No Exif data found in the file") << "\n";
+    taskErr() << path_ << ": " << _("No Exif data found in the file") << "\n";
     return -3;
   }
 
@@ -260,16 +311,16 @@ int Print::printSummary() {
   Exiv2::ExifThumbC exifThumb(exifData);
   std::string thumbExt = exifThumb.extension();
   if (thumbExt.empty()) {
-    std::cout << _("None");
+    taskOut() << _("None");
   } else {
     auto dataBuf = exifThumb.copy();
     if (dataBuf.empty()) {
-      std::cout << _("None");
+      taskOut() << _("None");
     } else {
-      std::cout << exifThumb.mimeType() << ", " << dataBuf.size() << " " << _("Bytes");
+      taskOut() << exifThumb.mimeType() << ", " << dataBuf.size() << " " << _("Bytes");
     }
   }
-  std::cout << '\n';
+  taskOut() << '\n';
 
   printTag(exifData, Exiv2::make, _("Camera make"));
   printTag(exifData, Exiv2::model, _("Camera model"));
@@ -291,17 +342,17 @@ int Print::printSummary() {
   printTag(exifData, "Exif.Image.Copyright", _("Copyright"));
   printTag(exifData, "Exif.Photo.UserComment", _("Exif comment"));
 
-  std::cout << '\n';
+  taskOut() << '\n';
 
   return 0;
 }  // Print::printSummary
 
 void Print::printLabel(const std::string& label) const {
-  std::cout << std::setfill(' ') << std::left;
+  taskOut() << std::setfill(' ') << std::left;
   if (Params::instance().files_.size() > 1) {
-    std::cout << std::setw(20) << path_ << " ";
+    taskOut() << std::setw(20) << path_ << " ";
   }
-  std::cout << std::pair(label, align_) << ": ";
+  taskOut() << std::pair(label, align_) << ": ";
 }
 
 int Print::printTag(const Exiv2::ExifData& exifData, const std::string& key, const std::string& label) const {
@@ -312,11 +363,11 @@ int Print::printTag(const Exiv2::ExifData& exifData, const std::string& key, con
   Exiv2::ExifKey ek(key);
   auto md = exifData.findKey(ek);
   if (md != exifData.end()) {
-    md->write(std::cout, &exifData);
+    md->write(taskOut(), &exifData);
     rc = 1;
   }
   if (!label.empty())
-    std::cout << '\n';
+    taskOut() << '\n';
   return rc;
 }  // Print::printTag
 
@@ -328,35 +379,29 @@ int Print::printTag(const Exiv2::ExifData& exifData, EasyAccessFct easyAccessFct
   }
   auto md = easyAccessFct(exifData);
   if (md != exifData.end()) {
-    md->write(std::cout, &exifData);
+    md->write(taskOut(), &exifData);
     rc = 1;
   } else if (easyAccessFctFallback) {
     md = easyAccessFctFallback(exifData);
     if (md != exifData.end()) {
-      md->write(std::cout, &exifData);
+      md->write(taskOut(), &exifData);
       rc = 1;
     }
   }
   if (!label.empty())
-    std::cout << '\n';
+    taskOut() << '\n';
   return rc;
 }  // Print::printTag
 
 int Print::printList() {
   if (!Exiv2::fileExists(path_)) {
-    std::cerr << path_ << ": " << _("Failed to open the file") << "\n";
+    taskErr() << path_ << ": " << _("Failed to open the file") << "\n";
     return -1;
   }
 
   auto image = Exiv2::ImageFactory::open(path_);
+  image->setReadFilter(printFilter());
   image->readMetadata();
-  // Set defaults for metadata types and data columns
-  if (Params::instance().printTags_ == MetadataId::invalid) {
-    Params::instance().printTags_ = MetadataId::exif | MetadataId::iptc | MetadataId::xmp;
-  }
-  if (Params::instance().printItems_ == 0) {
-    Params::instance().printItems_ = Params::prKey | Params::prType | Params::prCount | Params::prTrans;
-  }
   return printMetadata(image.get());
 }  // Print::printList
 
@@ -395,11 +440,11 @@ int Print::printMetadata(const Exiv2::Image* image) {
   // With -v, inform about the absence of any (requested) type of metadata
   if (Params::instance().verbose_) {
     if (noExif)
-      std::cerr << path_ << ": " << _("No Exif data found in the file") << "\n";
+      taskErr() << path_ << ": " << _("No Exif data found in the file") << "\n";
     if (noIptc)
-      std::cerr << path_ << ": " << _("No IPTC data found in the file") << "\n";
+      taskErr() << path_ << ": " << _("No IPTC data found in the file") << "\n";
     if (noXmp)
-      std::cerr << path_ << ": " << _("No XMP data found in the file") << "\n";
+      taskErr() << path_ << ": " << _("No XMP data found in the file") << "\n";
   }
 
   // With -g or -K, return -3 if no matching tags were found
@@ -432,7 +477,7 @@ bool Print::keyTag(const std::string& key) {
 }
 
 static void binaryOutput(const std::ostringstream& os) {
-  std::cout << os.str();
+  taskOut() << os.str();
 }
 
 bool Print::printMetadatum(const Exiv2::Metadatum& md, const Exiv2::Image* pImage) {
@@ -447,79 +492,79 @@ bool Print::printMetadatum(const Exiv2::Metadatum& md, const Exiv2::Image* pImag
 
   bool const manyFiles = Params::instance().files_.size() > 1;
   if (manyFiles) {
-    std::cout << std::setfill(' ') << std::left << std::setw(20) << path_ << "  ";
+    taskOut() << std::setfill(' ') << std::left << std::setw(20) << path_ << "  ";
   }
 
   bool first = true;
   if (Params::instance().printItems_ & Params::prTag) {
     first = false;
-    std::cout << "0x" << std::setw(4) << std::setfill('0') << std::right << std::hex << md.tag();
+    taskOut() << "0x" << std::setw(4) << std::setfill('0') << std::right << std::hex << md.tag();
   }
   if (Params::instance().printItems_ & Params::prSet) {
     if (!first)
-      std::cout << " ";
+      taskOut() << " ";
     first = false;
-    std::cout << "set";
+    taskOut() << "set";
   }
   if (Params::instance().printItems_ & Params::prGroup) {
     if (!first)
-      std::cout << " ";
+      taskOut() << " ";
     first = false;
-    std::cout << std::setw(12) << std::setfill(' ') << std::left << md.groupName();
+    taskOut() << std::setw(12) << std::setfill(' ') << std::left << md.groupName();
   }
   if (Params::instance().printItems_ & Params::prKey) {
     if (!first)
-      std::cout << " ";
+      taskOut() << " ";
     first = false;
-    std::cout << std::setfill(' ') << std::left << std::setw(44) << md.key();
+    taskOut() << std::setfill(' ') << std::left << std::setw(44) << md.key();
   }
   if (Params::instance().printItems_ & Params::prName) {
     if (!first)
-      std::cout << " ";
+      taskOut() << " ";
     first = false;
-    std::cout << std::setw(27) << std::setfill(' ') << std::left << md.tagName();
+    taskOut() << std::setw(27) << std::setfill(' ') << std::left << md.tagName();
   }
   if (Params::instance().printItems_ & Params::prLabel) {
     if (!first)
-      std::cout << " ";
+      taskOut() << " ";
     first = false;
-    std::cout << std::setw(30) << std::setfill(' ') << std::left << md.tagLabel();
+    taskOut() << std::setw(30) << std::setfill(' ') << std::left << md.tagLabel();
   }
   if (Params::instance().printItems_ & Params::prDesc) {
     if (!first)
-      std::cout << " ";
+      taskOut() << " ";
     first = false;
-    std::cout << std::setw(30) << std::setfill(' ') << std::left << md.tagDesc();
+    taskOut() << std::setw(30) << std::setfill(' ') << std::left << md.tagDesc();
   }
   if (Params::instance().printItems_ & Params::prType) {
     if (!first)
-      std::cout << " ";
+      taskOut() << " ";
     first = false;
-    std::cout << std::setw(9) << std::setfill(' ') << std::left;
+    taskOut() << std::setw(9) << std::setfill(' ') << std::left;
     const char* tn = md.typeName();
     if (tn) {
-      std::cout << tn;
+      taskOut() << tn;
     } else {
       std::ostringstream os;
       os << "0x" << std::setw(4) << std::setfill('0') << std::hex << md.typeId();
-      std::cout << os.str();
+      taskOut() << os.str();
     }
   }
   if (Params::instance().printItems_ & Params::prCount) {
     if (!first)
-      std::cout << " ";
+      taskOut() << " ";
     first = false;
-    std::cout << std::dec << std::setw(3) << std::setfill(' ') << std::right << md.count();
+    taskOut() << std::dec << std::setw(3) << std::setfill(' ') << std::right << md.count();
   }
   if (Params::instance().printItems_ & Params::prSize) {
     if (!first)
-      std::cout << " ";
+      taskOut() << " ";
     first = false;
-    std::cout << std::dec << std::setw(3) << std::setfill(' ') << std::right << md.size();
+    taskOut() << std::dec << std::setw(3) << std::setfill(' ') << std::right << md.size();
   }
   if (Params::instance().printItems_ & Params::prValue && md.size() > 0) {
     if (!first)
-      std::cout << "  ";
+      taskOut() << "  ";
     first = false;
     std::ostringstream os;
     // #1114 - show negative values for SByte
@@ -535,7 +580,7 @@ bool Print::printMetadatum(const Exiv2::Metadatum& md, const Exiv2::Image* pImag
   }
   if (Params::instance().printItems_ & Params::prTrans) {
     if (!first)
-      std::cout << "  ";
+      taskOut() << "  ";
     first = false;
     std::ostringstream os;
     os << std::dec << md.print(&pImage->exifData());
@@ -543,35 +588,35 @@ bool Print::printMetadatum(const Exiv2::Metadatum& md, const Exiv2::Image* pImag
   }
   if (Params::instance().printItems_ & Params::prHex) {
     if (!first)
-      std::cout << '\n';
+      taskOut() << '\n';
     if (md.size() > 0) {
       Exiv2::DataBuf buf(md.size());
       md.copy(buf.data(), pImage->byteOrder());
-      Exiv2::hexdump(std::cout, buf.c_data(), buf.size());
+      Exiv2::hexdump(taskOut(), buf.c_data(), buf.size());
     }
   }
-  std::cout << '\n';
+  taskOut() << '\n';
   return true;
 }  // Print::printMetadatum
 
 int Print::printComment() {
   if (!Exiv2::fileExists(path_)) {
-    std::cerr << path_ << ": " << _("Failed to open the file") << "\n";
+    taskErr() << path_ << ": " << _("Failed to open the file") << "\n";
     return -1;
   }
 
   auto image = Exiv2::ImageFactory::open(path_);
   image->readMetadata();
   if (Params::instance().verbose_) {
-    std::cout << _("JPEG comment") << ": ";
+    taskOut() << _("JPEG comment") << ": ";
   }
-  std::cout << image->comment() << '\n';
+  taskOut() << image->comment() << '\n';
   return 0;
 }  // Print::printComment
 
 int Print::printPreviewList() {
   if (!Exiv2::fileExists(path_)) {
-    std::cerr << path_ << ": " << _("Failed to open the file") << "\n";
+    taskErr() << path_ << ": " << _("Failed to open the file") << "\n";
     return -1;
   }
 
@@ -583,13 +628,13 @@ int Print::printPreviewList() {
   Exiv2::PreviewPropertiesList list = pm.getPreviewProperties();
   for (const auto& pos : list) {
     if (manyFiles) {
-      std::cout << std::setfill(' ') << std::left << std::setw(20) << path_ << "  ";
+      taskOut() << std::setfill(' ') << std::left << std::setw(20) << path_ << "  ";
     }
-    std::cout << _("Preview") << " " << ++cnt << ": " << pos.mimeType_ << ", ";
+    taskOut() << _("Preview") << " " << ++cnt << ": " << pos.mimeType_ << ", ";
     if (pos.width_ != 0 && pos.height_ != 0) {
-      std::cout << pos.width_ << "x" << pos.height_ << " " << _("pixels") << ", ";
+      taskOut() << pos.width_ << "x" << pos.height_ << " " << _("pixels") << ", ";
     }
-    std::cout << pos.size_ << " " << _("bytes") << "\n";
+    taskOut() << pos.size_ << " " << _("bytes") << "\n";
   }
   return 0;
 }  // Print::printPreviewList
@@ -601,7 +646,7 @@ Task::UniquePtr Print::clone() const {
 int Rename::run(const std::string& path) {
   try {
     if (!Exiv2::fileExists(path)) {
-      std::cerr << path << ": " << _("Failed to open the file") << "\n";
+      taskErr() << path << ": " << _("Failed to open the file") << "\n";
       return -1;
     }
     Timestamp ts;
@@ -612,25 +657,25 @@ int Rename::run(const std::string& path) {
     image->readMetadata();
     Exiv2::ExifData& exifData = image->exifData();
     if (exifData.empty()) {
-      std::cerr << path << ": " << _("No Exif data found in the file") << "\n";
+      taskErr() << path << ": " << _("No Exif data found in the file") << "\n";
       return -3;
     }
     auto md = exifData.findKey(Exiv2::ExifKey("Exif.Photo.DateTimeOriginal"));
     if (md == exifData.end())
       md = exifData.findKey(Exiv2::ExifKey("Exif.Image.DateTime"));
     if (md == exifData.end()) {
-      std::cerr << _("Neither tag") << " `Exif.Photo.DateTimeOriginal' " << _("nor") << " `Exif.Image.DateTime' "
+      taskErr() << _("Neither tag") << " `Exif.Photo.DateTimeOriginal' " << _("nor") << " `Exif.Image.DateTime' "
                 << _("found in the file") << " " << path << "\n";
       return 1;
     }
     std::string v = md->toString();
     if (v.empty() || v.front() == ' ') {
-      std::cerr << _("Image file creation timestamp not set in the file") << " " << path << "\n";
+      taskErr() << _("Image file creation timestamp not set in the file") << " " << path << "\n";
       return 1;
     }
     std::tm tm;
     if (str2Tm(v, &tm) != 0) {
-      std::cerr << _("Failed to parse timestamp") << " `" << v << "' " << _("in the file") << " " << path << "\n";
+      taskErr() << _("Failed to parse timestamp") << " `" << v << "' " << _("in the file") << " " << path << "\n";
       return 1;
     }
     if (Params::instance().timestamp_ || Params::instance().timestampOnly_) {
@@ -640,7 +685,7 @@ int Rename::run(const std::string& path) {
     std::string newPath = path;
     if (Params::instance().timestampOnly_) {
       if (Params::instance().verbose_) {
-        std::cout << _("Updating timestamp to") << " " << v << '\n';
+        taskOut() << _("Updating timestamp to") << " " << v << '\n';
       }
     } else {
       rc = renameFile(newPath, &tm);
@@ -653,7 +698,7 @@ int Rename::run(const std::string& path) {
     }
     return rc;
   } catch (const Exiv2::Error& e) {
-    std::cerr << "Exiv2 exception in rename action for file " << path << ":\n" << e << "\n";
+    taskErr() << "Exiv2 exception in rename action for file " << path << ":\n" << e << "\n";
     return 1;
   }
 }
@@ -667,7 +712,7 @@ int Erase::run(const std::string& path) {
     path_ = path;
 
     if (!Exiv2::fileExists(path_)) {
-      std::cerr << path_ << ": " << _("Failed to open the file") << "\n";
+      taskErr() << path_ << ": " << _("Failed to open the file") << "\n";
       return -1;
     }
     Timestamp ts;
@@ -697,7 +742,7 @@ int Erase::run(const std::string& path) {
       rc = eraseIccProfile(image.get());
     }
     if (0 == rc && Params::instance().target_ & Params::ctIptcRaw) {
-      rc = printStructure(std::cout, Exiv2::kpsIptcErase, path_);
+      rc = printStructure(taskOut(), Exiv2::kpsIptcErase, path_);
     }
 
     if (0 == rc) {
@@ -708,7 +753,7 @@ int Erase::run(const std::string& path) {
 
     return rc;
   } catch (const Exiv2::Error& e) {
-    std::cerr << "Exiv2 exception in erase action for file " << path << ":\n" << e << "\n";
+    taskErr() << "Exiv2 exception in erase action for file " << path << ":\n" << e << "\n";
     return 1;
   }
 }
@@ -721,14 +766,14 @@ int Erase::eraseThumbnail(Exiv2::Image* image) {
   }
   exifThumb.erase();
   if (Params::instance().verbose_) {
-    std::cout << _("Erasing thumbnail data") << '\n';
+    taskOut() << _("Erasing thumbnail data") << '\n';
   }
   return 0;
 }
 
 int Erase::eraseExifData(Exiv2::Image* image) {
   if (Params::instance().verbose_ && !image->exifData().empty()) {
-    std::cout << _("Erasing Exif data from the file") << '\n';
+    taskOut() << _("Erasing Exif data from the file") << '\n';
   }
   image->clearExifData();
   return 0;
@@ -736,7 +781,7 @@ int Erase::eraseExifData(Exiv2::Image* image) {
 
 int Erase::eraseIptcData(Exiv2::Image* image) {
   if (Params::instance().verbose_ && !image->iptcData().empty()) {
-    std::cout << _("Erasing IPTC data from the file") << '\n';
+    taskOut() << _("Erasing IPTC data from the file") << '\n';
   }
   image->clearIptcData();
   return 0;
@@ -744,7 +789,7 @@ int Erase::eraseIptcData(Exiv2::Image* image) {
 
 int Erase::eraseComment(Exiv2::Image* image) {
   if (Params::instance().verbose_ && !image->comment().empty()) {
-    std::cout << _("Erasing JPEG comment from the file") << '\n';
+    taskOut() << _("Erasing JPEG comment from the file") << '\n';
   }
   image->clearComment();
   return 0;
@@ -752,7 +797,7 @@ int Erase::eraseComment(Exiv2::Image* image) {
 
 int Erase::eraseXmpData(Exiv2::Image* image) {
   if (Params::instance().verbose_ && !image->xmpData().empty()) {
-    std::cout << _("Erasing XMP data from the file") << '\n';
+    taskOut() << _("Erasing XMP data from the file") << '\n';
   }
   image->clearXmpData();  // Quick fix for bug #612
   image->clearXmpPacket();
@@ -760,7 +805,7 @@ int Erase::eraseXmpData(Exiv2::Image* image) {
 }
 int Erase::eraseIccProfile(Exiv2::Image* image) {
   if (Params::instance().verbose_ && image->iccProfileDefined()) {
-    std::cout << _("Erasing ICC Profile data from the file") << '\n';
+    taskOut() << _("Erasing ICC Profile data from the file") << '\n';
   }
   image->clearIccProfile();
   return 0;
@@ -806,32 +851,32 @@ int Extract::run(const std::string& path) {
     }
     return rc;
   } catch (const Exiv2::Error& e) {
-    std::cerr << "Exiv2 exception in extract action for file " << path << ":\n" << e << "\n";
+    taskErr() << "Exiv2 exception in extract action for file " << path << ":\n" << e << "\n";
     return 1;
   }
 }
 
 int Extract::writeThumbnail() const {
   if (!Exiv2::fileExists(path_)) {
-    std::cerr << path_ << ": " << _("Failed to open the file") << "\n";
+    taskErr() << path_ << ": " << _("Failed to open the file") << "\n";
     return -1;
   }
   auto image = Exiv2::ImageFactory::open(path_);
   image->readMetadata();
   Exiv2::ExifData& exifData = image->exifData();
   if (exifData.empty()) {
-    std::cerr << path_ << ": " << _("No Exif data found in the file") << "\n";
+    taskErr() << path_ << ": " << _("No Exif data found in the file") << "\n";
     return -3;
   }
   int rc = 0;
   Exiv2::ExifThumb exifThumb(exifData);
   std::string thumbExt = exifThumb.extension();
   if (thumbExt.empty()) {
-    std::cerr << path_ << ": " << _("Image does not contain an Exif thumbnail") << "\n";
+    taskErr() << path_ << ": " << _("Image does not contain an Exif thumbnail") << "\n";
   } else {
     if ((Params::instance().target_ & Params::ctStdInOut) != 0) {
       Exiv2::DataBuf buf = exifThumb.copy();
-      std::cout.write(buf.c_str(), buf.size());
+      taskOut().write(buf.c_str(), buf.size());
       return 0;
     }
 
@@ -842,13 +887,13 @@ int Extract::writeThumbnail() const {
     if (Params::instance().verbose_) {
       Exiv2::DataBuf buf = exifThumb.copy();
       if (!buf.empty()) {
-        std::cout << _("Writing thumbnail") << " (" << exifThumb.mimeType() << ", " << buf.size() << " " << _("Bytes")
+        taskOut() << _("Writing thumbnail") << " (" << exifThumb.mimeType() << ", " << buf.size() << " " << _("Bytes")
                   << ") " << _("to file") << " " << thumbPath << '\n';
       }
     }
     rc = static_cast<int>(exifThumb.writeFile(thumb));
     if (rc == 0) {
-      std::cerr << path_ << ": " << _("Exif data doesn't contain a thumbnail") << "\n";
+      taskErr() << path_ << ": " << _("Exif data doesn't contain a thumbnail") << "\n";
     }
   }
   return rc;
@@ -856,7 +901,7 @@ int Extract::writeThumbnail() const {
 
 int Extract::writePreviews() const {
   if (!Exiv2::fileExists(path_)) {
-    std::cerr << path_ << ": " << _("Failed to open the file") << "\n";
+    taskErr() << path_ << ": " << _("Failed to open the file") << "\n";
     return -1;
   }
 
@@ -872,16 +917,16 @@ int Extract::writePreviews() const {
     if (num == 0) {
       // Write all previews
       for (num = 0; num < pvList.size(); ++num) {
-        writePreviewFile(pvMgr.getPreviewImage(pvList[num]), num + 1);
+        writePreviewFile(pvMgr, pvList[num], num + 1);
       }
       break;
     }
     num--;
     if (num >= pvList.size()) {
-      std::cerr << path_ << ": " << _("Image does not have preview") << " " << num + 1 << "\n";
+      taskErr() << path_ << ": " << _("Image does not have preview") << " " << num + 1 << "\n";
       continue;
     }
-    writePreviewFile(pvMgr.getPreviewImage(pvList[num]), num + 1);
+    writePreviewFile(pvMgr, pvList[num], num + 1);
   }
   return 0;
 }  // Extract::writePreviews
@@ -889,7 +934,7 @@ int Extract::writePreviews() const {
 int Extract::writeIccProfile(const std::string& target) const {
   int rc = 0;
   if (!Exiv2::fileExists(path_)) {
-    std::cerr << path_ << ": " << _("Failed to open the file") << "\n";
+    taskErr() << path_ << ": " << _("Failed to open the file") << "\n";
     rc = -1;
   }
 
@@ -899,14 +944,14 @@ int Extract::writeIccProfile(const std::string& target) const {
     auto image = Exiv2::ImageFactory::open(path_);
     image->readMetadata();
     if (!image->iccProfileDefined()) {
-      std::cerr << _("No embedded iccProfile: ") << path_ << '\n';
+      taskErr() << _("No embedded iccProfile: ") << path_ << '\n';
       rc = -2;
     } else {
       if (bStdout) {  // -eC-
-        std::cout.write(image->iccProfile().c_str(), image->iccProfile().size());
+        taskOut().write(image->iccProfile().c_str(), image->iccProfile().size());
       } else {
         if (Params::instance().verbose_) {
-          std::cout << _("Writing iccProfile: ") << target << '\n';
+          taskOut() << _("Writing iccProfile: ") << target << '\n';
         }
         Exiv2::FileIo iccFile(target);
         iccFile.open("wb");
@@ -918,21 +963,26 @@ int Extract::writeIccProfile(const std::string& target) const {
   return rc;
 }  // Extract::writeIccProfile
 
-void Extract::writePreviewFile(const Exiv2::PreviewImage& pvImg, size_t num) const {
+void Extract::writePreviewFile(const Exiv2::PreviewManager& pvMgr, const Exiv2::PreviewProperties& pvProps,
+                               size_t num) const {
   std::string pvFile = newFilePath(path_, "-preview") + std::to_string(num);
-  std::string pvPath = pvFile + pvImg.extension();
+  std::string pvPath = pvFile + pvProps.extension_;
   if (dontOverwrite(pvPath))
     return;
   if (Params::instance().verbose_) {
-    std::cout << _("Writing preview") << " " << num << " (" << pvImg.mimeType() << ", ";
-    if (pvImg.width() != 0 && pvImg.height() != 0) {
-      std::cout << pvImg.width() << "x" << pvImg.height() << " " << _("pixels") << ", ";
+    taskOut() << _("Writing preview") << " " << num << " (" << pvProps.mimeType_ << ", ";
+    if (pvProps.width_ != 0 && pvProps.height_ != 0) {
+      taskOut() << pvProps.width_ << "x" << pvProps.height_ << " " << _("pixels") << ", ";
     }
-    std::cout << pvImg.size() << " " << _("bytes") << ") " << _("to file") << " " << pvPath << '\n';
+    taskOut() << pvProps.size_ << " " << _("bytes") << ") " << _("to file") << " " << pvPath << '\n';
+  }
+  Exiv2::FileIo pvIo(pvPath);
+  if (pvIo.open("wb") != 0) {
+    throw Exiv2::Error(Exiv2::ErrorCode::kerFileOpenFailed, pvPath, "wb", Exiv2::strError());
   }
-  auto rc = pvImg.writeFile(pvFile);
+  auto rc = pvMgr.writePreviewImage(pvProps, pvIo);
   if (rc == 0) {
-    std::cerr << path_ << ": " << _("Image does not have preview") << " " << num << "\n";
+    taskErr() << path_ << ": " << _("Image does not have preview") << " " << num << "\n";
   }
 }
 
@@ -945,7 +995,7 @@ int Insert::run(const std::string& path) try {
   bool bStdin = (Params::instance().target_ & Params::ctStdInOut) != 0;
 
   if (!Exiv2::fileExists(path)) {
-    std::cerr << path << ": " << _("Failed to open the file") << "\n";
+    taskErr() << path << ": " << _("Failed to open the file") << "\n";
     return -1;
   }
 
@@ -984,7 +1034,7 @@ int Insert::run(const std::string& path) try {
     ts.touch(path);
   return rc;
 } catch (const Exiv2::Error& e) {
-  std::cerr << "Exiv2 exception in insert action for file " << path << ":\n" << e << "\n";
+  taskErr() << "Exiv2 exception in insert action for file " << path << ":\n" << e << "\n";
   return 1;
 }  // Insert::run
 
@@ -997,11 +1047,11 @@ int Insert::insertXmpPacket(const std::string& path, const std::string& xmpPath)
     rc = insertXmpPacket(path, xmpBlob, true);
   } else {
     if (!Exiv2::fileExists(xmpPath)) {
-      std::cerr << xmpPath << ": " << _("Failed to open the file") << "\n";
+      taskErr() << xmpPath << ": " << _("Failed to open the file") << "\n";
       rc = -1;
     }
     if (rc == 0 && !Exiv2::fileExists(path)) {
-      std::cerr << path << ": " << _("Failed to open the file") << "\n";
+      taskErr() << path << ": " << _("Failed to open the file") << "\n";
       rc = -1;
     }
     if (rc == 0) {
@@ -1035,7 +1085,7 @@ int Insert::insertIccProfile(const std::string& path, const std::string& iccPath
     rc = insertIccProfile(path, std::move(iccProfile));
   } else {
     if (!Exiv2::fileExists(iccProfilePath)) {
-      std::cerr << iccProfilePath << ": " << _("Failed to open the file") << "\n";
+      taskErr() << iccProfilePath << ": " << _("Failed to open the file") << "\n";
       rc = -1;
     } else {
       Exiv2::DataBuf iccProfile = Exiv2::readFile(iccPath);
@@ -1049,7 +1099,7 @@ int Insert::insertIccProfile(const std::string& path, Exiv2::DataBuf&& iccProfil
   int rc = 0;
   // test path exists
   if (!Exiv2::fileExists(path)) {
-    std::cerr << path << ": " << _("Failed to open the file") << "\n";
+    taskErr() << path << ": " << _("Failed to open the file") << "\n";
     rc = -1;
   }
 
@@ -1071,11 +1121,11 @@ int Insert::insertIccProfile(const std::string& path, Exiv2::DataBuf&& iccProfil
 int Insert::insertThumbnail(const std::string& path) {
   std::string thumbPath = newFilePath(path, "-thumb.jpg");
   if (!Exiv2::fileExists(thumbPath)) {
-    std::cerr << thumbPath << ": " << _("Failed to open the file") << "\n";
+    taskErr() << thumbPath << ": " << _("Failed to open the file") << "\n";
     return -1;
   }
   if (!Exiv2::fileExists(path)) {
-    std::cerr << path << ": " << _("Failed to open the file") << "\n";
+    taskErr() << path << ": " << _("Failed to open the file") << "\n";
     return -1;
   }
   auto image = Exiv2::ImageFactory::open(path);
@@ -1094,7 +1144,7 @@ Task::UniquePtr Insert::clone() const {
 int Modify::run(const std::string& path) {
   try {
     if (!Exiv2::fileExists(path)) {
-      std::cerr << path << ": " << _("Failed to open the file") << "\n";
+      taskErr() << path << ": " << _("Failed to open the file") << "\n";
       return -1;
     }
     Timestamp ts;
@@ -1114,7 +1164,7 @@ int Modify::run(const std::string& path) {
 
     return rc;
   } catch (const Exiv2::Error& e) {
-    std::cerr << "Exiv2 exception in modify action for file " << path << ":\n" << e << "\n";
+    taskErr() << "Exiv2 exception in modify action for file " << path << ":\n" << e << "\n";
     return 1;
   }
 }  // Modify::run
@@ -1124,7 +1174,7 @@ int Modify::applyCommands(Exiv2::Image* pImage) {
     // If modify is used when extracting to stdout then ignore verbose
     if (Params::instance().verbose_ &&
         !(Params::instance().action_ & Action::extract && Params::instance().target_ & Params::ctStdInOut)) {
-      std::cout << _("Setting JPEG comment") << " '" << Params::instance().jpegComment_ << "'" << '\n';
+      taskOut() << _("Setting JPEG comment") << " '" << Params::instance().jpegComment_ << "'" << '\n';
     }
     pImage->setComment(Params::instance().jpegComment_);
   }
@@ -1162,7 +1212,7 @@ int Modify::addMetadatum(Exiv2::Image* pImage, const ModifyCmd& modifyCmd) {
   // If modify is used when extracting to stdout then ignore verbose
   if (Params::instance().verbose_ &&
       !(Params::instance().action_ & Action::extract && Params::instance().target_ & Params::ctStdInOut)) {
-    std::cout << _("Add") << " " << modifyCmd.key_ << " \"" << modifyCmd.value_ << "\" ("
+    taskOut() << _("Add") << " " << modifyCmd.key_ << " \"" << modifyCmd.value_ << "\" ("
               << Exiv2::TypeInfo::typeName(modifyCmd.typeId_) << ")" << '\n';
   }
   Exiv2::ExifData& exifData = pImage->exifData();
@@ -1181,7 +1231,7 @@ int Modify::addMetadatum(Exiv2::Image* pImage, const ModifyCmd& modifyCmd) {
       xmpData.add(Exiv2::XmpKey(modifyCmd.key_), value.get());
     }
   } else {
-    std::cerr << _("Warning") << ": " << modifyCmd.key_ << ": " << _("Failed to read") << " "
+    taskErr() << _("Warning") << ": " << modifyCmd.key_ << ": " << _("Failed to read") << " "
               << Exiv2::TypeInfo::typeName(value->typeId()) << " " << _("value") << " \"" << modifyCmd.value_ << "\"\n";
   }
   return rc;
@@ -1193,7 +1243,7 @@ int Modify::setMetadatum(Exiv2::Image* pImage, const ModifyCmd& modifyCmd) {
   // If modify is used when extracting to stdout then ignore verbose
   if (Params::instance().verbose_ &&
       !(Params::instance().action_ & Action::extract && Params::instance().target_ & Params::ctStdInOut)) {
-    std::cout << _("Set") << " " << modifyCmd.key_ << " \"" << modifyCmd.value_ << "\" ("
+    taskOut() << _("Set") << " " << modifyCmd.key_ << " \"" << modifyCmd.value_ << "\" ("
               << Exiv2::TypeInfo::typeName(modifyCmd.typeId_) << ")" << '\n';
   }
   Exiv2::ExifData& exifData = pImage->exifData();
@@ -1244,7 +1294,7 @@ int Modify::setMetadatum(Exiv2::Image* pImage, const ModifyCmd& modifyCmd) {
       }
     }
   } else {
-    std::cerr << _("Warning") << ": " << modifyCmd.key_ << ": " << _("Failed to read") << " "
+    taskErr() << _("Warning") << ": " << modifyCmd.key_ << ": " << _("Failed to read") << " "
               << Exiv2::TypeInfo::typeName(value->typeId()) << " " << _("value") << " \"" << modifyCmd.value_ << "\"\n";
   }
   return rc;
@@ -1254,7 +1304,7 @@ void Modify::delMetadatum(Exiv2::Image* pImage, const ModifyCmd& modifyCmd) {
   // If modify is used when extracting to stdout then ignore verbose
   if (Params::instance().verbose_ &&
       !(Params::instance().action_ & Action::extract && Params::instance().target_ & Params::ctStdInOut)) {
-    std::cout << _("Del") << " " << modifyCmd.key_ << '\n';
+    taskOut() << _("Del") << " " << modifyCmd.key_ << '\n';
   }
 
   Exiv2::ExifData& exifData = pImage->exifData();
@@ -1287,7 +1337,7 @@ void Modify::regNamespace(const ModifyCmd& modifyCmd) {
   // If modify is used when extracting to stdout then ignore verbose
   if (Params::instance().verbose_ &&
       !(Params::instance().action_ & Action::extract && Params::instance().target_ & Params::ctStdInOut)) {
-    std::cout << _("Reg ") << modifyCmd.key_ << "=\"" << modifyCmd.value_ << "\"" << '\n';
+    taskOut() << _("Reg ") << modifyCmd.key_ << "=\"" << modifyCmd.value_ << "\"" << '\n';
   }
   Exiv2::XmpProperties::registerNs(modifyCmd.value_, modifyCmd.key_);
 }
@@ -1303,7 +1353,7 @@ int Adjust::run(const std::string& path) try {
   dayAdjustment_ = Params::instance().yodAdjust_[Params::yodDay].adjustment_;
 
   if (!Exiv2::fileExists(path)) {
-    std::cerr << path << ": " << _("Failed to open the file") << "\n";
+    taskErr() << path << ": " << _("Failed to open the file") << "\n";
     return -1;
   }
   Timestamp ts;
@@ -1314,7 +1364,7 @@ int Adjust::run(const std::string& path) try {
   image->readMetadata();
   Exiv2::ExifData& exifData = image->exifData();
   if (exifData.empty()) {
-    std::cerr << path << ": " << _("No Exif data found in the file") << "\n";
+    taskErr() << path << ": " << _("No Exif data found in the file") << "\n";
     return -3;
   }
   int rc = adjustDateTime(exifData, "Exif.Image.DateTime", path);
@@ -1329,7 +1379,7 @@ int Adjust::run(const std::string& path) try {
   }
   return rc ? 1 : 0;
 } catch (const Exiv2::Error& e) {
-  std::cerr << "Exiv2 exception in adjust action for file " << path << ":\n" << e << "\n";
+  taskErr() << "Exiv2 exception in adjust action for file " << path << ":\n" << e << "\n";
   return 1;
 }  // Adjust::run
 
@@ -1346,54 +1396,54 @@ int Adjust::adjustDateTime(Exiv2::ExifData& exifData, const std::string& key, co
   }
   std::string timeStr = md->toString();
   if (timeStr.empty() || timeStr[0] == ' ') {
-    std::cerr << path << ": " << _("Timestamp of metadatum with key") << " `" << ek << "' " << _("not set") << "\n";
+    taskErr() << path << ": " << _("Timestamp of metadatum with key") << " `" << ek << "' " << _("not set") << "\n";
     return 1;
   }
   if (Params::instance().verbose_) {
     bool comma = false;
-    std::cout << _("Adjusting") << " `" << ek << "' " << _("by");
+    taskOut() << _("Adjusting") << " `" << ek << "' " << _("by");
     if (yearAdjustment_ != 0) {
-      std::cout << (yearAdjustment_ < 0 ? " " : " +") << yearAdjustment_ << " ";
+      taskOut() << (yearAdjustment_ < 0 ? " " : " +") << yearAdjustment_ << " ";
       if (yearAdjustment_ < -1 || yearAdjustment_ > 1) {
-        std::cout << _("years");
+        taskOut() << _("years");
       } else {
-        std::cout << _("year");
+        taskOut() << _("year");
       }
       comma = true;
     }
     if (monthAdjustment_ != 0) {
       if (comma)
-        std::cout << ",";
-      std::cout << (monthAdjustment_ < 0 ? " " : " +") << monthAdjustment_ << " ";
+        taskOut() << ",";
+      taskOut() << (monthAdjustment_ < 0 ? " " : " +") << monthAdjustment_ << " ";
       if (monthAdjustment_ < -1 || monthAdjustment_ > 1) {
-        std::cout << _("months");
+        taskOut() << _("months");
       } else {
-        std::cout << _("month");
+        taskOut() << _("month");
       }
       comma = true;
     }
     if (dayAdjustment_ != 0) {
       if (comma)
-        std::cout << ",";
-      std::cout << (dayAdjustment_ < 0 ? " " : " +") << dayAdjustment_ << " ";
+        taskOut() << ",";
+      taskOut() << (dayAdjustment_ < 0 ? " " : " +") << dayAdjustment_ << " ";
       if (dayAdjustment_ < -1 || dayAdjustment_ > 1) {
-        std::cout << _("days");
+        taskOut() << _("days");
       } else {
-        std::cout << _("day");
+        taskOut() << _("day");
       }
       comma = true;
     }
     if (adjustment_ != 0) {
       if (comma)
-        std::cout << ",";
-      std::cout << " " << adjustment_ << _("s");
+        taskOut() << ",";
+      taskOut() << " " << adjustment_ << _("s");
     }
   }
   std::tm tm;
   if (str2Tm(timeStr, &tm) != 0) {
     if (Params::instance().verbose_)
-      std::cout << '\n';
-    std::cerr << path << ": " << _("Failed to parse timestamp") << " `" << timeStr << "'\n";
+      taskOut() << '\n';
+    taskErr() << path << ": " << _("Failed to parse timestamp") << " `" << timeStr << "'\n";
     return 1;
   }
 
@@ -1432,8 +1482,8 @@ int Adjust::adjustDateTime(Exiv2::ExifData& exifData, const std::string& key, co
   // Let's not create files with non-4-digit years, we can't read them.
   if (tm.tm_year > 9999 - 1900 || tm.tm_year < 1000 - 1900) {
     if (Params::instance().verbose_)
-      std::cout << '\n';
-    std::cerr << path << ": " << _("Can't adjust timestamp by") << " " << yearAdjustment + monOverflow << " "
+      taskOut() << '\n';
+    taskErr() << path << ": " << _("Can't adjust timestamp by") << " " << yearAdjustment + monOverflow << " "
               << _("years") << "\n";
     return 1;
   }
@@ -1441,7 +1491,7 @@ int Adjust::adjustDateTime(Exiv2::ExifData& exifData, const std::string& key, co
   time = Safe::add(time, Safe::add(adjustment, dayAdjustment * secondsInDay));
   timeStr = time2Str(time);
   if (Params::instance().verbose_) {
-    std::cout << " " << _("to") << " " << timeStr << '\n';
+    taskOut() << " " << _("to") << " " << timeStr << '\n';
   }
   md->setValue(timeStr);
   return 0;
@@ -1450,7 +1500,7 @@ int Adjust::adjustDateTime(Exiv2::ExifData& exifData, const std::string& key, co
 int FixIso::run(const std::string& path) {
   try {
     if (!Exiv2::fileExists(path)) {
-      std::cerr << path << ": " << _("Failed to open the file") << "\n";
+      taskErr() << path << ": " << _("Failed to open the file") << "\n";
       return -1;
     }
     Timestamp ts;
@@ -1461,14 +1511,14 @@ int FixIso::run(const std::string& path) {
     image->readMetadata();
     Exiv2::ExifData& exifData = image->exifData();
     if (exifData.empty()) {
-      std::cerr << path << ": " << _("No Exif data found in the file") << "\n";
+      taskErr() << path << ": " << _("No Exif data found in the file") << "\n";
       return -3;
     }
     auto md = Exiv2::isoSpeed(exifData);
     if (md != exifData.end()) {
       if (md->key() == "Exif.Photo.ISOSpeedRatings") {
         if (Params::instance().verbose_) {
-          std::cout << _("Standard Exif ISO tag exists; not modified") << "\n";
+          taskOut() << _("Standard Exif ISO tag exists; not modified") << "\n";
         }
         return 0;
       }
@@ -1476,7 +1526,7 @@ int FixIso::run(const std::string& path) {
       std::ostringstream os;
       md->write(os, &exifData);
       if (Params::instance().verbose_) {
-        std::cout << _("Setting Exif ISO value to") << " " << os.str() << "\n";
+        taskOut() << _("Setting Exif ISO value to") << " " << os.str() << "\n";
       }
       exifData["Exif.Photo.ISOSpeedRatings"] = os.str();
     }
@@ -1486,7 +1536,7 @@ int FixIso::run(const std::string& path) {
 
     return 0;
   } catch (const Exiv2::Error& e) {
-    std::cerr << "Exiv2 exception in fixiso action for file " << path << ":\n" << e << "\n";
+    taskErr() << "Exiv2 exception in fixiso action for file " << path << ":\n" << e << "\n";
     return 1;
   }
 }  // FixIso::run
@@ -1498,7 +1548,7 @@ Task::UniquePtr FixIso::clone() const {
 int FixCom::run(const std::string& path) {
   try {
     if (!Exiv2::fileExists(path)) {
-      std::cerr << path << ": " << _("Failed to open the file") << "\n";
+      taskErr() << path << ": " << _("Failed to open the file") << "\n";
       return -1;
     }
     Timestamp ts;
@@ -1509,13 +1559,13 @@ int FixCom::run(const std::string& path) {
     image->readMetadata();
     Exiv2::ExifData& exifData = image->exifData();
     if (exifData.empty()) {
-      std::cerr << path << ": " << _("No Exif data found in the file") << "\n";
+      taskErr() << path << ": " << _("No Exif data found in the file") << "\n";
       return -3;
     }
     auto pos = exifData.findKey(Exiv2::ExifKey("Exif.Photo.UserComment"));
     if (pos == exifData.end()) {
       if (Params::instance().verbose_) {
-        std::cout << _("No Exif user comment found") << "\n";
+        taskOut() << _("No Exif user comment found") << "\n";
       }
       return 0;
     }
@@ -1523,20 +1573,20 @@ int FixCom::run(const std::string& path) {
     const auto pcv = dynamic_cast<const Exiv2::CommentValue*>(v.get());
     if (!pcv) {
       if (Params::instance().verbose_) {
-        std::cout << _("Found Exif user comment with unexpected value type") << "\n";
+        taskOut() << _("Found Exif user comment with unexpected value type") << "\n";
       }
       return 0;
     }
     Exiv2::CommentValue::CharsetId csId = pcv->charsetId();
     if (csId != Exiv2::CommentValue::unicode) {
       if (Params::instance().verbose_) {
-        std::cout << _("No Exif UNICODE user comment found") << "\n";
+        taskOut() << _("No Exif UNICODE user comment found") << "\n";
       }
       return 0;
     }
     std::string comment = pcv->comment(Params::instance().charset_.c_str());
     if (Params::instance().verbose_) {
-      std::cout << _("Setting Exif UNICODE user comment to") << " \"" << comment << "\"\n";
+      taskOut() << _("Setting Exif UNICODE user comment to") << " \"" << comment << "\"\n";
     }
     comment = std::string("charset=\"") + Exiv2::CommentValue::CharsetInfo::name(csId) + "\" " + comment;
     // Remove BOM and convert value from source charset to UCS-2, but keep byte order
@@ -1547,7 +1597,7 @@ int FixCom::run(const std::string& path) {
 
     return 0;
   } catch (const Exiv2::Error& e) {
-    std::cerr << "Exiv2 exception in fixcom action for file " << path << ":\n" << e << "\n";
+    taskErr() << "Exiv2 exception in fixcom action for file " << path << ":\n" << e << "\n";
     return 1;
   }
 }  // FixCom::run
@@ -1675,14 +1725,14 @@ std::string temporaryPath() {
 
 int metacopy(const std::string& source, const std::string& tgt, Exiv2::ImageType targetType, bool preserve) {
 #ifdef EXIV2_DEBUG_MESSAGES
-  std::cerr << "actions.cpp::metacopy"
+  taskErr() << "actions.cpp::metacopy"
             << " source = " << source << " target = " << tgt << '\n';
 #endif
 
   // read the source metadata
   int rc = -1;
   if (!Exiv2::fileExists(source)) {
-    std::cerr << source << ": " << _("Failed to open the file") << "\n";
+    taskErr() << source << ": " << _("Failed to open the file") << "\n";
     return rc;
   }
 
@@ -1718,7 +1768,7 @@ int metacopy(const std::string& source, const std::string& tgt, Exiv2::ImageType
   // Copy each type of metadata
   if (Params::instance().target_ & Params::ctExif && !sourceImage->exifData().empty()) {
     if (Params::instance().verbose_ && !bStdout) {
-      std::cout << _("Writing Exif data from") << " " << source << " " << _("to") << " " << target << '\n';
+      taskOut() << _("Writing Exif data from") << " " << source << " " << _("to") << " " << target << '\n';
     }
     if (preserve) {
       for (const auto& exif : sourceImage->exifData()) {
@@ -1730,7 +1780,7 @@ int metacopy(const std::string& source, const std::string& tgt, Exiv2::ImageType
   }
   if (Params::instance().target_ & Params::ctIptc && !sourceImage->iptcData().empty()) {
     if (Params::instance().verbose_ && !bStdout) {
-      std::cout << _("Writing IPTC data from") << " " << source << " " << _("to") << " " << target << '\n';
+      taskOut() << _("Writing IPTC data from") << " " << source << " " << _("to") << " " << target << '\n';
     }
     if (preserve) {
       for (const auto& iptc : sourceImage->iptcData()) {
@@ -1742,13 +1792,13 @@ int metacopy(const std::string& source, const std::string& tgt, Exiv2::ImageType
   }
   if (Params::instance().target_ & (Params::ctXmp | Params::ctXmpRaw) && !sourceImage->xmpData().empty()) {
     if (Params::instance().verbose_ && !bStdout) {
-      std::cout << _("Writing XMP data from") << " " << source << " " << _("to") << " " << target << '\n';
+      taskOut() << _("Writing XMP data from") << " " << source << " " << _("to") << " " << target << '\n';
     }
 
     // #1148 use Raw XMP packet if there are no XMP modification commands
     Params::CommonTarget tRawSidecar = Params::ctXmpSidecar | Params::ctXmpRaw;  // option -eXX
     if (Params::instance().modifyCmds_.empty() && (Params::instance().target_ & tRawSidecar) == tRawSidecar) {
-      // std::cout << "short cut" << '\n';
+      // taskOut() << "short cut" << '\n';
       // http://www.cplusplus.com/doc/tutorial/files/
       std::ofstream os;
       os.open(target.c_str());
@@ -1760,13 +1810,13 @@ int metacopy(const std::string& source, const std::string& tgt, Exiv2::ImageType
         targetImage->xmpData()[xmp.key()] = xmp.value();
       }
     } else {
-      // std::cout << "long cut" << '\n';
+      // taskOut() << "long cut" << '\n';
       targetImage->setXmpData(sourceImage->xmpData());
     }
   }
   if (Params::instance().target_ & Params::ctComment && !sourceImage->comment().empty()) {
     if (Params::instance().verbose_ && !bStdout) {
-      std::cout << _("Writing JPEG comment from") << " " << source << " " << _("to") << " " << tgt << '\n';
+      taskOut() << _("Writing JPEG comment from") << " " << source << " " << _("to") << " " << tgt << '\n';
     }
     targetImage->setComment(sourceImage->comment());
   }
@@ -1775,7 +1825,7 @@ int metacopy(const std::string& source, const std::string& tgt, Exiv2::ImageType
       targetImage->writeMetadata();
       rc = 0;
     } catch (const Exiv2::Error& e) {
-      std::cerr << tgt << ": " << _("Could not write metadata to file") << ": " << e << "\n";
+      taskErr() << tgt << ": " << _("Could not write metadata to file") << ": " << e << "\n";
       rc = 1;
     }
 
@@ -1824,7 +1874,7 @@ int renameFile(std::string& newPath, const tm* tm) {
   const size_t max = 1024;
   char basename[max] = {};
   if (strftime(basename, max, format.c_str(), tm) == 0) {
-    std::cerr << _("Filename format yields empty filename for the file") << " " << path << "\n";
+    taskErr() << _("Filename format yields empty filename for the file") << " " << path << "\n";
     return 1;
   }
 
@@ -1833,7 +1883,7 @@ int renameFile(std::string& newPath, const tm* tm) {
 
   if (p.parent_path() == oldFsPath.parent_path() && p.filename() == oldFsPath.filename()) {
     if (Params::instance().verbose_) {
-      std::cout << _("This file already has the correct name") << '\n';
+      taskOut() << _("This file already has the correct name") << '\n';
     }
     return -1;
   }
@@ -1853,7 +1903,7 @@ int renameFile(std::string& newPath, const tm* tm) {
                         .string();
           break;
         case Params::askPolicy:
-          std::cout << Params::instance().progname() << ": " << _("File") << " `" << newPath << "' "
+          taskOut() << Params::instance().progname() << ": " << _("File") << " `" << newPath << "' "
                     << _("exists. [O]verwrite, [r]ename or [s]kip?") << " ";
           std::cin >> s;
           switch (s.front()) {
@@ -1878,11 +1928,11 @@ int renameFile(std::string& newPath, const tm* tm) {
   }
 
   if (Params::instance().verbose_) {
-    std::cout << _("Renaming file to") << " " << newPath;
+    taskOut() << _("Renaming file to") << " " << newPath;
     if (Params::instance().timestamp_) {
-      std::cout << ", " << _("updating timestamp");
+      taskOut() << ", " << _("updating timestamp");
     }
-    std::cout << '\n';
+    taskOut() << '\n';
   }
 
   fs::rename(path, newPath);
@@ -1904,7 +1954,7 @@ int dontOverwrite(const std::string& path) {
     return 0;
 
   if (!Params::instance().force_ && Exiv2::fileExists(path)) {
-    std::cout << Params::instance().progname() << ": " << _("Overwrite") << " `" << path << "'? ";
+    taskOut() << Params::instance().progname() << ": " << _("Overwrite") << " `" << path << "'? ";
     std::string s;
     std::cin >> s;
     if (s.front() != 'y' && s.front() != 'Y')
@@ -1925,11 +1975,37 @@ std::ostream& operator<<(std::ostream& os, const std::pair<std::string, int>& st
 
 int printStructure(std::ostream& out, Exiv2::PrintStructureOption option, const std::string& path) {
   if (!Exiv2::fileExists(path)) {
-    std::cerr << path << ": " << _("Failed to open the file") << "\n";
+    taskErr() << path << ": " << _("Failed to open the file") << "\n";
     return -1;
   }
   Exiv2::Image::UniquePtr image = Exiv2::ImageFactory::open(path);
   image->printStructure(out, option);
   return 0;
 }
+Exiv2::ReadFilter printFilter() {
+  const auto& params = Params::instance();
+  const std::pair<MetadataId, std::string> families[] = {
+      {MetadataId::exif, "Exif"},
+      {MetadataId::iptc, "Iptc"},
+      {MetadataId::xmp, "Xmp"},
+  };
+  Exiv2::ReadFilter filter;
+  if (params.keys_.empty() && params.greps_.empty())
+    return filter;
+  for (auto&& [id, family] : families) {
+    if ((params.printTags_ & id) != id)
+      continue;
+    // With -v, printMetadata() reports the families which are not in the file
+    if (!params.greps_.empty() || params.verbose_) {
+      filter.addGroup(family);
+      continue;
+    }
+    for (auto&& key : params.keys_) {
+      if (key.starts_with(family + '.'))
+        filter.addKey(key);
+    }
+  }
+  return filter;
+}
+
 }  // namespace
@@ -44,9 +44,41 @@ enum TaskType {
   fixcom,
 };
 
+// *****************************************************************************
+// free functions
+
+//! Stream for the regular output of the tasks run by the calling thread, std::cout by default.
+std::ostream& taskOut();
+//! Stream for the error output of the tasks run by the calling thread, std::cerr by default.
+std::ostream& taskErr();
+/*!
+  @brief Log message handler which sends Exiv2 log messages to taskErr()
+         instead of std::cerr, with the same prefixes as the default handler.
+ */
+void taskLogHandler(int level, const char* s);
+
 // *****************************************************************************
 // class definitions
 
+/*!
+  @brief Redirect the output of the tasks run by the calling thread to the
+         given streams, for the lifetime of the object. Used to collect the
+         output of tasks which run in parallel, see option --jobs.
+ */
+class TaskOutput {
+ public:
+  //! Constructor, redirects the output of the calling thread to \em out and \em err.
+  TaskOutput(std::ostream& out, std::ostream& err);
+  //! Destructor, restores the previous streams.
+  ~TaskOutput();
+  TaskOutput(const TaskOutput&) = delete;
+  TaskOutput& operator=(const TaskOutput&) = delete;
+
+ private:
+  std::ostream* prevOut_;  //!< Output stream before the redirection
+  std::ostream* prevErr_;  //!< Error stream before the redirection
+};
+
 /*!
   @brief Abstract base class for all concrete actions.
 
@@ -245,8 +277,9 @@ class Extract : public Task {
 
   /// @brief Write one preview image to a file. The filename is composed by removing the suffix from the image
   /// filename and appending "-preview<num>" and the appropriate suffix (".jpg" or ".tif"), depending on the
-  /// format of the Exif thumbnail image.
-  void writePreviewFile(const Exiv2::PreviewImage& pvImg, size_t num) const;
+  /// format of the Exif thumbnail image. The preview image is written straight from the image file where possible.
+  void writePreviewFile(const Exiv2::PreviewManager& pvMgr, const Exiv2::PreviewProperties& pvProps,
+                        size_t num) const;
 
   /// @brief Write embedded iccProfile files.
   [[nodiscard]] int writeIccProfile(const std::string& target) const;
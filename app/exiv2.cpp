@@ -15,12 +15,18 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cctype>
+#include <condition_variable>
 #include <cstring>
+#include <exception>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <map>
+#include <mutex>
 #include <regex>
+#include <thread>
 
 #include <filesystem>
 namespace fs = std::filesystem;
@@ -116,6 +122,22 @@ bool parseLine(ModifyCmd& modifyCmd, const std::string& line, int num);
   @param input Input string, assumed to be UTF-8
  */
 std::string parseEscapes(const std::string& input);
+
+/*!
+  @brief Run \em task on all files with Params::jobs_ worker threads (option -j).
+
+  Each worker runs its own clone of the task and takes the next file as
+  soon as it is done with the previous one. The output of each file is
+  collected and written in the order of the files, so that it is the same
+  as that of a sequential run.
+
+  @param task  Prototype of the task to run
+  @param width Width of the file numbers in verbose output
+  @return The exit code of the first file which failed, EXIT_SUCCESS if none did
+  @throw The exception thrown by a task, after the output of all files up
+         to that one is written and the workers have stopped
+ */
+int runJobs(const Action::Task& task, int width);
 }  // namespace
 
 // *****************************************************************************
@@ -171,17 +193,21 @@ int main(int argc, char* const argv[]) {
         }
         return 1;
       }();
-      int n = 1;
-      for (const auto& file : params.files_) {
-        // If extracting to stdout then ignore verbose
-        if (params.verbose_ && !(params.action_ & Action::extract && params.target_ & Params::ctStdInOut)) {
-          std::cout << _("File") << " " << std::setw(w) << std::right << n++ << "/" << filesCount << ": " << file
-                    << '\n';
+      if (params.jobs_ > 1 && filesCount > 1) {
+        returnCode = runJobs(*task, w);
+      } else {
+        int n = 1;
+        for (const auto& file : params.files_) {
+          // If extracting to stdout then ignore verbose
+          if (params.verbose_ && !(params.action_ & Action::extract && params.target_ & Params::ctStdInOut)) {
+            std::cout << _("File") << " " << std::setw(w) << std::right << n++ << "/" << filesCount << ": " << file
+                      << '\n';
+          }
+          task->setBinary(params.binary_);
+          int ret = task->run(file);
+          if (returnCode == EXIT_SUCCESS)
+            returnCode = ret;
         }
-        task->setBinary(params.binary_);
-        int ret = task->run(file);
-        if (returnCode == EXIT_SUCCESS)
-          returnCode = ret;
       }
 
       Action::TaskFactory::instance().cleanup();
@@ -200,7 +226,7 @@ int main(int argc, char* const argv[]) {
 // class Params
 
 Params::Params() :
-    optstring_(":hVvqfbuktTFa:Y:O:D:r:p:P:d:e:i:c:m:M:l:S:g:K:n:Q:"),
+    optstring_(":hVvqfbuktTFa:Y:O:D:r:p:P:d:e:i:c:m:M:l:S:g:K:n:Q:j:"),
     target_(ctExif | ctIptc | ctComment | ctXmp),
     yodAdjust_(emptyYodAdjust_),
     format_("%Y%m%d_%H%M%S") {
@@ -279,6 +305,8 @@ void Params::help(std::ostream& os) const {
      << _("   -k      Preserve file timestamps when updating files (keep)\n")
      << _("   -t      Set the file timestamp from Exif metadata when renaming (overrides -k)\n")
      << _("   -T      Only set the file timestamp from Exif metadata ('rename' action)\n")
+     << _("   -j n    Process n files in parallel (jobs), 0 for one per hardware thread.\n"
+          "           The output of each file is kept together, in the order of the files\n")
      << _("   -f      Do not prompt before overwriting existing files (force)\n")
      << _("   -F      Do not prompt before renaming files (Force)\n")
      << _("   -a time Time adjustment in the format [+|-]HH[:MM[:SS]]. For 'adjust' action\n")
@@ -453,6 +481,9 @@ int Params::option(int opt, const std::string& optArg, int optOpt) {
     case 'S':
       suffix_ = optArg;
       break;
+    case 'j':
+      rc = evalJobs(optArg);
+      break;
     case ':':
       std::cerr << progname() << ": " << _("Option") << " -" << static_cast<char>(optOpt) << " "
                 << _("requires an argument\n");
@@ -525,6 +556,16 @@ int Params::evalKey(const std::string& optArg) {
   return result;
 }  // Params::evalKey
 
+int Params::evalJobs(const std::string& optArg) {
+  int64_t jobs = 0;
+  if (!Util::strtol(optArg.c_str(), jobs) || jobs < 0 || jobs > 1024) {
+    std::cerr << progname() << ": " << _("Error parsing -j option argument") << " `" << optArg << "'\n";
+    return 1;
+  }
+  jobs_ = jobs == 0 ? std::max(1U, std::thread::hardware_concurrency()) : static_cast<unsigned>(jobs);
+  return 0;
+}  // Params::evalJobs
+
 int Params::evalRename(int opt, const std::string& optArg) {
   int rc = 0;
   switch (action_) {
@@ -1021,7 +1062,7 @@ int Params::getopt(int argc, char* const Argv[]) {
       {"--Modify", "-M"},    {"--encode", "-n"},  {"--months", "-O"},  {"--print", "-p"},    {"--Print", "-P"},
       {"--quiet", "-q"},     {"--log", "-Q"},     {"--rename", "-r"},  {"--suffix", "-S"},   {"--timestamp", "-t"},
       {"--Timestamp", "-T"}, {"--unknown", "-u"}, {"--verbose", "-v"}, {"--Version", "-V"},  {"--version", "-V"},
-      {"--years", "-Y"},
+      {"--years", "-Y"},     {"--jobs", "-j"},
   };
 
   for (int i = 0; i < argc; i++) {
@@ -1086,6 +1127,25 @@ int Params::getopt(int argc, char* const Argv[]) {
     std::cerr << progname() << ": " << _("-T option can only be used with rename action\n");
     rc = 1;
   }
+  if (jobs_ > 1 && target_ & ctStdInOut) {
+    std::cerr << progname() << ": " << _("-j option can not be used with input from stdin or output to stdout\n");
+    rc = 1;
+  }
+  if (jobs_ > 1 && action_ == Action::rename) {
+    std::cerr << progname() << ": " << _("-j option can not be used with rename action\n");
+    rc = 1;
+  }
+  if (jobs_ > 1 && action_ == Action::extract && !force_) {
+    std::cerr << progname() << ": " << _("-j option requires -f with extract action\n");
+    rc = 1;
+  }
+  // Defaults for the metadata types and data columns of the print action
+  if (printTags_ == MetadataId::invalid) {
+    printTags_ = MetadataId::exif | MetadataId::iptc | MetadataId::xmp;
+  }
+  if (printItems_ == 0) {
+    printItems_ = prKey | prType | prCount | prTrans;
+  }
 
 cleanup:
   // cleanup the argument vector
@@ -1503,4 +1563,89 @@ std::string parseEscapes(const std::string& input) {
   return result;
 }
 
+
+int runJobs(const Action::Task& task, int width) {
+  //! Output and result of one file
+  struct Job {
+    std::string out_;               //!< Regular output
+    std::string err_;               //!< Error output
+    int ret_{0};                    //!< Return code of the task
+    std::exception_ptr exception_;  //!< Exception thrown by the task, if any
+  };
+
+  const Params& params = Params::instance();
+  const auto& files = params.files_;
+  std::atomic<size_t> next{0};
+  std::map<size_t, Job> done;
+  std::mutex mutex;
+  std::condition_variable jobDone;
+
+  auto work = [&](const Action::Task::UniquePtr& t) {
+    t->setBinary(params.binary_);
+    for (size_t i = next++; i < files.size(); i = next++) {
+      Job job;
+      std::ostringstream out;
+      std::ostringstream err;
+      {
+        Action::TaskOutput output(out, err);
+        if (params.verbose_) {
+          out << _("File") << " " << std::setw(width) << std::right << i + 1 << "/" << files.size() << ": "
+              << files[i] << '\n';
+        }
+        try {
+          job.ret_ = t->run(files[i]);
+        } catch (const std::exception&) {
+          job.exception_ = std::current_exception();
+          next = files.size();  // Don't start any more files
+        }
+      }
+      job.out_ = out.str();
+      job.err_ = err.str();
+      {
+        auto guard = std::scoped_lock(mutex);
+        done.emplace(i, std::move(job));
+      }
+      jobDone.notify_one();
+    }
+  };
+
+  const auto handler = Exiv2::LogMsg::handler();
+  Exiv2::LogMsg::setHandler(Action::taskLogHandler);
+  Exiv2::preloadConfig();
+  const auto workers = std::min<size_t>(params.jobs_, files.size());
+  std::vector<Action::Task::UniquePtr> tasks(workers);
+  std::vector<std::thread> threads;
+  for (auto& t : tasks) {
+    t = task.clone();
+    threads.emplace_back(work, std::cref(t));
+  }
+
+  int returnCode = EXIT_SUCCESS;
+  std::exception_ptr exception;
+  // Files are handed out in order, so all files before a failed one are
+  // started, and will be done, before the workers stop.
+  for (size_t i = 0; i < files.size(); ++i) {
+    std::unique_lock lock(mutex);
+    jobDone.wait(lock, [&] { return done.contains(i); });
+    auto job = std::move(done.extract(i).mapped());
+    lock.unlock();
+
+    std::cout << job.out_ << std::flush;
+    std::cerr << job.err_;
+    if (job.exception_) {
+      exception = job.exception_;
+      break;
+    }
+    if (returnCode == EXIT_SUCCESS)
+      returnCode = job.ret_;
+  }
+  for (auto& t : threads)
+    t.join();
+  Exiv2::LogMsg::setHandler(handler);
+
+  if (exception)
+    std::rethrow_exception(exception);
+  return returnCode;
+}
+
 }  // namespace
@@ -222,6 +222,7 @@ class Params : public Util::Getopt {
   std::vector<std::regex> greps_;       //!< List of keys to 'grep' from the metadata
   Keys keys_;                           //!< List of keys to match from the metadata
   std::string charset_;                 //!< Charset to use for UNICODE Exif user comment
+  unsigned jobs_{1};                    //!< Number of files to process in parallel (-j option arg).
 
   Exiv2::DataBuf stdinBuf;  //!< DataBuf with the binary bytes from stdin
 
@@ -235,6 +236,7 @@ class Params : public Util::Getopt {
   int setLogLevel(const std::string& optarg);
   int evalGrep(const std::string& optarg);
   int evalKey(const std::string& optarg);
+  int evalJobs(const std::string& optarg);
   int evalRename(int opt, const std::string& optarg);
   int evalAdjust(const std::string& optarg);
   int evalYodAdjust(const Yod& yod, const std::string& optarg);
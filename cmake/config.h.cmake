@@ -33,6 +33,12 @@
 // Define if the strerror_r function returns char*.
 #cmakedefine EXV_STRERROR_R_CHAR_P
 
+// Define if you have the copy_file_range function.
+#cmakedefine EXV_HAVE_COPY_FILE_RANGE
+
+// Define if you have the Linux sendfile function.
+#cmakedefine EXV_HAVE_SENDFILE
+
 #if defined(__NetBSD__)
 #include <sys/param.h>
 #if __NetBSD_Prereq__(9,99,17)
@@ -15,6 +15,8 @@
 
 // + standard includes
 #include <memory>
+#include <utility>
+#include <vector>
 
 // *****************************************************************************
 // namespace extensions
@@ -90,6 +92,22 @@ class EXIV2API BasicIo {
         0 if failure;
    */
   virtual size_t write(BasicIo& src) = 0;
+  /*!
+    @brief Write \em wcount bytes, which are read from another BasicIo
+        instance starting at \em offset, to the IO source. Current IO
+        position is advanced by the number of bytes written.
+
+    The default implementation copies the data through a buffer of
+    limited size.
+
+    @param src Reference to another BasicIo instance, which must be open.
+        Its IO position is undefined afterwards.
+    @param offset Offset of the data in \em src
+    @param wcount Number of bytes to be written.
+    @return Number of bytes written to IO source successfully;<BR>
+        0 if failure;
+   */
+  virtual size_t writeRange(BasicIo& src, size_t offset, size_t wcount);
   /*!
     @brief Write one byte to the IO source. Current IO position is
         advanced by one byte.
@@ -270,6 +288,21 @@ class EXIV2API IoCloser {
   BasicIo& bio_;
 };  // class IoCloser
 
+/*!
+  @brief Write \em count bytes, which are read from \em src starting at
+         \em offset, to the file descriptor \em fd at its current
+         position. The file descriptor may also refer to a pipe or a
+         socket. If \em src is a FileIo, the kernel copies the data with
+         sendfile() where available, otherwise they are copied through a
+         buffer of limited size.
+  @param fd File descriptor open for writing.
+  @param src Open IO source, whose IO position is undefined afterwards.
+  @param offset Offset of the data in \em src
+  @param count Number of bytes to write.
+  @return Return the number of bytes written.
+ */
+EXIV2API size_t sendRange(int fd, BasicIo& src, size_t offset, size_t count);
+
 #ifdef EXV_ENABLE_FILESYSTEM
 /*!
   @brief Provides binary file IO by implementing the BasicIo
@@ -345,6 +378,19 @@ class EXIV2API FileIo : public BasicIo {
            0 if failure;
    */
   size_t write(BasicIo& src) override;
+  /*!
+    @brief Write \em wcount bytes, which are read from another BasicIo
+        instance starting at \em offset, to the file. The file position
+        is advanced by the number of bytes written. If \em src is a file
+        too, the kernel copies the data where possible.
+    @param src Reference to another BasicIo instance, which must be open.
+        Its IO position is undefined afterwards.
+    @param offset Offset of the data in \em src
+    @param wcount Number of bytes to be written.
+    @return Number of bytes written to the file successfully;<BR>
+           0 if failure;
+   */
+  size_t writeRange(BasicIo& src, size_t offset, size_t wcount) override;
   /*!
     @brief Write one byte to the file. The file position is
         advanced by one byte.
@@ -469,6 +515,9 @@ class EXIV2API FileIo : public BasicIo {
   //@}
 
  private:
+  // Declared with EXIV2API before the class, so that the friend has the same linkage
+  friend size_t sendRange(int fd, BasicIo& src, size_t offset, size_t count);
+
   // Pimpl idiom
   class Impl;
   std::unique_ptr<Impl> p_;
@@ -815,6 +864,14 @@ class EXIV2API RemoteIo : public BasicIo {
     @note The write access is only supported by http, https, ssh.
    */
   void transfer(BasicIo& src) override;
+  /*!
+    @brief Set the maximum number of bytes to read ahead of a read which
+        misses. The readahead grows while the file is read sequentially and
+        shrinks after a seek, so that the headers at the start of a file are
+        read in a few requests and a jump into the file does not fetch much
+        more than it needs. The default is 64 KB; 0 turns the readahead off.
+   */
+  void setReadahead(size_t maxBytes);
 
   int seek(int64_t offset, Position pos) override;
 
@@ -850,6 +907,10 @@ class EXIV2API RemoteIo : public BasicIo {
   [[nodiscard]] bool eof() const override;
   //! Returns the URL of the file.
   [[nodiscard]] const std::string& path() const noexcept override;
+  //! Returns the number of requests sent to the server.
+  [[nodiscard]] size_t requests() const;
+  //! Returns the number of bytes received from the server.
+  [[nodiscard]] size_t bytesFetched() const;
 
   /*!
     @brief Mark all the bNone blocks to bKnow. This avoids allocating memory
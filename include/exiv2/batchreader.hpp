@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifndef EXIV2_BATCHREADER_HPP
+#define EXIV2_BATCHREADER_HPP
+
+// *****************************************************************************
+#include "exiv2lib_export.h"
+
+// included header files
+#include "image.hpp"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+// *****************************************************************************
+// namespace extensions
+namespace Exiv2 {
+// *****************************************************************************
+// class definitions
+
+/*!
+  @brief Metadata of one file, read by readMetadataBatch(). Only the
+         metadata families requested from readMetadataBatch() are set.
+ */
+struct EXIV2API BatchResult {
+  size_t index_{0};                       //!< Index of the file in the list of paths
+  std::string path_;                      //!< Path of the file
+  ImageType imageType_{ImageType::none};  //!< Type of the image
+  ExifData exifData_;                     //!< Exif data (mdExif)
+  IptcData iptcData_;                     //!< IPTC data (mdIptc)
+  XmpData xmpData_;                       //!< XMP data (mdXmp)
+  std::string comment_;                   //!< Image comment (mdComment)
+  DataBuf iccProfile_;                    //!< ICC profile (mdIccProfile)
+  std::string error_;                     //!< Error message if the file could not be read, else empty
+};
+
+/*!
+  @brief Function called with the result of each file. It may move the
+         metadata out of \em result.
+ */
+using BatchCallback = std::function<void(BatchResult& result)>;
+
+/*!
+  @brief Read the metadata of many files with a pool of worker threads.
+
+  The files are handed out to the workers one at a time, in the order of
+  \em paths. The result of each file is passed to \em callback as soon as
+  the file is read, in the order in which the files complete. The callback
+  is always called on the calling thread, one result at a time, so it needs
+  no synchronization of its own.
+
+  The XMP toolkit and the Exiv2 configuration file are initialized once,
+  before the workers start. Each worker has its own image and I/O objects,
+  nothing else is shared between them. Files which can't be read are
+  reported through BatchResult::error_, they don't stop the batch.
+
+  @param paths    Paths of the files to read.
+  @param workers  Number of worker threads, 0 for one per hardware thread.
+  @param families Metadata families to return, a combination of MetadataId values.
+                  The other Exif, IPTC and XMP metadata is not decoded, as
+                  far as the format allows, see ReadFilter.
+  @param callback Function called with the result of each file.
+  @return The number of files read successfully.
+  @throw Any exception thrown by \em callback, after the workers have stopped.
+ */
+EXIV2API size_t readMetadataBatch(const std::vector<std::string>& paths, unsigned workers, int families,
+                                  const BatchCallback& callback);
+
+}  // namespace Exiv2
+
+#endif  // EXIV2_BATCHREADER_HPP
@@ -49,6 +49,7 @@ class EXIV2API Cr2Image : public Image {
   //! @name Manipulators
   //@{
   void readMetadata() override;
+  void scanExif(ExifScan& scan) override;
   void writeMetadata() override;
   /*!
     @brief Print out the structure of image file.
@@ -84,7 +85,13 @@ class EXIV2API Cr2Parser {
            with data in CR2 format to the provided metadata containers.
            See TiffParser::decode().
   */
-  static ByteOrder decode(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, const byte* pData, size_t size);
+  static ByteOrder decode(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, const byte* pData, size_t size,
+                          const ReadFilter& filter = {});
+  /*!
+    @brief Read the tags requested by \em scan from a buffer \em pData of
+           length \em size with data in CR2 format. See TiffParser::scan().
+  */
+  static ByteOrder scan(ExifScan& scan, const byte* pData, size_t size);
   /*!
     @brief Encode metadata from the provided metadata to CR2 format.
            See TiffParser::encode().
@@ -21,7 +21,11 @@
 #include "tags.hpp"
 
 // + standard includes
+#include <functional>
 #include <list>
+#include <optional>
+#include <unordered_map>
+#include <vector>
 
 // *****************************************************************************
 // namespace extensions
@@ -34,6 +38,10 @@ namespace Exiv2 {
 // class declarations
 class ExifData;
 
+namespace Internal {
+class TiffParserWorker;
+}  // namespace Internal
+
 // *****************************************************************************
 // class definitions
 
@@ -44,6 +52,8 @@ class ExifData;
 class EXIV2API Exifdatum : public Metadatum {
   template <typename T>
   friend Exifdatum& setValue(Exifdatum&, const T&);
+  // ExifData tells its entries which index to invalidate on key changes
+  friend class ExifData;
 
  public:
   //! @name Creators
@@ -201,8 +211,9 @@ class EXIV2API Exifdatum : public Metadatum {
 
  private:
   // DATA
-  ExifKey::UniquePtr key_;  //!< Key
-  Value::UniquePtr value_;  //!< Value
+  ExifKey key_;               //!< Key
+  Value::UniquePtr value_;    //!< Value
+  ExifData* owner_{nullptr};  //!< Container which indexes the Exifdatum by its key, if any
 
 };  // class Exifdatum
 
@@ -378,6 +389,11 @@ using ExifMetadata = std::list<Exifdatum>;
   - write Exif data to JPEG files
   - extract Exif metadata to files, insert from these files
   - extract and delete Exif thumbnail (JPEG and TIFF thumbnails)
+
+  The container keeps a hash index on the IFD id and tag of its entries,
+  so that findKey() and operator[] run in constant time. The index is
+  maintained by all member functions. It is also rebuilt after a range
+  erase, which covers the erase(std::remove_if(...), end()) idiom.
 */
 class EXIV2API ExifData {
  public:
@@ -386,8 +402,24 @@ class EXIV2API ExifData {
   //! ExifMetadata const iterator type
   using const_iterator = ExifMetadata::const_iterator;
 
+  //! @name Creators
+  //@{
+  //! Default constructor
+  ExifData() = default;
+  //! Copy constructor
+  ExifData(const ExifData& rhs);
+  //! Move constructor
+  ExifData(ExifData&& rhs) noexcept;
+  //! Destructor
+  ~ExifData() = default;
+  //@}
+
   //! @name Manipulators
   //@{
+  //! Assignment operator
+  ExifData& operator=(const ExifData& rhs);
+  //! Move assignment operator
+  ExifData& operator=(ExifData&& rhs) noexcept;
   /*!
     @brief Returns a reference to the %Exifdatum that is associated with a
            particular \em key. If %ExifData does not already contain such
@@ -436,6 +468,8 @@ class EXIV2API ExifData {
   void sortByTag();
   //! Begin of the metadata
   iterator begin() {
+    if (makernote_)
+      decodeMakernote();
     return exifMetadata_.begin();
   }
   //! End of the metadata
@@ -445,6 +479,11 @@ class EXIV2API ExifData {
   /*!
     @brief Find the first Exifdatum with the given \em key, return an
            iterator to it.
+
+    @note  Assigning an Exifdatum with a different key to an element
+           through an iterator invalidates the index of this container.
+           The next findKey() rebuilds it, the const findKey() searches
+           linearly until then.
    */
   iterator findKey(const ExifKey& key);
   //@}
@@ -453,6 +492,8 @@ class EXIV2API ExifData {
   //@{
   //! Begin of the metadata
   [[nodiscard]] const_iterator begin() const {
+    if (makernote_)
+      const_cast<ExifData*>(this)->decodeMakernote();
     return exifMetadata_.begin();
   }
   //! End of the metadata
@@ -464,21 +505,118 @@ class EXIV2API ExifData {
            iterator to it.
    */
   [[nodiscard]] const_iterator findKey(const ExifKey& key) const;
-  //! Return true if there is no Exif metadata
+  //! Return true if there is no Exif metadata, a makernote which is not decoded yet counts as metadata
   [[nodiscard]] bool empty() const {
-    return exifMetadata_.empty();
+    return exifMetadata_.empty() && !makernote_;
   }
   //! Get the number of metadata entries
   [[nodiscard]] size_t count() const {
+    if (makernote_)
+      const_cast<ExifData*>(this)->decodeMakernote();
     return exifMetadata_.size();
   }
   //@}
 
  private:
+  // TiffParserWorker defers the makernote
+  friend class Internal::TiffParserWorker;
+  // Exifdatum marks the index stale when its key changes
+  friend class Exifdatum;
+
+  //! Index entry: the first Exifdatum with a key and the number of entries with that key
+  struct IndexEntry {
+    iterator first_;  //!< Position of the first Exifdatum with the key
+    size_t count_;    //!< Number of Exifdatum instances with the key
+  };
+  //! Index type, keyed by IFD id and tag
+  using Index = std::unordered_map<uint64_t, IndexEntry>;
+  //! A makernote which is not decoded yet, see ReadFilter::setDeferMakernote()
+  struct DeferredMakernote {
+    iterator pos_;                          //!< Position of the undecoded makernote tag
+    std::function<ExifMetadata()> decode_;  //!< Decodes the makernote
+  };
+
+  //! @name Manipulators
+  //@{
+  //! Add the Exifdatum at \em pos, which must be the last element, to the index
+  void indexAdd(iterator pos);
+  //! Remove the Exifdatum at \em pos from the index, before it is erased
+  void indexErase(iterator pos);
+  //! Rebuild the index from scratch
+  void rebuildIndex();
+  /*!
+    @brief Decode the deferred makernote and insert its metadata after the
+           makernote tag, where decoding it with the other Exif data puts it.
+   */
+  void decodeMakernote();
+  //@}
+
+  //! @name Accessors
+  //@{
+  /*!
+    @brief Return the index entry for \em key, nullptr if there is none. Sets
+           \em stale if an Exifdatum has got another key by assignment
+           since the index was built; the result is meaningless then.
+   */
+  [[nodiscard]] const IndexEntry* indexFind(const ExifKey& key, bool& stale) const;
+  //@}
+
   // DATA
   ExifMetadata exifMetadata_;
+  Index index_;                                 //!< Hash index on the IFD id and tag of the entries
+  bool indexStale_{false};                      //!< True if an entry got another key since the index was built
+  std::optional<DeferredMakernote> makernote_;  //!< Makernote to decode when it is first needed
 };  // class ExifData
 
+/*!
+  @brief A list of Exif tags to read with a header scan, and the values
+         found by the scan.
+
+  A header scan reads only the requested tags of IFD0, the Exif IFD and the
+  GPS IFD directly from the TIFF structure. It does not create a metadata
+  tree or Exifdatum objects and skips the makernote and the thumbnail,
+  which makes it much faster than Image::readMetadata() if only a few tags
+  are needed, e.g., to index images. See Image::scanExif().
+ */
+class EXIV2API ExifScan {
+ public:
+  //! @name Manipulators
+  //@{
+  /*!
+    @brief Request the tag with \em key, e.g., "Exif.Photo.DateTimeOriginal".
+           Only tags of the groups Image, Photo and GPSInfo can be scanned.
+    @throw Error if the key is invalid or not of one of these groups.
+   */
+  void addKey(const std::string& key);
+  //! Remove the values found by a previous scan, keep the requested tags.
+  void clear();
+  //! Set the values of the requested tags to those in \em exifData.
+  void setValues(const ExifData& exifData);
+  //@}
+
+  //! @name Accessors
+  //@{
+  //! Return the keys of the requested tags.
+  [[nodiscard]] std::vector<std::string> keys() const;
+  //! Return the value of the tag with \em key found by the scan, or nullptr if it was not found.
+  [[nodiscard]] const Value* value(std::string_view key) const;
+  //@}
+
+ private:
+  friend class Internal::TiffParserWorker;
+
+  //! A requested tag and its value
+  struct Entry {
+    std::string key_;         //!< Key of the tag
+    IfdId ifdId_;             //!< IFD of the tag
+    uint16_t tag_;            //!< Tag number
+    Value::UniquePtr value_;  //!< Value found, nullptr if none
+  };
+
+  // DATA
+  std::vector<Entry> entries_;  //!< Requested tags in the order they were added
+};  // class ExifScan
+
 /*!
   @brief Stateless parser class for Exif data. Images use this class to
          decode and encode binary Exif data.
@@ -498,9 +636,27 @@ class EXIV2API ExifParser {
     @param pData 	  Pointer to the data buffer. Must point to data in
                     binary Exif format; no checks are performed.
     @param size 	  Length of the data buffer
+    @param filter   The metadata to decode; the makernote is skipped if
+                    the filter passes none of its groups.
     @return Byte order in which the data is encoded.
   */
-  static ByteOrder decode(ExifData& exifData, const byte* pData, size_t size);
+  static ByteOrder decode(ExifData& exifData, const byte* pData, size_t size, const ReadFilter& filter = {});
+  /*!
+    @brief Decode the binary Exif data which starts at \em offset in
+           \em buf. Large undefined and byte values keep \em buf and
+           refer to it instead of copying their data, so it must not
+           change any more.
+  */
+  static ByteOrder decode(ExifData& exifData, const std::shared_ptr<const DataBuf>& buf, size_t offset,
+                          const ReadFilter& filter = {});
+  /*!
+    @brief Read the tags requested by \em scan from a buffer \em pData of
+           length \em size with binary Exif data, see ExifScan.
+
+    @return Byte order in which the data is encoded, invalidByteOrder if the
+            buffer does not start with a TIFF header.
+  */
+  static ByteOrder scan(ExifScan& scan, const byte* pData, size_t size);
   /*!
     @brief Encode Exif metadata from the provided metadata to binary Exif
            format.
@@ -6,6 +6,7 @@
 // *****************************************************************************
 // included header files
 #include "exiv2/basicio.hpp"
+#include "exiv2/batchreader.hpp"
 #include "exiv2/bmffimage.hpp"
 #include "exiv2/bmpimage.hpp"
 #include "exiv2/config.h"
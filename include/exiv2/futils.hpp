@@ -91,6 +91,22 @@ EXIV2API std::string strError();
 //! @brief Return the path of the current process.
 EXIV2API std::string getProcessPath();
 
+/*!
+  @brief Parse the Exiv2 configuration file (~/.exiv2 or exiv2.ini) into the
+         process-wide cache used by the lens print functions. The cache is
+         reloaded when the modification time of the file changes. The lens
+         print functions check it at most once a second, this function
+         checks it right away and avoids the delay on first use.
+  @return true if a configuration file was found and parsed successfully.
+ */
+EXIV2API bool preloadConfig();
+
+/*!
+  @brief Discard the cached Exiv2 configuration file. The location of the
+         file is determined again and the file is parsed on next use.
+ */
+EXIV2API void invalidateConfig();
+
 /*!
   @brief A container for URL components. It also provides the method to parse a
         URL to get the protocol, host, path, port, querystring, username, password.
@@ -7,6 +7,8 @@
 
 #include "datasets.hpp"
 
+#include <memory>
+
 namespace Exiv2 {
 /*!
  @brief execute an HTTP request
@@ -16,6 +18,47 @@ namespace Exiv2 {
  @return Server response 200 = OK, 404 = Not Found etc...
 */
 EXIV2API int http(Exiv2::Dictionary& request, Exiv2::Dictionary& response, std::string& errors);
+
+/*!
+ @brief A connection to an HTTP server which is kept open between requests
+        (HTTP/1.1 keep-alive), so that a series of requests, e.g., for the
+        blocks of a remote file, costs one connection setup instead of one
+        per request. A request to another server, or after the server has
+        closed the connection, opens a new connection.
+
+        The connection is not thread-safe; use one connection per thread.
+*/
+class EXIV2API HttpConnection {
+ public:
+  //! Constructor, does not connect yet
+  HttpConnection();
+  //! Destructor, closes the connection
+  ~HttpConnection();
+  HttpConnection(const HttpConnection&) = delete;
+  HttpConnection& operator=(const HttpConnection&) = delete;
+
+  /*!
+   @brief Execute an HTTP GET or HEAD request on the connection.
+   @param request  - a Dictionary with the server, port, page, verb and header
+                     of the request, like the request of http()
+   @param response - a Dictionary of response headers and the body (filled by the response)
+   @param errors   - a String with an error
+   @return Server response 200 = OK, 404 = Not Found etc..., -1 if the request failed
+  */
+  int request(Exiv2::Dictionary& request, Exiv2::Dictionary& response, std::string& errors);
+  //! Close the connection, the next request opens a new one
+  void disconnect();
+
+  //! Number of connections opened
+  [[nodiscard]] size_t connects() const;
+  //! Number of requests sent
+  [[nodiscard]] size_t requests() const;
+
+ private:
+  // Pimpl idiom
+  struct Impl;
+  std::unique_ptr<Impl> p_;
+};
 }  // namespace Exiv2
 
 #endif
@@ -36,6 +36,28 @@ struct NativePreview {
 //! List of native previews. This is meant to be used only by the PreviewManager.
 using NativePreviewList = std::vector<NativePreview>;
 
+/*!
+  @brief Space which writeMetadata() reserves in the metadata it writes, so
+         that later edits fit in place without moving the image data.
+ */
+struct WritePolicy {
+  uint32_t xmpPadding_{0};   //!< Padding of XMP packets in bytes, 0 for the default of the XMP toolkit (2048 bytes)
+  uint32_t exifPadding_{0};  //!< Slack after new Exif data in bytes, where the image format allows it (JPEG)
+};
+
+/*!
+  @brief Outcome of the last writeMetadata(), to tell the write strategy
+         chosen and to tune the WritePolicy. JPEG and TIFF-based images are
+         patched in place when the metadata fits, other formats, like PNG
+         and WebP, are always rewritten.
+ */
+struct WriteResult {
+  bool inPlace_{false};     //!< The metadata was patched in place, false if the file was rewritten
+  size_t xmpPadding_{0};    //!< Padding left in the XMP packet
+  size_t exifPadding_{0};   //!< Slack left after the Exif data written, if it was re-encoded
+  int64_t reserveUsed_{0};  //!< Padding and slack used by an in-place patch, negative if it released some
+};
+
 /*!
   @brief Options for printStructure
  */
@@ -92,6 +114,21 @@ class EXIV2API Image {
         type).
    */
   virtual void readMetadata() = 0;
+  /*!
+    @brief Read only the Exif tags requested by \em scan, see ExifScan.
+        JPEG, TIFF, CR2, ORF and RW2 images read the tags directly from
+        the Exif data and leave the metadata of the image unchanged.
+
+    The default implementation reads the metadata with a ReadFilter which
+    passes the requested tags, takes their values from the Exif data and
+    then restores the metadata, the ReadFilter and the other properties
+    which readMetadata() sets, also if reading fails.
+
+    @throw Error if opening or reading of the file fails or the image
+        data is not valid (does not look like data of the specific image
+        type).
+   */
+  virtual void scanExif(ExifScan& scan);
   /*!
     @brief Write metadata back to the image.
 
@@ -102,7 +139,8 @@ class EXIV2API Image {
     any exists section for that metadata type will be removed from the
     image.
 
-    @throw Error if the operation fails
+    @throw Error if the operation fails, or if the metadata was read with
+        a ReadFilter which skips some of it, see partialMetadata().
    */
   virtual void writeMetadata() = 0;
   /*!
@@ -302,6 +340,23 @@ class EXIV2API Image {
     little-endian byte order (II) is used by default.
    */
   void setByteOrder(ByteOrder byteOrder);
+  /*!
+    @brief Set the space which writeMetadata() reserves for later edits.
+
+    The padding of XMP packets is used by the image formats which embed
+    an XMP packet. Slack after the Exif data is only reserved in JPEG
+    images, when the Exif data needs to be re-encoded. By default no
+    slack is reserved and XMP packets get the default padding of the XMP
+    toolkit.
+   */
+  void setWritePolicy(const WritePolicy& writePolicy);
+  /*!
+    @brief Set the metadata which readMetadata() needs to decode, so that
+           it can skip the rest, e.g., the makernote if only standard Exif
+           tags are used. See ReadFilter for the details. Metadata read
+           with a filter which skips some can't be written back.
+   */
+  void setReadFilter(ReadFilter readFilter);
 
   /*!
     @brief Print out the structure of image file.
@@ -450,6 +505,18 @@ class EXIV2API Image {
   [[deprecated]] [[nodiscard]] bool supportsMetadata(MetadataId metadataId) const;
   //! Return the flag indicating the source when writing XMP metadata.
   [[nodiscard]] bool writeXmpFromPacket() const;
+  //! Return the space which writeMetadata() reserves for later edits.
+  [[nodiscard]] const WritePolicy& writePolicy() const;
+  //! Return the outcome of the last writeMetadata().
+  [[nodiscard]] const WriteResult& writeResult() const;
+  //! Return the metadata which readMetadata() needs to decode.
+  [[nodiscard]] const ReadFilter& readFilter() const;
+  /*!
+    @brief Return true if the metadata was read with a ReadFilter which
+           skips some of it. writeMetadata() refuses to write it, since
+           that would drop the metadata which was skipped.
+   */
+  [[nodiscard]] bool partialMetadata() const;
   //! Return list of native previews. This is meant to be used only by the PreviewManager.
   [[nodiscard]] const NativePreviewList& nativePreviews() const;
   //@}
@@ -485,10 +552,25 @@ class EXIV2API Image {
   uint32_t pixelWidth_{0};            //!< image pixel width
   uint32_t pixelHeight_{0};           //!< image pixel height
   NativePreviewList nativePreviews_;  //!< list of native previews
+  WriteResult writeResult_;           //!< Outcome of the last writeMetadata()
 
   //! Return tag name for given tag id.
   const std::string& tagName(uint16_t tag);
 
+  /*!
+    @brief Record whether the ReadFilter skips some of the metadata which
+           readMetadata() reads now. Called by readMetadata() of the image
+           formats which apply the filter.
+   */
+  void recordReadFilter();
+  /*!
+    @brief Check that the metadata is complete before writeMetadata()
+           writes it.
+    @throw Error if the metadata was read with a ReadFilter which skips
+           some of it.
+   */
+  void enforceCompleteMetadata() const;
+
   //! Return tag type for given tag id.
   static const char* typeName(uint16_t tag);
 
@@ -502,6 +584,9 @@ class EXIV2API Image {
   bool writeXmpFromPacket_{true};  //!< Determines the source when writing XMP
 #endif
   ByteOrder byteOrder_{invalidByteOrder};  //!< Byte order
+  WritePolicy writePolicy_;                //!< Space reserved for later edits
+  ReadFilter readFilter_;                  //!< Metadata to decode
+  bool partialMetadata_{false};            //!< The metadata was read with a ReadFilter which skips some
 
   std::map<int, std::string> tags_;  //!< Map of tags
   bool init_{true};                  //!< Flag marking if map of tags needs to be initialized
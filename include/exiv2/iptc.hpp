@@ -281,11 +281,13 @@ class EXIV2API IptcParser {
     @param iptcData Metadata container to add the decoded IPTC datasets to.
     @param pData    Pointer to the data buffer to read from.
     @param size     Number of bytes in the data buffer.
+    @param filter   The metadata to decode; the records it does not pass
+                    are skipped, and the whole buffer if it passes no IPTC.
 
     @return 0 if successful;<BR>
             5 if the binary IPTC data is invalid or corrupt
    */
-  static int decode(IptcData& iptcData, const byte* pData, size_t size);
+  static int decode(IptcData& iptcData, const byte* pData, size_t size, const ReadFilter& filter = {});
 
   /*!
     @brief Encode the IPTC datasets from \em iptcData to a binary representation in IPTC IIM4 format.
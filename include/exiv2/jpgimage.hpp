@@ -23,6 +23,7 @@ class EXIV2API JpegBase : public Image {
   //! @name Manipulators
   //@{
   void readMetadata() override;
+  void scanExif(ExifScan& scan) override;
   void writeMetadata() override;
   void printStructure(std::ostream& out, PrintStructureOption option, size_t depth) override;
   //@}
@@ -102,12 +103,27 @@ class EXIV2API JpegBase : public Image {
   int initImage(const byte initData[], size_t dataSize);
   /*!
     @brief Provides the main implementation of writeMetadata() by
-          writing all buffered metadata to the provided BasicIo.
+          writing the image header and the segments with all buffered
+          metadata to the provided BasicIo. It stops after the marker of the
+          first segment which is copied unchanged, together with the rest of
+          the image, and leaves the associated BasicIo positioned there.
     @throw Error on input-output errors or when the image data is not valid.
     @param outIo BasicIo instance to write to (a temporary location).
 
    */
-  void doWriteMetadata(BasicIo& outIo);
+  void writeSegments(BasicIo& outIo);
+  /*!
+    @brief Write the new \em segments from writeSegments() over the old ones
+          in the file, if they fill the same space, after resizing the
+          padding of the XMP packet or the slack after the Exif data if
+          needed. Only the bytes which changed are written.
+    @param segments The new segments, starting with the image header
+    @param start    Offset of the first segment after the image header
+    @return true if the file was updated in place, false if it has to be
+          rewritten.
+    @throw Error if writing to the file fails.
+   */
+  bool patchInPlace(DataBuf& segments, size_t start);
   //@}
 
   //! @name Accessors
@@ -9,6 +9,10 @@
 // included header files
 #include "value.hpp"
 
+// + standard includes
+#include <set>
+#include <string_view>
+
 // *****************************************************************************
 // namespace extensions
 namespace Exiv2 {
@@ -275,6 +279,67 @@ inline std::ostream& operator<<(std::ostream& os, const Metadatum& md) {
   return md.write(os);
 }
 
+/*!
+  @brief Keys and groups of the metadata which Image::readMetadata() needs to
+         decode. An empty filter passes all metadata.
+
+  The parsers skip what the filter does not pass at the granularity they can:
+  the makernote, with its binary arrays, as a whole, IPTC records and XMP
+  schemas. The standard Exif IFDs are always decoded, since the print
+  functions of makernote tags refer to them, and XMP sidecars are decoded
+  completely, since their Exif and IPTC data is converted from the XMP
+  data. Metadata which the filter does not pass may still be decoded, so
+  clients need to filter the metadata they use, too.
+
+  @note Metadata read with a filter is incomplete. Image::writeMetadata()
+        refuses to write it back, since that would drop the metadata which
+        was skipped. Read it again with an empty filter to modify it.
+ */
+class EXIV2API ReadFilter {
+ public:
+  //! @name Manipulators
+  //@{
+  //! Pass the metadatum with \em key, e.g., "Exif.Photo.DateTimeOriginal".
+  void addKey(const std::string& key);
+  //! Pass all metadata of a family or group, e.g., "Iptc", "Exif.Nikon3" or "Xmp.dc".
+  void addGroup(const std::string& group);
+  /*!
+    @brief Defer the makernote: keep a copy of the Exif data up to the
+           end of the makernote's data when reading and decode it only
+           when the ExifData first needs it, i.e., when it is iterated or
+           counted, or a makernote key is looked up. The decoded ExifData
+           is the same as without deferring it.
+
+    The first such access modifies the ExifData, also through a const
+    reference, so it must not be made concurrently by several threads.
+   */
+  void setDeferMakernote(bool defer);
+  //@}
+
+  //! @name Accessors
+  //@{
+  //! Return true if the filter passes all metadata.
+  [[nodiscard]] bool empty() const;
+  //! Return true if the makernote is decoded when it is first needed.
+  [[nodiscard]] bool deferMakernote() const {
+    return deferMakernote_;
+  }
+  //! Return true if the filter passes the metadatum with \em key.
+  [[nodiscard]] bool passes(std::string_view key) const;
+  /*!
+    @brief Return true if the filter passes any metadatum of \em group, a
+           family, e.g., "Iptc", or a family and group, e.g., "Exif.Nikon3".
+   */
+  [[nodiscard]] bool passesGroup(std::string_view group) const;
+  //@}
+
+ private:
+  // DATA
+  std::set<std::string, std::less<>> keys_;    //!< Keys passed
+  std::set<std::string, std::less<>> groups_;  //!< Families and groups passed
+  bool deferMakernote_{false};                 //!< Decode the makernote when first needed
+};
+
 /*!
   @brief Compare two metadata by tag. Return true if the tag of metadatum
          lhs is less than that of rhs.
@@ -45,6 +45,7 @@ class EXIV2API OrfImage : public TiffImage {
   //@{
   void printStructure(std::ostream& out, PrintStructureOption option, size_t depth) override;
   void readMetadata() override;
+  void scanExif(ExifScan& scan) override;
   void writeMetadata() override;
   /*!
     @brief Not supported. ORF format does not contain a comment.
@@ -73,7 +74,13 @@ class EXIV2API OrfParser {
            with data in ORF format to the provided metadata containers.
            See TiffParser::decode().
   */
-  static ByteOrder decode(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, const byte* pData, size_t size);
+  static ByteOrder decode(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, const byte* pData, size_t size,
+                          const ReadFilter& filter = {});
+  /*!
+    @brief Read the tags requested by \em scan from a buffer \em pData of
+           length \em size with data in ORF format. See TiffParser::scan().
+  */
+  static ByteOrder scan(ExifScan& scan, const byte* pData, size_t size);
   /*!
     @brief Encode metadata from the provided metadata to ORF format.
            See TiffParser::encode().
@@ -70,6 +70,11 @@ class EXIV2API PreviewImage {
     @brief Return the size of the preview image in bytes.
    */
   [[nodiscard]] uint32_t size() const;
+  /*!
+    @brief Return true if the preview image refers to the data in the
+           source image instead of holding a copy of them.
+   */
+  [[nodiscard]] bool isView() const;
 #ifdef EXV_ENABLE_FILESYSTEM
   /*!
     @brief Write the thumbnail image to a file.
@@ -110,9 +115,13 @@ class EXIV2API PreviewImage {
  private:
   //! Private constructor
   PreviewImage(PreviewProperties properties, DataBuf&& data);
+  //! Private constructor for a preview image which refers to \em size bytes at \em view
+  PreviewImage(PreviewProperties properties, std::shared_ptr<const byte> view, size_t size);
 
-  PreviewProperties properties_;  //!< Preview image properties
-  DataBuf preview_;               //!< Preview image data
+  PreviewProperties properties_;      //!< Preview image properties
+  DataBuf preview_;                   //!< Preview image data, if the preview image holds a copy
+  std::shared_ptr<const byte> view_;  //!< Preview image data in the mapped source image, if it is a view
+  size_t viewSize_{};                 //!< Size of the preview image data in the mapped source image
 
 };  // class PreviewImage
 
@@ -139,6 +148,41 @@ class EXIV2API PreviewManager {
     @brief Return the preview image for the given preview properties.
    */
   [[nodiscard]] PreviewImage getPreviewImage(const PreviewProperties& properties) const;
+  /*!
+    @brief Return the preview image for the given preview properties
+           without copying its data, if possible.
+
+    If the preview image is stored unchanged as one block of a file, the
+    returned preview image refers to that block in a memory mapping of the
+    file of its own, which it keeps for as long as it (or a copy of it)
+    exists. The file must not be modified in the meantime. Otherwise,
+    e.g., for TIFF previews, which are assembled from the metadata, or
+    images which are not read from a file, the preview image holds a copy
+    of the data, like the one returned by getPreviewImage().
+   */
+  [[nodiscard]] PreviewImage getPreviewImageView(const PreviewProperties& properties) const;
+  /*!
+    @brief Write the preview image for the given preview properties to
+           \em io, at its current position.
+
+    The data of the preview image are not read into a buffer where
+    possible. A preview image stored unchanged in the file of the image
+    is copied by the kernel if \em io is a FileIo (see
+    BasicIo::writeRange()). The image data of TIFF previews are copied
+    from the image strip by strip.
+
+    @return The number of bytes written.
+   */
+  [[nodiscard]] size_t writePreviewImage(const PreviewProperties& properties, BasicIo& io) const;
+  /*!
+    @brief Write the preview image for the given preview properties to
+           the file descriptor \em fd, which may also refer to a pipe or
+           a socket, like writePreviewImage(const PreviewProperties&, BasicIo&) const
+           (see sendRange()).
+
+    @return The number of bytes written.
+   */
+  [[nodiscard]] size_t writePreviewImage(const PreviewProperties& properties, int fd) const;
   //@}
 
  private:
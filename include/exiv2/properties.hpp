@@ -63,7 +63,6 @@ struct EXIV2API XmpNsInfo {
 //! XMP property reference, implemented as a static class.
 class EXIV2API XmpProperties {
  private:
-  static const XmpNsInfo* nsInfoUnsafe(const std::string& prefix);
   static void unregisterNsUnsafe(const std::string& ns);
   static const XmpNsInfo* lookupNsRegistryUnsafe(const XmpNsInfo::Prefix& prefix);
 
@@ -129,7 +128,10 @@ class EXIV2API XmpProperties {
     @brief Return information about a schema namespace for \em prefix.
            Always returns a valid pointer.
     @param prefix The prefix
-    @return A pointer to the related information
+    @return A pointer to the related information. For a custom namespace
+            it is valid until the namespace is unregistered; if another
+            thread may unregister it, only until the next lookup of XMP
+            properties in the calling thread.
     @throw Error if no namespace is registered with \em prefix.
    */
   static const XmpNsInfo* nsInfo(const std::string& prefix);
@@ -168,10 +170,9 @@ class EXIV2API XmpProperties {
   /*!
     @brief Lock to be used while modifying properties.
 
-    @todo For a proper read-write lock, this shall be improved by a
-    \em std::shared_timed_mutex (once C++14 is allowed) or
-    \em std::shared_mutex (once C++17 is allowed). The
-    read-access locks shall be updated to \em std::shared_lock then.
+    Only writers of the namespace registry take the lock. Lookups read an
+    immutable snapshot of the registry, which is replaced on each change,
+    and do not block each other.
    */
   static std::mutex mutex_;
 
@@ -188,11 +189,13 @@ class EXIV2API XmpProperties {
   using NsRegistry = std::map<std::string, XmpNsInfo>;
   /*!
     @brief Get the registered namespace for a specific \em prefix from the registry.
+    @return A pointer to the custom namespace or nullptr, valid as long as a
+            pointer returned by nsInfo().
    */
   static const XmpNsInfo* lookupNsRegistry(const XmpNsInfo::Prefix& prefix);
 
   // DATA
-  static NsRegistry nsRegistry_;  //!< Namespace registry
+  static NsRegistry nsRegistry_;  //!< Namespace registry, access requires mutex_
 
   /*!
     @brief Get all registered namespaces (for both Exiv2 and XMPsdk)
@@ -268,6 +271,9 @@ class EXIV2API XmpKey : public Key {
   //! Internal virtual copy constructor.
   [[nodiscard]] XmpKey* clone_() const override;
 
+  //! XmpProperties uses the property path parsed by the key.
+  friend class XmpProperties;
+
   // Pimpl idiom
   struct Impl;
   std::unique_ptr<Impl> p_;
@@ -43,6 +43,7 @@ class EXIV2API Rw2Image : public Image {
   //@{
   void printStructure(std::ostream& out, PrintStructureOption option, size_t depth) override;
   void readMetadata() override;
+  void scanExif(ExifScan& scan) override;
   /*!
     @brief Todo: Write metadata back to the image. This method is not
         yet implemented. Calling it will throw an Error(ErrorCode::kerWritingImageFormatUnsupported).
@@ -85,7 +86,15 @@ class EXIV2API Rw2Parser {
            with data in RW2 format to the provided metadata containers.
            See TiffParser::decode().
   */
-  static ByteOrder decode(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, const byte* pData, size_t size);
+  static ByteOrder decode(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, const byte* pData, size_t size,
+                          const ReadFilter& filter = {});
+  /*!
+    @brief Read the tags requested by \em scan from a buffer \em pData of
+           length \em size with data in RW2 format. See TiffParser::scan().
+           The tags of IFD0 are read from the raw IFD, i.e., they are those
+           which Image::readMetadata() decodes as Exif.PanasonicRaw tags.
+  */
+  static ByteOrder scan(ExifScan& scan, const byte* pData, size_t size);
 
 };  // class Rw2Parser
 
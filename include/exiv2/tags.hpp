@@ -9,6 +9,8 @@
 // included header files
 #include "metadatum.hpp"
 
+#include <string_view>
+
 // *****************************************************************************
 // namespace extensions
 namespace Exiv2 {
@@ -267,6 +269,10 @@ class EXIV2API ExifTags {
 
 /*!
   @brief Concrete keys for Exif metadata and access to Exif tag reference data.
+
+  An %ExifKey only refers to the static group and tag tables of the library,
+  so creating, copying and comparing keys does not allocate memory. The key
+  string is built each time key() is called.
  */
 class EXIV2API ExifKey : public Key {
  public:
@@ -340,10 +346,21 @@ class EXIV2API ExifKey : public Key {
  private:
   //! Internal virtual copy constructor.
   [[nodiscard]] ExifKey* clone_() const override;
+  /*!
+    @brief Parse and convert the key string into tag and IFD Id.
+           Updates data members if the string can be decomposed,
+           or throws \em Error .
+
+    @throw Error if the key cannot be decomposed.
+   */
+  void decomposeKey(const std::string& key);
 
-  // Pimpl idiom
-  struct Impl;
-  std::unique_ptr<Impl> p_;
+  // DATA
+  const TagInfo* tagInfo_{};         //!< Tag info
+  uint16_t tag_{0};                  //!< Tag value
+  IfdId ifdId_{IfdId::ifdIdNotSet};  //!< The IFD associated with this tag
+  mutable int idx_{0};               //!< Unique id of the Exif key in the image
+  std::string_view groupName_;       //!< The group name, refers to the static group table
 
 };  // class ExifKey
 
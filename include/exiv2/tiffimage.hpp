@@ -44,6 +44,7 @@ class EXIV2API TiffImage : public Image {
   //! @name Manipulators
   //@{
   void readMetadata() override;
+  void scanExif(ExifScan& scan) override;
   void writeMetadata() override;
 
   /*!
@@ -100,10 +101,35 @@ class EXIV2API TiffParser {
     @param pData    Pointer to the data buffer. Must point to data in TIFF
                     format; no checks are performed.
     @param size     Length of the data buffer.
+    @param filter   The metadata to decode; the makernote is skipped if
+                    the filter passes none of its groups.
 
     @return Byte order in which the data is encoded.
   */
-  static ByteOrder decode(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, const byte* pData, size_t size);
+  static ByteOrder decode(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, const byte* pData, size_t size,
+                          const ReadFilter& filter = {});
+  /*!
+    @brief Decode metadata from the data in TIFF format which starts at
+           \em offset in \em buf. Large undefined and byte values keep
+           \em buf and refer to it instead of copying their data, so it
+           must not change any more.
+  */
+  static ByteOrder decode(ExifData& exifData, IptcData& iptcData, XmpData& xmpData,
+                          const std::shared_ptr<const DataBuf>& buf, size_t offset, const ReadFilter& filter = {});
+  /*!
+    @brief Read the tags requested by \em scan from a buffer \em pData of
+           length \em size with data in TIFF format, see ExifScan. This
+           reads only IFD0, the Exif IFD and the GPS IFD, and is much faster
+           than decode().
+
+    @param scan     The tags to read and the values found.
+    @param pData    Pointer to the data buffer. Must point to data in TIFF
+                    format; no checks are performed.
+    @param size     Length of the data buffer.
+
+    @return Byte order in which the data is encoded.
+  */
+  static ByteOrder scan(ExifScan& scan, const byte* pData, size_t size);
   /*!
     @brief Encode metadata from the provided metadata to TIFF format.
 
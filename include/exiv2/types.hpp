@@ -10,8 +10,11 @@
 
 // standard includes
 #include <algorithm>
+#include <charconv>
 #include <cstdint>
 #include <sstream>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 // *****************************************************************************
@@ -302,6 +305,19 @@ EXIV2API size_t f2Data(byte* buf, float f, ByteOrder byteOrder);
          to data, write the data to the buffer, return number of bytes written.
  */
 EXIV2API size_t d2Data(byte* buf, double d, ByteOrder byteOrder);
+/*!
+  @brief Copy \em count numbers of \em size bytes each (1, 2, 4 or 8) from
+         \em src to \em dst, converting them between byte order
+         \em byteOrder and the byte order of the host.
+
+  This is the array version of the getUShort() and us2Data() family of
+  functions. It copies the data with memcpy if the byte orders are the
+  same and otherwise swaps the bytes with SIMD instructions where
+  available.
+
+  @throw Error if \em size is not 1, 2, 4 or 8.
+ */
+EXIV2API void copyValues(void* dst, const void* src, size_t count, size_t size, ByteOrder byteOrder);
 
 /*!
   @brief Print len bytes from buf in hex and ASCII format to the given
@@ -467,6 +483,123 @@ std::string toString(const T& arg) {
   return toStringHelper(arg, std::is_integral<T>());
 }
 
+/*!
+  @brief Append the number \em value to \em str, formatted like
+         <TT>os << std::setprecision(precision) << value</TT> on a stream
+         in the "C" locale, but without constructing a stream.
+
+  Integers are written in decimal, rationals as "nominator/denominator" and
+  floating point values like printf("%.*g").
+ */
+template <typename T>
+void appendNumber(std::string& str, const T& value, int precision = 6) {
+  if constexpr (std::is_same_v<T, Rational> || std::is_same_v<T, URational>) {
+    appendNumber(str, value.first);
+    str += '/';
+    appendNumber(str, value.second);
+  } else {
+    char buf[64];
+    std::to_chars_result res{buf, {}};
+    if constexpr (std::is_integral_v<T>) {
+      res = std::to_chars(buf, buf + sizeof(buf), value);
+    } else {
+#ifdef __cpp_lib_to_chars
+      res = std::to_chars(buf, buf + sizeof(buf), value, std::chars_format::general, precision);
+#else
+      std::ostringstream os;
+      os.precision(precision);
+      os << value;
+      str += os.str();
+      return;
+#endif
+    }
+    str.append(buf, res.ptr);
+  }
+}
+
+/*!
+  @brief Return the floating point number \em value formatted like
+         <TT>os << std::fixed << std::setprecision(precision) << value</TT>
+         on a stream in the "C" locale, without constructing a stream.
+ */
+EXIV2API std::string toFixedString(double value, int precision);
+
+/*!
+  @brief Parse the number at \em first like <TT>is >> value</TT> on a stream
+         in the "C" locale, after whitespace. On success, set \em first to
+         the character after the number and return true.
+
+  Some of the input accepted by a stream is left to it: a rational written as
+  "F" and a floating point number, an unsigned number with a minus sign, and
+  numbers that don't fit into \em value. For these, and for input which is
+  not a number, return false.
+ */
+template <typename T>
+bool parseNumber(const char*& first, const char* last, T& value) {
+  auto isSpace = [](char c) { return c == ' ' || (c >= '\t' && c <= '\r'); };
+  auto isDigit = [](char c) { return c >= '0' && c <= '9'; };
+  const char* p = first;
+  while (p != last && isSpace(*p))
+    ++p;
+  if constexpr (std::is_same_v<T, Rational> || std::is_same_v<T, URational>) {
+    // The nominator and denominator of both types are read as signed integers
+    int32_t nominator = 0;
+    int32_t denominator = 0;
+    if (!parseNumber(p, last, nominator))
+      return false;
+    while (p != last && isSpace(*p))
+      ++p;
+    if (p == last || *p != '/')
+      return false;
+    if (!parseNumber(++p, last, denominator))
+      return false;
+    value = {static_cast<typename T::first_type>(nominator), static_cast<typename T::second_type>(denominator)};
+  } else {
+    // Unlike a stream, from_chars doesn't accept a plus sign, but it does accept inf and nan
+    if (p != last && *p == '+' && last - p > 1 && p[1] != '-')
+      ++p;
+    const char* digits = p != last && *p == '-' ? p + 1 : p;
+    if (digits == last || !(isDigit(*digits) || (std::is_floating_point_v<T> && *digits == '.')))
+      return false;
+    if constexpr (std::is_unsigned_v<T>) {
+      if (digits != p)
+        return false;
+    }
+#ifndef __cpp_lib_to_chars
+    if constexpr (std::is_floating_point_v<T>)
+      return false;
+#endif
+    auto [ptr, ec] = std::from_chars(p, last, value);
+    if (ec != std::errc())
+      return false;
+    p = ptr;
+  }
+  first = p;
+  return true;
+}
+
+/*!
+  @brief Parse the whitespace separated numbers in \em str like a sequence of
+         <TT>is >> value</TT> on a stream in the "C" locale until the end of
+         the string, and append them to \em values. Return false if the
+         string contains anything parseNumber() does not handle.
+ */
+template <typename T>
+bool parseNumbers(std::string_view str, std::vector<T>& values) {
+  const char* first = str.data();
+  const char* last = first + str.size();
+  while (true) {
+    while (first != last && (*first == ' ' || (*first >= '\t' && *first <= '\r')))
+      ++first;
+    if (first == last)
+      return true;
+    T value;
+    if (!parseNumber(first, last, value))
+      return false;
+    values.push_back(value);
+  }
+}
+
 /*!
   @brief Utility function to convert a string to a value of type \c T.
 
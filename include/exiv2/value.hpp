@@ -15,6 +15,8 @@
 #include <iomanip>
 #include <map>
 #include <memory>
+#include <type_traits>
+#include <typeinfo>
 
 // *****************************************************************************
 // namespace extensions
@@ -117,7 +119,8 @@ class EXIV2API Value {
   virtual std::ostream& write(std::ostream& os) const = 0;
   /*!
     @brief Return the value as a string. Implemented in terms of
-           write(std::ostream& os) const of the concrete class.
+           write(std::ostream& os) const of the concrete class, or of a
+           faster conversion without a stream where the class has one.
    */
   std::string toString() const;
   /*!
@@ -228,6 +231,13 @@ class EXIV2API Value {
            by subclasses but not directly.
    */
   Value& operator=(const Value&) = default;
+  /*!
+    @brief Internal virtual conversion to a string. The default writes the
+           value to a stream with write(std::ostream& os) const. Library
+           classes with a faster conversion fall back to it for subclasses,
+           so that toString() stays consistent with an overridden write().
+   */
+  virtual std::string toString_() const;
   // DATA
   mutable bool ok_{true};  //!< Indicates the status of the previous to<Type> conversion
 
@@ -258,6 +268,16 @@ class EXIV2API DataValue : public Value {
   int read(const byte* buf, size_t len, ByteOrder byteOrder = invalidByteOrder) override;
   //! Set the data from a string of integer values (e.g., "0 1 2 3")
   int read(const std::string& buf) override;
+  /*!
+    @brief Refer to the \em len bytes at \em buf instead of copying them.
+
+    \em buf must share the ownership of the memory which holds the bytes,
+    like a pointer made with the aliasing constructor of std::shared_ptr.
+    The value and its copies keep that memory alive, and the bytes must not
+    change while they do. The value never modifies the bytes; read()
+    replaces them with a copy.
+   */
+  void borrow(std::shared_ptr<const byte> buf, size_t len);
   //@}
 
   //! @name Accessors
@@ -297,11 +317,17 @@ class EXIV2API DataValue : public Value {
  private:
   //! Internal virtual copy constructor.
   DataValue* clone_() const override;
+  //! Convert the value to a string without a stream, unless a subclass may override write()
+  std::string toString_() const override;
+  //! Own the bytes in \em buf
+  void setValue(DataBuf&& buf);
+  //! Return the <EM>n</EM>-th byte, throw std::out_of_range if there is none
+  [[nodiscard]] byte at(size_t n) const;
 
-  //! Type used to store the data.
-  using ValueType = std::vector<byte>;
   // DATA
-  ValueType value_;  //!< Stores the data value
+  //! The data value, immutable and shared with copies of the value, or borrowed (see borrow())
+  std::shared_ptr<const byte> value_;
+  size_t size_{0};  //!< Number of bytes of the data value
 
 };  // class DataValue
 
@@ -1271,6 +1297,8 @@ class ValueType : public Value {
 
   //! Internal virtual copy constructor.
   ValueType<T>* clone_() const override;
+  //! Convert the value to a string like write(), without a stream unless a subclass may override write()
+  std::string toString_() const override;
 
   // DATA
   //! Pointer to the buffer, nullptr if none has been allocated
@@ -1432,6 +1460,21 @@ inline size_t toData(byte* buf, double t, ByteOrder byteOrder) {
   return d2Data(buf, t, byteOrder);
 }
 
+/*!
+  @brief Convert \em count values of type T between the data buffer and the
+         byte order of the host (see copyValues()).
+ */
+template <typename T>
+void copyArray(void* dst, const void* src, size_t count, ByteOrder byteOrder) {
+  if constexpr (std::is_arithmetic_v<T>) {
+    copyValues(dst, src, count, sizeof(T), byteOrder);
+  } else {
+    // Rationals are two 4 byte numbers
+    static_assert(sizeof(T) == 2 * sizeof(typename T::first_type));
+    copyValues(dst, src, 2 * count, sizeof(typename T::first_type), byteOrder);
+  }
+}
+
 template <typename T>
 ValueType<T>::ValueType() : Value(getType<T>()) {
 }
@@ -1488,6 +1531,11 @@ int ValueType<T>::read(const byte* buf, size_t len, ByteOrder byteOrder) {
   size_t ts = TypeInfo::typeSize(typeId());
   if (ts > 0 && len % ts != 0)
     len = (len / ts) * ts;
+  if (ts == sizeof(T)) {
+    value_.resize(len / ts);
+    copyArray<T>(value_.data(), buf, value_.size(), byteOrder);
+    return 0;
+  }
   for (size_t i = 0; i < len; i += ts) {
     value_.push_back(getValue<T>(buf + i, byteOrder));
   }
@@ -1496,9 +1544,15 @@ int ValueType<T>::read(const byte* buf, size_t len, ByteOrder byteOrder) {
 
 template <typename T>
 int ValueType<T>::read(const std::string& buf) {
+  ValueList val;
+  if (parseNumbers(buf, val)) {
+    value_ = std::move(val);
+    return 0;
+  }
+  // Leave the input which parseNumbers() does not handle to a stream
+  val.clear();
   std::istringstream is(buf);
   T tmp;
-  ValueList val;
   while (is >> tmp)
     val.push_back(tmp);
   if (!is.eof())
@@ -1509,11 +1563,8 @@ int ValueType<T>::read(const std::string& buf) {
 
 template <typename T>
 size_t ValueType<T>::copy(byte* buf, ByteOrder byteOrder) const {
-  size_t offset = 0;
-  for (const auto& val : value_) {
-    offset += toData(buf + offset, val, byteOrder);
-  }
-  return offset;
+  copyArray<T>(buf, value_.data(), value_.size(), byteOrder);
+  return value_.size() * sizeof(T);
 }
 
 template <typename T>
@@ -1546,7 +1597,23 @@ std::ostream& ValueType<T>::write(std::ostream& os) const {
 template <typename T>
 std::string ValueType<T>::toString(size_t n) const {
   ok_ = true;
-  return Exiv2::toString<T>(value_.at(n));
+  std::string str;
+  appendNumber(str, value_.at(n));
+  return str;
+}
+
+template <typename T>
+std::string ValueType<T>::toString_() const {
+  if (typeid(*this) != typeid(ValueType<T>))
+    return Value::toString_();
+  ok_ = true;
+  std::string str;
+  for (auto i = value_.begin(); i != value_.end(); ++i) {
+    if (i != value_.begin())
+      str += ' ';
+    appendNumber(str, *i, 15);
+  }
+  return str;
 }
 
 // Default implementation
@@ -263,12 +263,14 @@ class EXIV2API XmpParser {
 
     @param xmpData   Container for the decoded XMP properties
     @param xmpPacket The raw XMP packet to decode
+    @param filter    The metadata to decode; the schemas it does not pass
+                     are skipped, and the whole packet if it passes no XMP.
     @return 0 if successful;<BR>
             1 if XMP support has not been compiled-in;<BR>
             2 if the XMP toolkit failed to initialize;<BR>
             3 if the XMP toolkit failed and raised an XMP_Error
   */
-  static int decode(XmpData& xmpData, const std::string& xmpPacket);
+  static int decode(XmpData& xmpData, const std::string& xmpPacket, const ReadFilter& filter = {});
   /*!
     @brief Encode (serialize) XMP metadata from \em xmpData into a
            string xmpPacket. The XMP packet returned in the string
@@ -0,0 +1,1099 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Micro benchmarks for performance sensitive code paths of the library.
+// Each benchmark prints its timings for a range of input sizes, which shows
+// how the run time scales.
+
+#include <exiv2/exiv2.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if __has_include(<sys/resource.h>)
+#include <sys/resource.h>
+#endif
+#if defined(__GLIBC__) && __GLIBC_PREREQ(2, 33)
+#include <malloc.h>
+#define EXV_HAVE_MALLINFO2
+#endif
+
+#if defined(EXV_ENABLE_WEBREADY) && !defined(_WIN32)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <mutex>
+#endif
+
+using namespace Exiv2;
+namespace fs = std::filesystem;
+
+namespace {
+//! Number of calls to operator new, including those made by the library
+std::atomic<size_t> allocations{0};
+//! Number of bytes allocated with operator new
+std::atomic<size_t> allocatedBytes{0};
+}  // namespace
+
+// Count all allocations. This replaces the allocation functions of the library
+// too, unless it is a DLL on Windows.
+void* operator new(std::size_t size) {
+  ++allocations;
+  allocatedBytes += size;
+  if (void* p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+// GCC sees the std::free() of the replacement below where it is inlined, but
+// not the std::malloc() of the one above, and takes them for a mismatch.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+  std::free(p);
+}
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+namespace {
+//! Return the number of allocations made by \em fct
+size_t countAllocations(const std::function<void()>& fct) {
+  const size_t start = allocations;
+  fct();
+  return allocations - start;
+}
+
+//! Return the number of bytes allocated by \em fct
+size_t countBytes(const std::function<void()>& fct) {
+  const size_t start = allocatedBytes;
+  fct();
+  return allocatedBytes - start;
+}
+
+//! Return the run time of \em fct in microseconds
+double timeIt(const std::function<void()>& fct) {
+  auto start = std::chrono::steady_clock::now();
+  fct();
+  std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+//! Print one line of results: the size and the time per item of each measurement
+void report(size_t size, std::initializer_list<std::pair<const char*, double>> results) {
+  std::cout << std::setw(8) << size;
+  for (auto&& [label, micros] : results) {
+    std::cout << "  " << label << " " << std::fixed << std::setprecision(3) << std::setw(9) << micros / size
+              << " us/item";
+  }
+  std::cout << "\n";
+}
+
+//! Return an ExifData container with \em size distinct tags in IFD0
+ExifData makeExifData(size_t size) {
+  ExifData exifData;
+  exifData["Exif.Image.Make"] = "Exiv2";
+  exifData["Exif.Image.Model"] = "perf-test";
+  exifData["Exif.Photo.DateTimeOriginal"] = "2024:01:01 12:00:00";
+  for (size_t i = 0; i < size; ++i) {
+    UShortValue value;
+    value.value_.push_back(static_cast<uint16_t>(i));
+    exifData.add(ExifKey(static_cast<uint16_t>(0x1000 + i), "Image"), &value);
+  }
+  return exifData;
+}
+
+//! Time the decoding and encoding of an array of \em size values of type T, in bulk and one by one
+template <typename T>
+bool arrayType(const char* name, size_t size) {
+  std::vector<byte> data(size * sizeof(T));
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<byte>(i * 7);
+  constexpr int repeat = 100;
+
+  ValueType<T> value;
+  const auto decode = timeIt([&] {
+    for (int n = 0; n < repeat; ++n)
+      value.read(data.data(), data.size(), bigEndian);
+  });
+  std::vector<T> single;
+  const auto decodeSingle = timeIt([&] {
+    for (int n = 0; n < repeat; ++n) {
+      single.clear();
+      for (size_t i = 0; i < data.size(); i += sizeof(T))
+        single.push_back(getValue<T>(data.data() + i, bigEndian));
+    }
+  });
+  std::vector<byte> encoded(data.size());
+  const auto encode = timeIt([&] {
+    for (int n = 0; n < repeat; ++n)
+      value.copy(encoded.data(), bigEndian);
+  });
+  std::vector<byte> encodedSingle(data.size());
+  const auto encodeSingle = timeIt([&] {
+    for (int n = 0; n < repeat; ++n) {
+      size_t offset = 0;
+      for (const auto& val : single)
+        offset += toData(encodedSingle.data() + offset, val, bigEndian);
+    }
+  });
+  std::cout << std::setw(10) << name << std::setw(7) << size;
+  for (auto&& [label, micros] : {std::pair{"decode", decode}, std::pair{"one by one", decodeSingle},
+                                 std::pair{"encode", encode}, std::pair{"one by one", encodeSingle}}) {
+    std::cout << "  " << label << " " << std::fixed << std::setprecision(2) << std::setw(6)
+              << micros * 1000 / (size * repeat) << " ns/item";
+  }
+  std::cout << "\n";
+  // Compare the bytes, as some of the doubles are NaNs
+  return value.value_.size() == single.size() && std::memcmp(value.value_.data(), single.data(), data.size()) == 0 &&
+         encoded == data && encodedSingle == data;
+}
+
+/*
+  Decoding and encoding of numeric arrays like StripOffsets, ColorMatrix or
+  tone curves, in big endian byte order, in bulk by ValueType and one value
+  at a time. Checks that both give the same results.
+ */
+int arrays(int /*argc*/, char* const /*argv*/[]) {
+  bool same = true;
+  for (size_t size : {4, 16, 256, 4096, 65536}) {
+    same &= arrayType<uint16_t>("ushort", size);
+    same &= arrayType<uint32_t>("ulong", size);
+    same &= arrayType<URational>("urational", size);
+    same &= arrayType<double>("double", size);
+  }
+  if (!same)
+    std::cout << "DIFFERENT\n";
+  return same ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*
+  ExifData key lookup, write (TIFF encoding) and Exif to XMP conversion.
+  With an indexed container the time per item stays flat as the size grows.
+ */
+int exifdata(int /*argc*/, char* const /*argv*/[]) {
+  for (size_t size : {250, 500, 1000, 2000, 4000, 8000}) {
+    ExifData exifData = makeExifData(size);
+    const auto lookup = timeIt([&] {
+      for (auto&& md : exifData) {
+        if (exifData.findKey(ExifKey(md.tag(), md.groupName())) == exifData.end())
+          throw Error(ErrorCode::kerErrorMessage, "findKey failed for " + md.key());
+      }
+    });
+    const auto write = timeIt([&] {
+      Blob blob;
+      ExifParser::encode(blob, nullptr, 0, littleEndian, exifData);
+    });
+    const auto convert = timeIt([&] {
+      XmpData xmpData;
+      copyExifToXmp(exifData, xmpData);
+    });
+    report(exifData.count(), {{"lookup", lookup}, {"write", write}, {"convert", convert}});
+  }
+  return EXIT_SUCCESS;
+}
+
+//! MemIo which counts the calls to read and seek
+class CountingIo : public MemIo {
+ public:
+  CountingIo(const byte* data, size_t size) : MemIo(data, size) {
+  }
+  using MemIo::read;
+  size_t read(byte* buf, size_t rcount) override {
+    ++calls_;
+    return MemIo::read(buf, rcount);
+  }
+  int getb() override {
+    ++calls_;
+    return MemIo::getb();
+  }
+  int seek(int64_t offset, Position pos) override {
+    ++calls_;
+    return MemIo::seek(offset, pos);
+  }
+  size_t calls_{0};
+};
+
+/*
+  Metadata decoding of each file with the makernote decoded when it is read,
+  deferred and never used, and deferred and then decoded by counting the
+  Exif data. Checks that the Exif data is the same as decoded when read.
+ */
+int makernote(int argc, char* const argv[]) {
+  if (argc < 2) {
+    std::cout << "Usage: makernote file...\n";
+    return EXIT_FAILURE;
+  }
+  ReadFilter deferred;
+  deferred.setDeferMakernote(true);
+  int rc = EXIT_SUCCESS;
+  for (int i = 1; i < argc; ++i) {
+    auto read = [&](const ReadFilter& filter) {
+      auto image = ImageFactory::open(argv[i]);
+      image->setReadFilter(filter);
+      image->readMetadata();
+      return image;
+    };
+    const auto eager = timeIt([&] { read({}); });
+    const auto unused = timeIt([&] { read(deferred); });
+    size_t usedCount = 0;
+    const auto used = timeIt([&] { usedCount = read(deferred)->exifData().count(); });
+
+    const auto expected = read({});
+    const auto image = read(deferred);
+    const ExifData& exifData = image->exifData();
+    const ExifData& expectedData = expected->exifData();
+    bool same = exifData.count() == expectedData.count() && usedCount == expectedData.count();
+    for (auto e = expectedData.begin(), d = exifData.begin(); same && d != exifData.end(); ++e, ++d) {
+      same = e->key() == d->key() && e->typeId() == d->typeId() && e->count() == d->count() &&
+             e->toString() == d->toString() && e->print(&expectedData) == d->print(&exifData);
+    }
+    std::cout << std::setw(6) << exifData.count() << " tags " << std::fixed << std::setprecision(3) << std::setw(10)
+              << eager << " us  deferred " << std::setw(10) << unused << " us  used " << std::setw(10) << used
+              << " us  " << (same ? "" : "DIFFERENT ") << argv[i] << "\n";
+    if (!same)
+      rc = EXIT_FAILURE;
+  }
+  return rc;
+}
+
+/*
+  Metadata decoding of each file with and without a read filter for one key,
+  as with exiv2 -K key. Reports the number of metadata and allocations and
+  the time of each read.
+ */
+int readfilter(int argc, char* const argv[]) {
+  if (argc < 3) {
+    std::cout << "Usage: readfilter key file...\n";
+    return EXIT_FAILURE;
+  }
+  ReadFilter filter;
+  filter.addKey(argv[1]);
+  for (int i = 2; i < argc; ++i) {
+    for (auto&& [label, f] : {std::pair{"all", ReadFilter()}, std::pair{"key", filter}}) {
+      Image::UniquePtr image;
+      const size_t allocs = countAllocations([&] {
+        image = ImageFactory::open(argv[i]);
+        image->setReadFilter(f);
+        image->readMetadata();
+      });
+      const auto micros = timeIt([&] {
+        auto img = ImageFactory::open(argv[i]);
+        img->setReadFilter(f);
+        img->readMetadata();
+      });
+      const size_t count = image->exifData().count() + image->iptcData().count() + image->xmpData().count();
+      std::cout << label << std::setw(6) << count << " metadata " << std::setw(8) << allocs << " allocs " << std::fixed
+                << std::setprecision(3) << std::setw(10) << micros << " us  " << argv[i] << "\n";
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+/*
+  Image type detection with ImageFactory::getType() for each file. Reports
+  the number of read and seek calls per detection, each of which is a round
+  trip on a remote or network file, and the time per detection.
+ */
+int imagetype(int argc, char* const argv[]) {
+  if (argc < 2) {
+    std::cout << "Usage: imagetype file...\n";
+    return EXIT_FAILURE;
+  }
+  constexpr size_t loops = 1000;
+  for (int i = 1; i < argc; ++i) {
+    FileIo file(argv[i]);
+    if (file.open() != 0) {
+      throw Error(ErrorCode::kerDataSourceOpenFailed, file.path(), strError());
+    }
+    DataBuf buf = file.read(file.size());
+    CountingIo io(buf.c_data(), buf.size());
+    ImageType type = ImageFactory::getType(io);
+    const size_t calls = io.calls_;
+    const auto micros = timeIt([&] {
+      for (size_t n = 0; n < loops; ++n)
+        ImageFactory::getType(io);
+    });
+    std::cout << std::setw(6) << static_cast<int>(type) << std::setw(6) << calls << " io calls  " << std::fixed
+              << std::setprecision(3) << std::setw(9) << micros / loops << " us  " << argv[i] << "\n";
+  }
+  return EXIT_SUCCESS;
+}
+
+/*
+  ExifKey construction from a key string and from a tag number and group name,
+  for every known tag of all IFD and makernote groups. Each construction looks
+  up the group and the tag, so the time per key should not depend on the size
+  of the group's tag list.
+ */
+int exifkeys(int /*argc*/, char* const /*argv*/[]) {
+  std::vector<std::pair<uint16_t, std::string>> tags;
+  std::vector<std::string> keys;
+  for (auto gi = ExifTags::groupList(); gi->tagList_; ++gi) {
+    const std::string groupName = gi->groupName_;
+    if (!ExifTags::isExifGroup(groupName) && !ExifTags::isMakerGroup(groupName))
+      continue;
+    for (auto ti = gi->tagList_(); ti->tag_ != 0xffff; ++ti) {
+      tags.emplace_back(ti->tag_, groupName);
+      keys.push_back("Exif." + groupName + "." + ti->name_);
+    }
+  }
+  for (size_t loops : {1, 4, 16}) {
+    const auto fromTag = timeIt([&] {
+      for (size_t n = 0; n < loops; ++n) {
+        for (auto&& [tag, groupName] : tags)
+          ExifKey key(tag, groupName);
+      }
+    });
+    const auto fromString = timeIt([&] {
+      for (size_t n = 0; n < loops; ++n) {
+        for (auto&& key : keys)
+          ExifKey k(key);
+      }
+    });
+    report(loops * keys.size(), {{"tag", fromTag}, {"string", fromString}});
+  }
+  return EXIT_SUCCESS;
+}
+
+/*
+  Bytes allocated by reading the metadata of each file and by copying the
+  Exif data, with the size of the Exif values of type undefined and byte,
+  like the makernote, ICC profile and XMP packet, which are copied with them.
+  With glibc, also the heap memory the Exif data keeps once the image is
+  gone, which includes the buffers its values refer to.
+ */
+int blobs(int argc, char* const argv[]) {
+  if (argc < 2) {
+    std::cout << "Usage: blobs file...\n";
+    return EXIT_FAILURE;
+  }
+  for (int i = 1; i < argc; ++i) {
+    Image::UniquePtr image;
+    const size_t read = countBytes([&] {
+      image = ImageFactory::open(argv[i]);
+      image->readMetadata();
+    });
+    size_t blobBytes = 0;
+    for (auto&& md : image->exifData()) {
+      if (md.typeId() == undefined || md.typeId() == unsignedByte)
+        blobBytes += md.size();
+    }
+    const size_t copy = countBytes([&] { ExifData exifData(image->exifData()); });
+    std::cout << std::setw(10) << blobBytes << " bytes in blobs  read " << std::setw(10) << read << " bytes  copy "
+              << std::setw(10) << copy << " bytes  ";
+#ifdef EXV_HAVE_MALLINFO2
+    image.reset();
+    const size_t before = mallinfo2().uordblks;
+    ExifData exifData;
+    {
+      auto other = ImageFactory::open(argv[i]);
+      other->readMetadata();
+      exifData = std::move(other->exifData());
+    }
+    std::cout << "kept " << std::setw(10) << mallinfo2().uordblks - before << " bytes  ";
+#endif
+    std::cout << argv[i] << "\n";
+  }
+  return EXIT_SUCCESS;
+}
+
+/*
+  Metadata decoding of each file, with the number of allocations it makes.
+  Then, for the decoded Exif data, the allocations made to create, copy and
+  compare the keys of all Exifdatums and to sort the container by key. Keys
+  only refer to static tables, so these should all be zero, except for the
+  rebuild of the ExifData index after sorting.
+ */
+int decode(int argc, char* const argv[]) {
+  if (argc < 2) {
+    std::cout << "Usage: decode file...\n";
+    return EXIT_FAILURE;
+  }
+  for (int i = 1; i < argc; ++i) {
+    Image::UniquePtr image;
+    const size_t read = countAllocations([&] {
+      image = ImageFactory::open(argv[i]);
+      image->readMetadata();
+    });
+    const auto micros = timeIt([&] {
+      auto img = ImageFactory::open(argv[i]);
+      img->readMetadata();
+    });
+    ExifData& exifData = image->exifData();
+    std::vector<std::pair<uint16_t, std::string>> tags;
+    std::vector<ExifKey> keys;
+    tags.reserve(exifData.count());
+    keys.reserve(exifData.count());
+    for (auto&& md : exifData)
+      tags.emplace_back(md.tag(), md.groupName());
+    const size_t create = countAllocations([&] {
+      for (auto&& [tag, groupName] : tags)
+        keys.emplace_back(tag, groupName);
+    });
+    const size_t copy = countAllocations([&] {
+      for (auto& key : keys)
+        key = ExifKey(key);
+    });
+    size_t found = 0;
+    const size_t compare = countAllocations([&] {
+      for (auto&& key : keys)
+        found += exifData.findKey(key) != exifData.end();
+    });
+    const size_t sort = countAllocations([&] { exifData.sortByKey(); });
+    std::cout << std::setw(6) << exifData.count() << " tags " << std::setw(8) << read << " allocs " << std::fixed
+              << std::setprecision(3) << std::setw(10) << micros << " us  keys: create " << create << " copy " << copy
+              << " find " << compare << " sort " << sort << "  " << argv[i] << "\n";
+    if (found != keys.size())
+      throw Error(ErrorCode::kerErrorMessage, "findKey failed");
+  }
+  return EXIT_SUCCESS;
+}
+
+/*
+  Metadata reads of the files with readMetadataBatch(), for a growing number
+  of worker threads. The files are repeated to give each run enough work. The
+  number of files per second should grow with the threads, up to the number
+  of cores.
+ */
+int batch(int argc, char* const argv[]) {
+  if (argc < 2) {
+    std::cout << "Usage: batch file...\n";
+    return EXIT_FAILURE;
+  }
+  std::vector<std::string> paths;
+  while (paths.size() < 2000) {
+    for (int i = 1; i < argc; ++i)
+      paths.emplace_back(argv[i]);
+  }
+  const unsigned cores = std::max(1U, std::thread::hardware_concurrency());
+  for (unsigned threads = 1; threads <= 2 * cores; threads *= 2) {
+    size_t tags = 0;
+    const auto micros = timeIt([&] {
+      readMetadataBatch(paths, threads, mdExif | mdIptc | mdXmp,
+                        [&](BatchResult& result) { tags += result.exifData_.count(); });
+    });
+    std::cout << std::setw(4) << threads << " threads  " << std::fixed << std::setprecision(0) << std::setw(8)
+              << paths.size() / micros * 1e6 << " files/s  " << tags << " tags\n";
+  }
+  return EXIT_SUCCESS;
+}
+
+#ifdef EXV_ENABLE_WEBREADY
+/*
+  Range requests to the given http URL, each on a new connection and all on
+  one kept-alive connection with HttpConnection, followed by a metadata read
+  over HttpIo.
+  Keep-alive saves a round trip per request, more so with a distant server.
+ */
+int httpread(int argc, char* const argv[]) {
+  if (argc < 2) {
+    std::cout << "Usage: httpread url\n";
+    return EXIT_FAILURE;
+  }
+  const auto uri = Uri::Parse(argv[1]);
+  const size_t loops = 100;
+  Dictionary request = {
+      {"server", uri.Host}, {"port", uri.Port}, {"page", uri.Path}, {"header", "Range: bytes=0-4095"}};
+  Dictionary response;
+  std::string errors;
+  HttpConnection connection;
+  const auto fresh = timeIt([&] {
+    for (size_t i = 0; i < loops; ++i) {
+      connection.request(request, response, errors);
+      connection.disconnect();
+    }
+  });
+  const auto kept = timeIt([&] {
+    for (size_t i = 0; i < loops; ++i)
+      connection.request(request, response, errors);
+  });
+  report(loops, {{"new connection", fresh}, {"keep-alive", kept}});
+
+  size_t tags = 0;
+  const auto micros = timeIt([&] {
+    auto image = ImageFactory::open(std::make_unique<HttpIo>(argv[1]));
+    image->readMetadata();
+    tags = image->exifData().count();
+  });
+  std::cout << "metadata     " << std::fixed << std::setprecision(1) << std::setw(8) << micros / 1000 << " ms  " << tags
+            << " tags\n";
+  return EXIT_SUCCESS;
+}
+#endif
+
+#if defined(EXV_ENABLE_WEBREADY) && !defined(_WIN32)
+/*!
+  @brief An HTTP/1.1 server on the loopback interface, which serves one file
+         with range requests and keep-alive, and delays each response like a
+         distant server.
+ */
+class LoopbackServer {
+ public:
+  explicit LoopbackServer(std::chrono::microseconds latency) : latency_(latency) {
+    listenFd_ = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (bind(listenFd_, reinterpret_cast<sockaddr*>(&address), length) != 0 || listen(listenFd_, 16) != 0 ||
+        getsockname(listenFd_, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+      throw std::runtime_error("Failed to start the loopback server");
+    }
+    port_ = ntohs(address.sin_port);
+    acceptor_ = std::thread([this] {
+      for (int fd = accept(listenFd_, nullptr, nullptr); fd >= 0; fd = accept(listenFd_, nullptr, nullptr)) {
+        std::lock_guard lock(mutex_);
+        clientFds_.push_back(fd);
+        clients_.emplace_back([this, fd] { serve(fd); });
+      }
+    });
+  }
+
+  ~LoopbackServer() {
+    shutdown(listenFd_, SHUT_RDWR);
+    close(listenFd_);
+    acceptor_.join();
+    {
+      std::lock_guard lock(mutex_);
+      for (int fd : clientFds_)
+        shutdown(fd, SHUT_RDWR);
+    }
+    for (auto& t : clients_)
+      t.join();
+    for (int fd : clientFds_)
+      close(fd);
+  }
+
+  LoopbackServer(const LoopbackServer&) = delete;
+  LoopbackServer& operator=(const LoopbackServer&) = delete;
+
+  //! Serve \em content from now on
+  void setContent(std::string content) {
+    std::lock_guard lock(mutex_);
+    content_ = std::make_shared<const std::string>(std::move(content));
+  }
+
+  [[nodiscard]] std::string url() const {
+    return "http://127.0.0.1:" + std::to_string(port_) + "/file";
+  }
+
+ private:
+  void serve(int fd) {
+    std::string in;
+    char buffer[4096];
+    for (;;) {
+      auto end = in.find("\r\n\r\n");
+      while (end == std::string::npos) {
+        auto n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0)
+          return;
+        in.append(buffer, n);
+        end = in.find("\r\n\r\n");
+      }
+      const std::string request = in.substr(0, end);
+      in.erase(0, end + 4);
+      std::shared_ptr<const std::string> content;
+      {
+        std::lock_guard lock(mutex_);
+        content = content_;
+      }
+
+      size_t first = 0;
+      size_t last = content->size() - 1;
+      std::string status = "200 OK";
+      if (auto range = request.find("Range: bytes="); range != std::string::npos) {
+        first = std::stoul(request.substr(range + 13));
+        last = std::min<size_t>(std::stoul(request.substr(request.find('-', range + 13) + 1)), last);
+        status = "206 Partial Content";
+      }
+      std::string response = "HTTP/1.1 " + status + "\r\nContent-Length: " + std::to_string(last - first + 1) + "\r\n\r\n";
+      if (request.compare(0, 4, "HEAD") != 0)
+        response.append(*content, first, last - first + 1);
+      std::this_thread::sleep_for(latency_);
+      if (send(fd, response.data(), response.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(response.size()))
+        return;
+    }
+  }
+
+  std::chrono::microseconds latency_;
+  int listenFd_;
+  uint16_t port_;
+  std::mutex mutex_;
+  std::shared_ptr<const std::string> content_;
+  std::vector<int> clientFds_;
+  std::vector<std::thread> clients_;
+  std::thread acceptor_;
+};
+
+/*
+  Metadata reads of the files over HttpIo from a loopback server with a
+  latency of 1 ms per request, for a growing maximum readahead. With the
+  readahead the number of requests, and so the time, should drop, while the
+  number of bytes fetched grows only a little.
+ */
+int remoteread(int argc, char* const argv[]) {
+  if (argc < 2) {
+    std::cout << "Usage: remoteread file...\n";
+    return EXIT_FAILURE;
+  }
+  LoopbackServer server(std::chrono::milliseconds(1));
+  for (size_t readahead : {0, 16 * 1024, 64 * 1024, 256 * 1024}) {
+    size_t requests = 0;
+    size_t fetched = 0;
+    double micros = 0;
+    for (int i = 1; i < argc; ++i) {
+      std::ifstream file(argv[i], std::ios::binary);
+      server.setContent({std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()});
+      auto io = std::make_unique<HttpIo>(server.url());
+      io->setReadahead(readahead);
+      const auto remote = io.get();
+      Image::UniquePtr image;
+      try {
+        micros += timeIt([&] {
+          image = ImageFactory::open(std::move(io));
+          if (image)
+            image->readMetadata();
+        });
+      } catch (const Error&) {
+        // the requests are counted anyway
+      }
+      if (image) {
+        requests += remote->requests();
+        fetched += remote->bytesFetched();
+      }
+    }
+    std::cout << std::setw(4) << readahead / 1024 << " KB readahead  " << std::setw(7) << requests << " requests  "
+              << std::setw(8) << fetched / 1024 << " KB  " << std::fixed << std::setprecision(1) << std::setw(8)
+              << micros / 1000 << " ms\n";
+  }
+  return EXIT_SUCCESS;
+}
+#endif
+
+/*
+  Metadata writes to JPEG files of growing size, made by appending data to
+  the scan data of the given file. A file with one hard link is written
+  through a temporary file, copying the scan data in the kernel, so the peak
+  memory should not grow with the file size. A file with two links is
+  written through a copy in memory, as before, for comparison.
+ */
+int jpegwrite(int argc, char* const argv[]) {
+  if (argc < 2) {
+    std::cout << "Usage: jpegwrite file.jpg\n";
+    return EXIT_FAILURE;
+  }
+  //! Return the peak resident set size in KB, 0 if unknown
+  auto peakRss = [] {
+#if __has_include(<sys/resource.h>)
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+      return static_cast<long>(usage.ru_maxrss);
+#endif
+    return 0L;
+  };
+  const std::string path = "perf-test-jpegwrite.jpg";
+  const std::string link = "perf-test-jpegwrite-link.jpg";
+  // The peak only grows, so run all writes through a temporary file first
+  for (bool staged : {false, true}) {
+    for (size_t megabytes : {8, 32, 128}) {
+      fs::copy_file(argv[1], path, fs::copy_options::overwrite_existing);
+      {
+        std::ofstream file(path, std::ios::binary | std::ios::app);
+        const std::vector<char> padding(1024 * 1024);
+        for (size_t n = 0; n < megabytes; ++n)
+          file.write(padding.data(), padding.size());
+      }
+      if (staged)
+        fs::create_hard_link(path, link);
+      auto image = ImageFactory::open(path);
+      image->readMetadata();
+      image->exifData()["Exif.Image.Artist"] = "perf-test";
+      const long rss = peakRss();
+      const auto micros = timeIt([&] { image->writeMetadata(); });
+      std::cout << std::setw(4) << megabytes << " MB  " << (staged ? "in memory " : "temp file ") << std::fixed
+                << std::setprecision(1) << std::setw(8) << micros / 1000 << " ms  peak RSS +" << std::setw(7)
+                << (peakRss() - rss) / 1024 << " MB\n";
+      image.reset();
+      fs::remove(link);
+      fs::remove(path);
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+/*
+  Preview listing of each file, like exiv2 -pp, after reading the metadata.
+  Reports the allocations and the time of the listing, and checks that the
+  listed sizes are those of the preview images and that views of the
+  preview images have the same data as copies.
+ */
+int previews(int argc, char* const argv[]) {
+  if (argc < 2) {
+    std::cout << "Usage: previews file...\n";
+    return EXIT_FAILURE;
+  }
+  int rc = EXIT_SUCCESS;
+  for (int i = 1; i < argc; ++i) {
+    auto image = ImageFactory::open(argv[i]);
+    image->readMetadata();
+    PreviewManager manager(*image);
+    PreviewPropertiesList list;
+    size_t bytes = 0;
+    const size_t allocs = countAllocations([&] { bytes = countBytes([&] { list = manager.getPreviewProperties(); }); });
+    const auto micros = timeIt([&] { list = manager.getPreviewProperties(); });
+
+    size_t total = 0;
+    size_t views = 0;
+    bool same = true;
+    for (auto&& props : list) {
+      const PreviewImage copy = manager.getPreviewImage(props);
+      const PreviewImage view = manager.getPreviewImageView(props);
+      total += props.size_;
+      views += view.isView();
+      if (copy.size() != props.size_ || view.size() != copy.size() ||
+          !std::equal(copy.pData(), copy.pData() + copy.size(), view.pData())) {
+        same = false;
+      }
+    }
+    std::cout << std::setw(2) << list.size() << " previews " << std::setw(10) << total << " bytes  " << std::setw(2)
+              << views << " views  list " << std::setw(6) << allocs << " allocs " << std::setw(10) << bytes
+              << " bytes " << std::fixed << std::setprecision(3) << std::setw(10) << micros << " us  "
+              << (same ? "" : "DIFFERENT ") << argv[i] << "\n";
+    if (!same)
+      rc = EXIT_FAILURE;
+  }
+  return rc;
+}
+
+/*
+  Extraction of the preview images of each file to a file, like exiv2 -ep,
+  through a copy of each preview image and written straight from the image.
+  Reports the bytes allocated and the time of both, and checks that they
+  write the same data.
+ */
+int previewwrite(int argc, char* const argv[]) {
+  if (argc < 2) {
+    std::cout << "Usage: previewwrite file...\n";
+    return EXIT_FAILURE;
+  }
+  const std::string copyPath = "perf-test-previewwrite-copy";
+  const std::string writePath = "perf-test-previewwrite";
+  int rc = EXIT_SUCCESS;
+  for (int i = 1; i < argc; ++i) {
+    auto image = ImageFactory::open(argv[i]);
+    image->readMetadata();
+    PreviewManager manager(*image);
+    for (auto&& props : manager.getPreviewProperties()) {
+      size_t copyBytes = 0;
+      size_t copySize = 0;
+      size_t writeBytes = 0;
+      size_t writeSize = 0;
+      const auto copyMicros = timeIt([&] {
+        copyBytes = countBytes([&] { copySize = manager.getPreviewImage(props).writeFile(copyPath); });
+      });
+      const auto writeMicros = timeIt([&] {
+        writeBytes = countBytes([&] {
+          FileIo file(writePath + props.extension_);
+          file.open("wb");
+          writeSize = manager.writePreviewImage(props, file);
+        });
+      });
+      const DataBuf copy = readFile(copyPath + props.extension_);
+      const DataBuf written = readFile(writePath + props.extension_);
+      const bool same = copySize == props.size_ && copy.size() == copySize && writeSize == copySize &&
+                        written.size() == copySize && std::equal(copy.begin(), copy.end(), written.begin());
+      std::cout << std::setw(10) << props.size_ << " bytes  copy " << std::setw(10) << copyBytes << " bytes "
+                << std::fixed << std::setprecision(3) << std::setw(10) << copyMicros << " us  write " << std::setw(10)
+                << writeBytes << " bytes " << std::setw(10) << writeMicros << " us  " << (same ? "" : "DIFFERENT ")
+                << argv[i] << " preview " << props.id_ << "\n";
+      fs::remove(copyPath + props.extension_);
+      fs::remove(writePath + props.extension_);
+      if (!same)
+        rc = EXIT_FAILURE;
+    }
+  }
+  return rc;
+}
+
+/*
+  Printing of the values of a large Exif set as strings, like exiv2 -pv, and
+  interpreted by the tag print functions, like exiv2 -pt, and parsing the
+  strings again. Checks that the parsed values print the same.
+ */
+int printing(int /*argc*/, char* const /*argv*/[]) {
+  const std::pair<const char*, const char*> tags[] = {
+      {"Exif.Photo.FNumber", "28/10"},
+      {"Exif.Photo.ExposureBiasValue", "-2/3"},
+      {"Exif.Photo.FocalLength", "1050/10"},
+      {"Exif.Photo.SubjectDistance", "345/100"},
+      {"Exif.Photo.DigitalZoomRatio", "3/2"},
+      {"Exif.Photo.ApertureValue", "4970854/1000000"},
+      {"Exif.GPSInfo.GPSAltitude", "123456/100"},
+      {"Exif.GPSInfo.GPSLatitude", "47/1 30/1 1234/100"},
+      {"Exif.Photo.ISOSpeedRatings", "200"},
+      {"Exif.Image.BitsPerSample", "8 8 8"},
+      {"Exif.Image.WhitePoint", "313/1000 329/1000"},
+      {"Exif.Image.XResolution", "300/1"},
+  };
+  bool same = true;
+  for (size_t size : {1200, 4800, 19200}) {
+    ExifData exifData;
+    for (size_t i = 0; i < size; ++i) {
+      auto [key, str] = tags[i % std::size(tags)];
+      const ExifKey exifKey(key);
+      auto value = Value::create(exifKey.defaultTypeId());
+      value->read(str);
+      exifData.add(exifKey, value.get());
+    }
+    std::vector<std::string> strings;
+    const auto toString = timeIt([&] {
+      for (auto&& md : exifData)
+        strings.push_back(md.value().toString());
+    });
+    std::vector<std::string> printed;
+    const auto print = timeIt([&] {
+      for (auto&& md : exifData)
+        printed.push_back(md.print(&exifData));
+    });
+    size_t i = 0;
+    const auto parse = timeIt([&] {
+      for (auto&& md : exifData)
+        md.setValue(strings[i++]);
+    });
+    i = 0;
+    for (auto&& md : exifData) {
+      same &= md.toString() == strings[i] && md.print(&exifData) == printed[i];
+      ++i;
+    }
+    report(size, {{"toString", toString}, {"print", print}, {"parse", parse}});
+  }
+  if (!same)
+    std::cout << "DIFFERENT\n";
+  return same ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*
+  Header scan of each file for the tags used to index images, compared to
+  reading all metadata. Reports the number of allocations and the time of
+  each, and checks that the scan finds the values read by readMetadata().
+ */
+int scan(int argc, char* const argv[]) {
+  if (argc < 2) {
+    std::cout << "Usage: scan file...\n";
+    return EXIT_FAILURE;
+  }
+  constexpr auto keys = std::array{
+      "Exif.Image.Make",
+      "Exif.Image.Model",
+      "Exif.Image.Orientation",
+      "Exif.Photo.DateTimeOriginal",
+      "Exif.GPSInfo.GPSLatitude",
+      "Exif.GPSInfo.GPSLongitude",
+  };
+  ExifScan exifScan;
+  for (auto key : keys)
+    exifScan.addKey(key);
+  int rc = EXIT_SUCCESS;
+  for (int i = 1; i < argc; ++i) {
+    auto image = ImageFactory::open(argv[i]);
+    const size_t readAllocs = countAllocations([&] { image->readMetadata(); });
+    const size_t scanAllocs = countAllocations([&] { image->scanExif(exifScan); });
+    const auto read = timeIt([&] { ImageFactory::open(argv[i])->readMetadata(); });
+    const auto scanned = timeIt([&] { ImageFactory::open(argv[i])->scanExif(exifScan); });
+
+    size_t found = 0;
+    bool same = true;
+    for (auto key : keys) {
+      const auto pos = image->exifData().findKey(ExifKey(key));
+      const Value* value = exifScan.value(key);
+      found += value != nullptr;
+      if (pos != image->exifData().end() && (!value || value->toString() != pos->toString()))
+        same = false;
+    }
+    std::cout << std::setw(2) << found << " tags  read " << std::setw(6) << readAllocs << " allocs " << std::fixed
+              << std::setprecision(3) << std::setw(10) << read << " us  scan " << std::setw(6) << scanAllocs
+              << " allocs " << std::setw(10) << scanned << " us  " << (same ? "" : "DIFFERENT ") << argv[i] << "\n";
+    if (!same)
+      rc = EXIT_FAILURE;
+  }
+  return rc;
+}
+
+/*
+  Allocations of the TIFF component trees, by a read of each file, held in
+  memory, and a write with one changed tag. The read parses the TIFF data
+  into a tree, the write parses it again and copies the tree into a new one
+  to encode it. The read also allocates the decoded metadata.
+ */
+int tifftree(int argc, char* const argv[]) {
+  if (argc < 2) {
+    std::cout << "Usage: tifftree file...\n";
+    return EXIT_FAILURE;
+  }
+  for (int i = 1; i < argc; ++i) {
+    FileIo file(argv[i]);
+    if (file.open() != 0) {
+      throw Error(ErrorCode::kerDataSourceOpenFailed, file.path(), strError());
+    }
+    DataBuf buf = file.read(file.size());
+    auto image = ImageFactory::open(buf.c_data(), buf.size());
+    // The first read also initializes static data
+    image->readMetadata();
+    const size_t reads = countAllocations([&] { image->readMetadata(); });
+    const auto readMicros = timeIt([&] { image->readMetadata(); });
+    image->exifData()["Exif.Image.Artist"] = "perf-test";
+    const size_t writes = countAllocations([&] { image->writeMetadata(); });
+    const auto writeMicros = timeIt([&] { image->writeMetadata(); });
+    std::cout << std::setw(6) << image->exifData().count() << " tags  read " << std::setw(6) << reads << " allocs "
+              << std::fixed << std::setprecision(3) << std::setw(10) << readMicros << " us  write " << std::setw(6)
+              << writes << " allocs " << std::setw(10) << writeMicros << " us  " << argv[i] << "\n";
+  }
+  return EXIT_SUCCESS;
+}
+
+/*
+  Metadata writes to each file, held in memory. Each write changes one tag
+  and encodes all Exif data, including the makernote, so the time per write
+  should grow linearly with the number of tags.
+ */
+int write(int argc, char* const argv[]) {
+  if (argc < 2) {
+    std::cout << "Usage: write file...\n";
+    return EXIT_FAILURE;
+  }
+  constexpr size_t loops = 20;
+  for (int i = 1; i < argc; ++i) {
+    FileIo file(argv[i]);
+    if (file.open() != 0) {
+      throw Error(ErrorCode::kerDataSourceOpenFailed, file.path(), strError());
+    }
+    DataBuf buf = file.read(file.size());
+    auto image = ImageFactory::open(buf.c_data(), buf.size());
+    image->readMetadata();
+    const size_t count = image->exifData().count();
+    const auto micros = timeIt([&] {
+      for (size_t n = 0; n < loops; ++n) {
+        image->exifData()["Exif.Image.Artist"] = "perf-test " + std::to_string(n);
+        image->writeMetadata();
+      }
+    });
+    std::cout << std::setw(6) << count << " tags  " << std::fixed << std::setprecision(3) << std::setw(10)
+              << micros / loops << " us/write  " << std::setw(7) << micros / loops / count << " us/tag  " << argv[i]
+              << "\n";
+  }
+  return EXIT_SUCCESS;
+}
+
+/*
+  XMP key construction and property lookups from several threads at once.
+  Lookups in the namespace registry do not take a lock, so the time per key
+  should stay flat as threads are added, up to the number of cores.
+ */
+int xmpkeys(int /*argc*/, char* const /*argv*/[]) {
+  XmpProperties::registerNs("http://ns.example.com/perf-test/", "perf");
+  const char* keys[] = {"Xmp.dc.title", "Xmp.xmp.CreateDate", "Xmp.exif.DateTimeOriginal", "Xmp.perf.Custom"};
+  constexpr size_t loops = 20000;
+  const unsigned cores = std::max(1U, std::thread::hardware_concurrency());
+  for (unsigned threads = 1; threads <= 2 * cores; threads *= 2) {
+    const auto micros = timeIt([&] {
+      std::vector<std::thread> workers;
+      for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+          for (size_t n = 0; n < loops; ++n) {
+            XmpKey key(keys[n % std::size(keys)]);
+            XmpProperties::propertyType(key);
+          }
+        });
+      }
+      for (auto& w : workers)
+        w.join();
+    });
+    std::cout << std::setw(4) << threads << " threads";
+    report(threads * loops, {{"key", micros}});
+  }
+  return EXIT_SUCCESS;
+}
+
+struct Benchmark {
+  const char* name_;
+  const char* usage_;
+  int (*fct_)(int argc, char* const argv[]);
+};
+
+constexpr Benchmark benchmarks[] = {
+    {"arrays", "", arrays},
+    {"batch", "file...", batch},
+    {"blobs", "file...", blobs},
+    {"decode", "file...", decode},
+    {"exifdata", "", exifdata},
+    {"exifkeys", "", exifkeys},
+#ifdef EXV_ENABLE_WEBREADY
+    {"httpread", "url", httpread},
+#endif
+    {"imagetype", "file...", imagetype},
+    {"jpegwrite", "file.jpg", jpegwrite},
+    {"makernote", "file...", makernote},
+    {"previews", "file...", previews},
+    {"previewwrite", "file...", previewwrite},
+    {"printing", "", printing},
+    {"readfilter", "key file...", readfilter},
+#if defined(EXV_ENABLE_WEBREADY) && !defined(_WIN32)
+    {"remoteread", "file...", remoteread},
+#endif
+    {"scan", "file...", scan},
+    {"tifftree", "file...", tifftree},
+    {"write", "file...", write},
+    {"xmpkeys", "", xmpkeys},
+};
+
+void usage(const char* prog) {
+  std::cout << "Usage: " << prog << " benchmark [args]\n"
+            << "Benchmarks:\n";
+  for (auto&& b : benchmarks) {
+    std::cout << "  " << b.name_ << " " << b.usage_ << "\n";
+  }
+}
+}  // namespace
+
+int main(int argc, char* const argv[]) {
+  try {
+    XmpParser::initialize();
+    ::atexit(XmpParser::terminate);
+
+    if (argc < 2) {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+    for (auto&& b : benchmarks) {
+      if (std::strcmp(argv[1], b.name_) == 0) {
+        return b.fct_(argc - 1, argv + 1);
+      }
+    }
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  } catch (const Error& e) {
+    std::cout << e << "\n";
+    return EXIT_FAILURE;
+  }
+}
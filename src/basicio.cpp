@@ -12,12 +12,14 @@
 #include "types.hpp"
 
 #include <algorithm>
+#include <cerrno>
 #include <cstdio>   // for remove, rename
 #include <cstdlib>  // for alloc, realloc, free
 #include <cstring>  // std::memcpy
 #include <ctime>    // timestamp for the name of temporary file
 #include <fstream>  // write the temporary file
 #include <iostream>
+#include <vector>
 
 #if __has_include(<sys/mman.h>)
 #include <sys/mman.h>  // for mmap and munmap
@@ -28,6 +30,12 @@
 #if __has_include(<unistd.h>)
 #include <unistd.h>
 #endif
+#ifdef EXV_HAVE_SENDFILE
+#include <sys/sendfile.h>
+#endif
+#ifdef _WIN32
+#include <io.h>  // _write in sendRange
+#endif
 
 #ifdef EXV_USE_CURL
 #include <curl/curl.h>
@@ -51,6 +59,23 @@ namespace Exiv2 {
 
 BasicIo::~BasicIo() = default;
 
+size_t BasicIo::writeRange(BasicIo& src, size_t offset, size_t wcount) {
+  if (src.seek(static_cast<int64_t>(offset), BasicIo::beg) != 0)
+    return 0;
+  std::vector<byte> buf(std::min<size_t>(wcount, 64 * 1024));
+  size_t writeTotal = 0;
+  while (writeTotal < wcount) {
+    const size_t readCount = src.read(buf.data(), std::min(buf.size(), wcount - writeTotal));
+    if (readCount == 0)
+      break;
+    const size_t writeCount = write(buf.data(), readCount);
+    writeTotal += writeCount;
+    if (writeCount != readCount)
+      break;
+  }
+  return writeTotal;
+}
+
 void BasicIo::readOrThrow(byte* buf, size_t rcount, ErrorCode err) {
   const size_t nread = read(buf, rcount);
   Internal::enforce(nread == rcount, err);
@@ -352,23 +377,73 @@ size_t FileIo::write(BasicIo& src) {
   if (p_->switchMode(Impl::opWrite) != 0)
     return 0;
 
-  byte buf[4096];
+#ifdef EXV_HAVE_COPY_FILE_RANGE
+  // Let the kernel copy the data from another file, without passing it through user space
+  auto fileIo = dynamic_cast<FileIo*>(&src);
+  if (fileIo && fileIo->p_->switchMode(Impl::opSeek) == 0 && std::fflush(p_->fp_) == 0) {
+    const int srcFd = fileno(fileIo->p_->fp_);
+    const int dstFd = fileno(p_->fp_);
+    off_t srcOffset = ftello(fileIo->p_->fp_);
+    off_t dstOffset = ftello(p_->fp_);
+    size_t copied = 0;
+    ssize_t rc = -1;
+    while (srcOffset >= 0 && dstOffset >= 0 &&
+           (rc = ::copy_file_range(srcFd, &srcOffset, dstFd, &dstOffset, 1 << 30, 0)) > 0) {
+      copied += static_cast<size_t>(rc);
+    }
+    // Fall back to the copy below if the kernel can't copy between these files
+    if (rc == 0 || copied > 0) {
+      fseeko(fileIo->p_->fp_, srcOffset, SEEK_SET);
+      fseeko(p_->fp_, dstOffset, SEEK_SET);
+      return copied;
+    }
+  }
+#endif
+
+  std::vector<byte> buf(64 * 1024);
   size_t writeTotal = 0;
-  size_t readCount = src.read(buf, sizeof(buf));
+  size_t readCount = src.read(buf.data(), buf.size());
   while (readCount != 0) {
-    size_t writeCount = std::fwrite(buf, 1, readCount, p_->fp_);
+    size_t writeCount = std::fwrite(buf.data(), 1, readCount, p_->fp_);
     writeTotal += writeCount;
     if (writeCount != readCount) {
       // try to reset back to where write stopped
       src.seek(writeCount - readCount, BasicIo::cur);
       break;
     }
-    readCount = src.read(buf, sizeof(buf));
+    readCount = src.read(buf.data(), buf.size());
   }
 
   return writeTotal;
 }
 
+size_t FileIo::writeRange(BasicIo& src, size_t offset, size_t wcount) {
+#ifdef EXV_HAVE_COPY_FILE_RANGE
+  // Let the kernel copy the data from another file, without passing it through user space
+  auto fileIo = dynamic_cast<FileIo*>(&src);
+  if (fileIo && fileIo != this && fileIo->p_->fp_ && p_->switchMode(Impl::opWrite) == 0 &&
+      std::fflush(p_->fp_) == 0) {
+    const int srcFd = fileno(fileIo->p_->fp_);
+    const int dstFd = fileno(p_->fp_);
+    auto srcOffset = static_cast<off_t>(offset);
+    off_t dstOffset = ftello(p_->fp_);
+    size_t copied = 0;
+    ssize_t rc = -1;
+    while (copied < wcount && dstOffset >= 0 &&
+           (rc = ::copy_file_range(srcFd, &srcOffset, dstFd, &dstOffset, wcount - copied, 0)) > 0) {
+      copied += static_cast<size_t>(rc);
+    }
+    // Fall back to the copy below if the kernel can't copy between these files
+    if (copied > 0 || rc == 0) {
+      fseeko(fileIo->p_->fp_, srcOffset, SEEK_SET);
+      fseeko(p_->fp_, dstOffset, SEEK_SET);
+      return copied;
+    }
+  }
+#endif
+  return BasicIo::writeRange(src, offset, wcount);
+}
+
 void FileIo::transfer(BasicIo& src) {
   const bool wasOpen = (p_->fp_ != nullptr);
   const std::string lastMode(p_->openMode_);
@@ -415,9 +490,7 @@ void FileIo::transfer(BasicIo& src) {
         fs::remove(fileIo->path());
       }
 #else
-      if (fileExists(pf) && fs::remove(pf) != 0) {
-        throw Error(ErrorCode::kerCallFailed, pf, strError(), "fs::remove");
-      }
+      // rename replaces an existing file atomically, readers see either the old or the new file
       fs::rename(fileIo->path(), pf);
       fs::remove(fileIo->path());
 #endif
@@ -425,9 +498,11 @@ void FileIo::transfer(BasicIo& src) {
       auto newStMode = fs::status(pf).permissions();
       // Set original file permissions
       if (statOk && origStMode != newStMode) {
-        fs::permissions(pf, origStMode);
+        std::error_code ec;
+        fs::permissions(pf, origStMode, ec);
 #ifndef SUPPRESS_WARNINGS
-        EXV_WARNING << Error(ErrorCode::kerCallFailed, pf, strError(), "::chmod") << "\n";
+        if (ec)
+          EXV_WARNING << Error(ErrorCode::kerCallFailed, pf, ec.message(), "::chmod") << "\n";
 #endif
       }
     }
@@ -983,6 +1058,11 @@ class RemoteIo::Impl {
   bool eof_{false};                        //!< EOF indicator
   Protocol protocol_;                      //!< the protocol of url
   size_t totalRead_{0};                    //!< bytes requested from host
+  size_t maxReadahead_{64 * 1024};         //!< Maximum number of bytes to read ahead
+  size_t readahead_{0};                    //!< Number of blocks to read ahead on the next miss
+  size_t nextBlock_{0};                    //!< Block after the last one read
+  size_t requests_{0};                     //!< Number of requests sent to the host
+  size_t bytesFetched_{0};                 //!< Number of bytes received from the host
 
   // METHODS
   /*!
@@ -1014,47 +1094,99 @@ class RemoteIo::Impl {
   virtual void writeRemote(const byte* data, size_t size, size_t from, size_t to) = 0;
   /*!
     @brief Get the data from the remote machine and write them to the memory blocks.
+          The request for the last missing blocks reads ahead by a window which
+          doubles with each sequential miss, up to maxReadahead_, and halves
+          with each miss after a seek. A skip forward within the window counts
+          as sequential.
     @param lowBlock The start block index.
     @param highBlock The end block index.
     @return Number of bytes written to the memory block successfully
     @throw Error if it fails.
    */
   virtual size_t populateBlocks(size_t lowBlock, size_t highBlock);
+  /*!
+    @brief Find the runs of adjacent blocks in [lowBlock, highBlock] which
+          are not populated yet.
+    @return Pairs of the start and the end block index of each run.
+   */
+  [[nodiscard]] std::vector<std::pair<size_t, size_t>> missingBlocks(size_t lowBlock, size_t highBlock) const;
+  /*!
+    @brief Write the data from the server to the memory blocks, starting with
+          block \em lowBlock, and count the request.
+    @return Number of bytes written to the memory blocks
+    @throw Error if the data is empty.
+   */
+  size_t storeBlocks(size_t lowBlock, const std::string& data);
 };
 
 RemoteIo::Impl::Impl(const std::string& url, size_t blockSize) :
     path_(url), blockSize_(blockSize), protocol_(fileProtocol(url)) {
 }
 
+std::vector<std::pair<size_t, size_t>> RemoteIo::Impl::missingBlocks(size_t lowBlock, size_t highBlock) const {
+  std::vector<std::pair<size_t, size_t>> runs;
+  highBlock = std::min(highBlock, ((size_ + blockSize_ - 1) / blockSize_) - 1);
+  for (size_t block = lowBlock; block <= highBlock; ++block) {
+    if (!blocksMap_[block].isNone())
+      continue;
+    size_t last = block;
+    while (last < highBlock && blocksMap_[last + 1].isNone())
+      last++;
+    runs.emplace_back(block, last);
+    block = last;
+  }
+  return runs;
+}
+
+size_t RemoteIo::Impl::storeBlocks(size_t lowBlock, const std::string& data) {
+  size_t rcount = data.length();
+  if (rcount == 0) {
+    throw Error(ErrorCode::kerErrorMessage, "Data By Range is empty. Please check the permission.");
+  }
+  ++requests_;
+  bytesFetched_ += rcount;
+  auto source = reinterpret_cast<const byte*>(data.c_str());
+  size_t remain = rcount;
+  size_t totalRead = 0;
+  // the server may ignore the range and send the whole file
+  size_t iBlock = (rcount == size_) ? 0 : lowBlock;
+
+  while (remain) {
+    auto allow = std::min<size_t>(remain, blockSize_);
+    blocksMap_[iBlock].populate(&source[totalRead], allow);
+    remain -= allow;
+    totalRead += allow;
+    iBlock++;
+  }
+  return rcount;
+}
+
 size_t RemoteIo::Impl::populateBlocks(size_t lowBlock, size_t highBlock) {
-  // optimize: ignore all true blocks on left & right sides.
-  while (!blocksMap_[lowBlock].isNone() && lowBlock < highBlock)
-    lowBlock++;
-  while (!blocksMap_[highBlock].isNone() && highBlock > lowBlock)
-    highBlock--;
+  auto runs = missingBlocks(lowBlock, highBlock);
+  // a skip forward within the readahead is sequential, e.g., over a segment the parser ignores
+  const bool sequential = lowBlock + 1 >= nextBlock_ && lowBlock <= nextBlock_ + readahead_;
+  nextBlock_ = highBlock + 1;
+  if (runs.empty())
+    return 0;
+
+  // grow the readahead while the reads are sequential, shrink it after a seek
+  const size_t maxBlocks = maxReadahead_ / blockSize_;
+  readahead_ = sequential ? std::min(std::max<size_t>(2 * readahead_, 1), maxBlocks) : readahead_ / 2;
+  if (auto& last = runs.back().second; last == highBlock) {
+    const size_t end = std::min(highBlock + readahead_, ((size_ + blockSize_ - 1) / blockSize_) - 1);
+    while (last < end && blocksMap_[last + 1].isNone())
+      last++;
+  }
 
+  // fetch each run of adjacent missing blocks with one request
   size_t rcount = 0;
-  if (blocksMap_[highBlock].isNone()) {
+  for (const auto& [low, high] : runs) {
+    if (!blocksMap_[low].isNone())
+      continue;  // populated with the whole file by a previous request
     std::string data;
-    getDataByRange(lowBlock, highBlock, data);
-    rcount = data.length();
-    if (rcount == 0) {
-      throw Error(ErrorCode::kerErrorMessage, "Data By Range is empty. Please check the permission.");
-    }
-    auto source = reinterpret_cast<byte*>(const_cast<char*>(data.c_str()));
-    size_t remain = rcount;
-    size_t totalRead = 0;
-    size_t iBlock = (rcount == size_) ? 0 : lowBlock;
-
-    while (remain) {
-      auto allow = std::min<size_t>(remain, blockSize_);
-      blocksMap_[iBlock].populate(&source[totalRead], allow);
-      remain -= allow;
-      totalRead += allow;
-      iBlock++;
-    }
+    getDataByRange(low, high, data);
+    rcount += storeBlocks(low, data);
   }
-
   return rcount;
 }
 
@@ -1071,23 +1203,15 @@ int RemoteIo::open() {
   bigBlock_ = nullptr;
   if (!p_->blocksMap_) {
     const auto length = p_->getFileLength();
+    ++p_->requests_;
     if (length < 0) {  // unable to get the length of remote file, get the whole file content.
       std::string data;
       p_->getDataByRange(std::numeric_limits<size_t>::max(), std::numeric_limits<size_t>::max(), data);
       p_->size_ = data.length();
       size_t nBlocks = (p_->size_ + p_->blockSize_ - 1) / p_->blockSize_;
       p_->blocksMap_ = std::make_unique<BlockMap[]>(nBlocks);
-      auto source = reinterpret_cast<byte*>(const_cast<char*>(data.c_str()));
-      size_t remain = p_->size_;
-      size_t iBlock = 0;
-      size_t totalRead = 0;
-      while (remain) {
-        auto allow = std::min<size_t>(remain, p_->blockSize_);
-        p_->blocksMap_[iBlock].populate(&source[totalRead], allow);
-        remain -= allow;
-        totalRead += allow;
-        iBlock++;
-      }
+      if (!data.empty())
+        p_->storeBlocks(0, data);
     } else if (length == 0) {  // file is empty
       throw Error(ErrorCode::kerErrorMessage, "the file length is 0");
     } else {
@@ -1207,7 +1331,7 @@ size_t RemoteIo::read(byte* buf, size_t rcount) {
 
   auto allow = std::min<size_t>(rcount, (p_->size_ - p_->idx_));
   size_t lowBlock = p_->idx_ / p_->blockSize_;
-  size_t highBlock = (p_->idx_ + allow) / p_->blockSize_;
+  size_t highBlock = allow ? (p_->idx_ + allow - 1) / p_->blockSize_ : lowBlock;
 
   // connect to the remote machine & populate the blocks just in time.
   p_->populateBlocks(lowBlock, highBlock);
@@ -1260,6 +1384,11 @@ void RemoteIo::transfer(BasicIo& src) {
   src.close();
 }
 
+void RemoteIo::setReadahead(size_t maxBytes) {
+  p_->maxReadahead_ = maxBytes;
+  p_->readahead_ = std::min(p_->readahead_, maxBytes / p_->blockSize_);
+}
+
 int RemoteIo::seek(int64_t offset, Position pos) {
   int64_t newIdx = 0;
 
@@ -1316,6 +1445,14 @@ size_t RemoteIo::size() const {
   return p_->size_;
 }
 
+size_t RemoteIo::requests() const {
+  return p_->requests_;
+}
+
+size_t RemoteIo::bytesFetched() const {
+  return p_->bytesFetched_;
+}
+
 bool RemoteIo::isopen() const {
   return p_->blocksMap_ != nullptr;
 }
@@ -1378,6 +1515,9 @@ class HttpIo::HttpImpl : public Impl {
     @throw Error if it fails.
    */
   void writeRemote(const byte* data, size_t size, size_t from, size_t to) override;
+
+  // DATA
+  mutable HttpConnection connection_;  //!< Connection kept open between the requests
 };
 
 HttpIo::HttpImpl::HttpImpl(const std::string& url, size_t blockSize) : Impl(url, blockSize) {
@@ -1394,7 +1534,7 @@ int64_t HttpIo::HttpImpl::getFileLength() const {
   if (!hostInfo_.Port.empty())
     request["port"] = hostInfo_.Port;
   request["verb"] = "HEAD";
-  int serverCode = http(request, response, errors);
+  int serverCode = connection_.request(request, response, errors);
   if (serverCode < 0 || serverCode >= 400 || !errors.empty()) {
     throw Error(ErrorCode::kerFileOpenFailed, "http", serverCode, hostInfo_.Path);
   }
@@ -1413,10 +1553,10 @@ void HttpIo::HttpImpl::getDataByRange(size_t lowBlock, size_t highBlock, std::st
   request["verb"] = "GET";
   std::string errors;
   if (lowBlock != std::numeric_limits<size_t>::max() && highBlock != std::numeric_limits<size_t>::max()) {
-    request["header"] = stringFormat("Range: bytes={}-{}", lowBlock * blockSize_, (highBlock + 1) * (blockSize_ - 1));
+    request["header"] = stringFormat("Range: bytes={}-{}", lowBlock * blockSize_, ((highBlock + 1) * blockSize_) - 1);
   }
 
-  int serverCode = http(request, responseDic, errors);
+  int serverCode = connection_.request(request, responseDic, errors);
   if (serverCode < 0 || serverCode >= 400 || !errors.empty()) {
     throw Error(ErrorCode::kerFileOpenFailed, "http", serverCode, hostInfo_.Path);
   }
@@ -1679,6 +1819,46 @@ size_t writeFile(const DataBuf& buf, const std::string& path) {
 }
 #endif
 
+size_t sendRange(int fd, BasicIo& src, size_t offset, size_t count) {
+  size_t sent = 0;
+#if defined(EXV_ENABLE_FILESYSTEM) && defined(EXV_HAVE_SENDFILE)
+  // Let the kernel copy the data from a file, without passing it through user space
+  if (auto fileIo = dynamic_cast<FileIo*>(&src); fileIo && fileIo->p_->fp_) {
+    const int srcFd = fileno(fileIo->p_->fp_);
+    auto srcOffset = static_cast<off_t>(offset);
+    ssize_t rc = -1;
+    while (sent < count && (rc = ::sendfile(fd, srcFd, &srcOffset, count - sent)) > 0) {
+      sent += static_cast<size_t>(rc);
+    }
+    // Fall back to the copy below if the kernel can't copy to this file descriptor
+    if (sent > 0 || rc == 0)
+      return sent;
+  }
+#endif
+  if (src.seek(static_cast<int64_t>(offset), BasicIo::beg) != 0)
+    return 0;
+  std::vector<byte> buf(std::min<size_t>(count, 64 * 1024));
+  while (sent < count) {
+    const size_t readCount = src.read(buf.data(), std::min(buf.size(), count - sent));
+    if (readCount == 0)
+      break;
+    for (size_t done = 0; done < readCount;) {
+#ifdef _WIN32
+      const auto rc = ::_write(fd, buf.data() + done, static_cast<unsigned int>(readCount - done));
+#else
+      const auto rc = ::write(fd, buf.data() + done, readCount - done);
+#endif
+      if (rc < 0 && errno == EINTR)
+        continue;
+      if (rc <= 0)
+        return sent + done;
+      done += static_cast<size_t>(rc);
+    }
+    sent += readCount;
+  }
+  return sent;
+}
+
 #ifdef EXV_USE_CURL
 size_t curlWriter(char* data, size_t size, size_t nmemb, std::string* writerData) {
   if (!writerData)
@@ -0,0 +1,168 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// included header files
+#include "batchreader.hpp"
+
+#include "error.hpp"
+#include "futils.hpp"
+#include "types.hpp"
+#include "xmp_exiv2.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+// *****************************************************************************
+namespace {
+//! Read the file at result.path_ and move the requested metadata \em families into \em result
+void readBatchFile(Exiv2::BatchResult& result, int families) {
+  auto image = Exiv2::ImageFactory::open(result.path_);
+  // Decode only the requested families. The standard Exif IFDs are always
+  // decoded, a filter with one of them passes no other Exif, IPTC or XMP
+  // metadata.
+  Exiv2::ReadFilter filter;
+  filter.addGroup("Exif.Image");
+  if (families & Exiv2::mdExif)
+    filter.addGroup("Exif");
+  if (families & Exiv2::mdIptc)
+    filter.addGroup("Iptc");
+  if (families & Exiv2::mdXmp)
+    filter.addGroup("Xmp");
+  image->setReadFilter(filter);
+  image->readMetadata();
+  result.imageType_ = image->imageType();
+  if (families & Exiv2::mdExif)
+    result.exifData_ = std::move(image->exifData());
+  if (families & Exiv2::mdIptc)
+    result.iptcData_ = std::move(image->iptcData());
+  if (families & Exiv2::mdXmp)
+    result.xmpData_ = std::move(image->xmpData());
+  if (families & Exiv2::mdComment)
+    result.comment_ = image->comment();
+  if ((families & Exiv2::mdIccProfile) && image->iccProfileDefined()) {
+    const Exiv2::DataBuf& iccProfile = image->iccProfile();
+    result.iccProfile_ = Exiv2::DataBuf(iccProfile.c_data(), iccProfile.size());
+  }
+}
+
+/*!
+  @brief Results of the workers, waiting to be passed to the callback. The
+         queue is bounded, workers wait while it is full, so that a slow
+         callback doesn't let the results of the whole batch pile up.
+ */
+class ResultQueue {
+ public:
+  //! Constructor, \em capacity is the number of results the queue holds at most
+  explicit ResultQueue(size_t capacity) : capacity_(capacity) {
+  }
+  //! Add \em result, wait while the queue is full. Returns false if the queue was closed.
+  bool push(Exiv2::BatchResult&& result) {
+    std::unique_lock lock(mutex_);
+    notFull_.wait(lock, [this] { return closed_ || results_.size() < capacity_; });
+    if (closed_)
+      return false;
+    results_.push_back(std::move(result));
+    lock.unlock();
+    notEmpty_.notify_one();
+    return true;
+  }
+  //! Remove and return the oldest result, wait while the queue is empty
+  Exiv2::BatchResult pop() {
+    std::unique_lock lock(mutex_);
+    notEmpty_.wait(lock, [this] { return !results_.empty(); });
+    Exiv2::BatchResult result = std::move(results_.front());
+    results_.pop_front();
+    lock.unlock();
+    notFull_.notify_one();
+    return result;
+  }
+  //! Close the queue, pending and later results are discarded
+  void close() {
+    {
+      std::lock_guard lock(mutex_);
+      closed_ = true;
+      results_.clear();
+    }
+    notFull_.notify_all();
+  }
+
+ private:
+  // DATA
+  size_t capacity_;                         //!< Maximum number of results
+  bool closed_{false};                      //!< Indicates if the queue is closed
+  std::deque<Exiv2::BatchResult> results_;  //!< Results in the order of completion
+  std::mutex mutex_;                        //!< Protects the members above
+  std::condition_variable notEmpty_;        //!< Signals a new result
+  std::condition_variable notFull_;         //!< Signals space for a result or closing
+};
+}  // namespace
+
+// *****************************************************************************
+// free functions
+namespace Exiv2 {
+size_t readMetadataBatch(const std::vector<std::string>& paths, unsigned workers, int families,
+                         const BatchCallback& callback) {
+  if (paths.empty())
+    return 0;
+
+  // Initialize the global state up front, instead of letting the workers race
+  // for it. Each batch does it, as XmpParser::terminate() may have run since
+  // the last one; it is cheap if nothing has to be done.
+  XmpParser::initialize();
+  preloadConfig();
+
+  if (workers == 0)
+    workers = std::max(1U, std::thread::hardware_concurrency());
+  workers = static_cast<unsigned>(std::min<size_t>(workers, paths.size()));
+
+  std::atomic<size_t> next{0};
+  ResultQueue queue(2 * static_cast<size_t>(workers));
+  auto work = [&] {
+    for (size_t i = next++; i < paths.size(); i = next++) {
+      BatchResult result;
+      result.index_ = i;
+      result.path_ = paths[i];
+      try {
+        readBatchFile(result, families);
+      } catch (const std::exception& e) {
+        result.error_ = e.what();
+      } catch (...) {
+        result.error_ = "Unknown error";
+      }
+      if (!queue.push(std::move(result)))
+        return;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(workers);
+  auto stop = [&] {
+    queue.close();
+    next = paths.size();
+    for (auto& t : threads)
+      t.join();
+  };
+
+  size_t good = 0;
+  try {
+    for (unsigned n = 0; n < workers; ++n)
+      threads.emplace_back(work);
+    for (size_t n = 0; n < paths.size(); ++n) {
+      BatchResult result = queue.pop();
+      if (result.error_.empty())
+        ++good;
+      callback(result);
+    }
+  } catch (...) {
+    stop();
+    throw;
+  }
+  stop();
+  return good;
+}
+
+}  // namespace Exiv2
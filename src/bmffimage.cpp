@@ -535,10 +535,11 @@ uint64_t BmffImage::boxHandler(std::ostream& out /* = std::cout*/, Exiv2::PrintS
         uint32_t offset = Safe::add(arr.read_uint32(0, endian_), 4u);
         Internal::enforce(Safe::add(offset, 4u) < arr.size(), Exiv2::ErrorCode::kerCorruptedMetadata);
         Internal::TiffParserWorker::decode(exifData(), iptcData(), xmpData(), arr.c_data(offset), arr.size() - offset,
-                                           Internal::Tag::root, Internal::TiffMapping::findDecoder);
+                                           Internal::Tag::root, Internal::TiffMapping::findDecoder, nullptr,
+                                           readFilter());
       } else if (realType == TAG::xml) {
         try {
-          Exiv2::XmpParser::decode(xmpData(), std::string(arr.c_str(), arr.size()));
+          Exiv2::XmpParser::decode(xmpData(), std::string(arr.c_str(), arr.size()), readFilter());
         } catch (...) {
           throw Error(ErrorCode::kerFailedToReadImageData);
         }
@@ -600,8 +601,9 @@ void BmffImage::parseTiff(uint32_t root_tag, uint64_t length, uint64_t start) {
         punt = i;
     }
     if (punt != eof) {
-      Internal::TiffParserWorker::decode(exifData(), iptcData(), xmpData(), exif.c_data(punt), exif.size() - punt,
-                                         root_tag, Internal::TiffMapping::findDecoder);
+      auto owner = std::make_shared<const DataBuf>(std::move(exif));
+      Internal::TiffParserWorker::decode(exifData(), iptcData(), xmpData(), owner->c_data(punt), owner->size() - punt,
+                                         root_tag, Internal::TiffMapping::findDecoder, nullptr, readFilter(), owner);
     }
   }
   io_->seek(restore, BasicIo::beg);
@@ -611,16 +613,17 @@ void BmffImage::parseTiff(uint32_t root_tag, uint64_t length) {
   if (length > 8) {
     Internal::enforce(length - 8 <= io_->size() - io_->tell(), ErrorCode::kerCorruptedMetadata);
     Internal::enforce(length - 8 <= std::numeric_limits<size_t>::max(), ErrorCode::kerCorruptedMetadata);
-    DataBuf data(static_cast<size_t>(length - 8u));
-    const size_t bufRead = io_->read(data.data(), data.size());
+    auto data = std::make_shared<DataBuf>(static_cast<size_t>(length - 8u));
+    const size_t bufRead = io_->read(data->data(), data->size());
 
     if (io_->error())
       throw Error(ErrorCode::kerFailedToReadImageData);
-    if (bufRead != data.size())
+    if (bufRead != data->size())
       throw Error(ErrorCode::kerInputDataReadFailed);
 
-    Internal::TiffParserWorker::decode(exifData(), iptcData(), xmpData(), data.c_data(), data.size(), root_tag,
-                                       Internal::TiffMapping::findDecoder);
+    // The Exif data may keep the buffer, large values refer to it
+    Internal::TiffParserWorker::decode(exifData(), iptcData(), xmpData(), data->c_data(), data->size(), root_tag,
+                                       Internal::TiffMapping::findDecoder, nullptr, readFilter(), data);
   }
 }
 
@@ -639,7 +642,7 @@ void BmffImage::parseXmp(uint64_t length, uint64_t start) {
   if (io_->error())
     throw Error(ErrorCode::kerFailedToReadImageData);
   try {
-    Exiv2::XmpParser::decode(xmpData(), std::string(xmp.c_str()));
+    Exiv2::XmpParser::decode(xmpData(), std::string(xmp.c_str()), readFilter());
   } catch (...) {
     throw Error(ErrorCode::kerFailedToReadImageData);
   }
@@ -706,6 +709,7 @@ void BmffImage::readMetadata() {
   IoCloser closer(*io_);
 
   clearMetadata();
+  recordReadFilter();
   ilocs_.clear();
   visits_max_ = io_->size() / 16;
   unknownID_ = 0xffff;
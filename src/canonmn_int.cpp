@@ -19,10 +19,12 @@
 #include "value.hpp"
 
 // + standard includes
+#include <algorithm>
 #include <cmath>
 #include <regex>
 #include <sstream>
 #include <string>
+#include <vector>
 // *****************************************************************************
 // class member definitions
 namespace Exiv2::Internal {
@@ -39,6 +41,37 @@ static std::ostream& printCsLensFFFF(std::ostream& os, const Value& value, const
 
 static float string_to_float(std::string_view str);
 
+//! Lens parameters parsed from a label of the canonCsLensType table
+struct CanonLensParams {
+  int64_t val_;              //!< Lens type
+  const char* label_;        //!< Lens label
+  bool valid_{false};        //!< True if the parameters could be parsed from the label
+  int flMin_{0};             //!< Short focal length
+  int flMax_{0};             //!< Tele focal length
+  float aperMaxShort_{0.f};  //!< Max aperture at the short focal length
+  float aperMaxTele_{0.f};   //!< Max aperture at the tele focal length
+  float tc_{1.f};            //!< Teleconverter factor
+
+  //! Comparison functor to order and search lens parameters by lens type
+  struct Cmp {
+    bool operator()(const CanonLensParams& lhs, const CanonLensParams& rhs) const {
+      return lhs.val_ < rhs.val_;
+    }
+    bool operator()(const CanonLensParams& lhs, int64_t rhs) const {
+      return lhs.val_ < rhs;
+    }
+    bool operator()(int64_t lhs, const CanonLensParams& rhs) const {
+      return lhs < rhs.val_;
+    }
+  };
+};
+
+//! Parse the lens parameters of all labels of canonCsLensType, sorted by lens type
+static std::vector<CanonLensParams> parseCanonLensParams();
+
+//! Return the lens parameters of canonCsLensType, parsed on first use
+static const std::vector<CanonLensParams>& canonLensParams();
+
 //! ModelId, tag 0x0010
 constexpr TagDetails canonModelId[] = {
     {0x00000412, "EOS M50 / Kiss M"},
@@ -2896,6 +2929,52 @@ float string_to_float(std::string_view str) {
   return val;
 }
 
+std::vector<CanonLensParams> parseCanonLensParams() {
+  // regex to extract short and tele focal length, max aperture at short and tele position
+  // and the teleconverter factor from the lens label
+  std::regex const lens_regex(
+      // anything at the start
+      ".*?"
+      // maybe min focal length and hyphen, surely max focal length e.g.: 24-70mm
+      R"((?:(\d+)-)?(\d+)mm)"
+      // anything in-between
+      ".*?"
+      // maybe short focal length max aperture and hyphen, surely at least single max aperture e.g.: f/4.5-5.6
+      // short and tele indicate apertures at the short (focal_length_min) and tele (focal_length_max)
+      // position of the lens
+      R"((?:(?:f/)|T|F)(?:(\d+(?:\.\d+)?)-)?(\d+(?:\.\d)?))"
+      // check if there is a teleconverter pattern e.g. + 1.4x
+      R"((?:.*?\+.*?(\d+(?:\.\d+)?)x)?)");
+
+  std::vector<CanonLensParams> lenses;
+  lenses.reserve(std::size(canonCsLensType));
+  for (auto&& [val, label] : canonCsLensType) {
+    auto& lens = lenses.emplace_back(CanonLensParams{val, label});
+    std::cmatch base_match;
+    if (!std::regex_search(label, base_match, lens_regex)) {
+      continue;
+    }
+    lens.valid_ = true;
+    lens.tc_ = base_match[5].length() > 0 ? string_to_float(base_match[5].str()) : 1.f;
+
+    lens.flMax_ = static_cast<int>(string_to_float(base_match[2].str()) * lens.tc_);
+    lens.flMin_ =
+        base_match[1].length() > 0 ? static_cast<int>(string_to_float(base_match[1].str()) * lens.tc_) : lens.flMax_;
+
+    lens.aperMaxTele_ = string_to_float(base_match[4].str()) * lens.tc_;
+    lens.aperMaxShort_ =
+        base_match[3].length() > 0 ? string_to_float(base_match[3].str()) * lens.tc_ : lens.aperMaxTele_;
+  }
+  // keep the order of the table for lenses which share a lens type
+  std::stable_sort(lenses.begin(), lenses.end(), CanonLensParams::Cmp());
+  return lenses;
+}
+
+const std::vector<CanonLensParams>& canonLensParams() {
+  static const auto lenses = parseCanonLensParams();
+  return lenses;
+}
+
 std::ostream& printCsLensTypeByMetadata(std::ostream& os, const Value& value, const ExifData* metadata) {
   if (!metadata || value.typeId() != unsignedShort || value.count() == 0)
     return os << value;
@@ -2928,57 +3007,31 @@ std::ostream& printCsLensTypeByMetadata(std::ostream& os, const Value& value, co
 
   auto exifAperMax = fnumber(canonEv(static_cast<int16_t>(pos->value().toInt64(0))));
 
-  // regex to extract short and tele focal length, max aperture at short and tele position
-  // and the teleconverter factor from the lens label
-  std::regex const lens_regex(
-      // anything at the start
-      ".*?"
-      // maybe min focal length and hyphen, surely max focal length e.g.: 24-70mm
-      R"((?:(\d+)-)?(\d+)mm)"
-      // anything in-between
-      ".*?"
-      // maybe short focal length max aperture and hyphen, surely at least single max aperture e.g.: f/4.5-5.6
-      // short and tele indicate apertures at the short (focal_length_min) and tele (focal_length_max)
-      // position of the lens
-      R"((?:(?:f/)|T|F)(?:(\d+(?:\.\d+)?)-)?(\d+(?:\.\d)?))"
-      // check if there is a teleconverter pattern e.g. + 1.4x
-      R"((?:.*?\+.*?(\d+(?:\.\d+)?)x)?)");
-
   bool unmatched = true;
-  // we loop over all our lenses to print out all matching lenses
+  // we loop over all lenses with this lens type to print out all matching lenses
   // if we have multiple possibilities, they are concatenated by "*OR*"
-  for (auto&& [val, label] : canonCsLensType) {
-    if (val != lensType) {
-      continue;
-    }
-
-    std::cmatch base_match;
-    if (!std::regex_search(label, base_match, lens_regex)) {
+  const auto& lenses = canonLensParams();
+  auto [first, last] = std::equal_range(lenses.begin(), lenses.end(), lensType, CanonLensParams::Cmp());
+  for (auto lens = first; lens != last; ++lens) {
+    if (!lens->valid_) {
       // this should never happen, as it would indicate the lens is specified incorrectly
       // in the CanonCsLensType array
-      throw Error(ErrorCode::kerErrorMessage, "Lens regex didn't match for: ", label);
+      throw Error(ErrorCode::kerErrorMessage, "Lens regex didn't match for: ", lens->label_);
     }
 
-    auto tc = base_match[5].length() > 0 ? string_to_float(base_match[5].str()) : 1.f;
-
-    auto flMax = static_cast<int>(string_to_float(base_match[2].str()) * tc);
-    int flMin = base_match[1].length() > 0 ? static_cast<int>(string_to_float(base_match[1].str()) * tc) : flMax;
-
-    auto aperMaxTele = string_to_float(base_match[4].str()) * tc;
-    auto aperMaxShort = base_match[3].length() > 0 ? string_to_float(base_match[3].str()) * tc : aperMaxTele;
-
-    if (flMin != exifFlMin || flMax != exifFlMax || exifAperMax < (aperMaxShort - (.1 * tc)) ||
-        exifAperMax > (aperMaxTele + (.1 * tc))) {
+    if (lens->flMin_ != exifFlMin || lens->flMax_ != exifFlMax ||
+        exifAperMax < (lens->aperMaxShort_ - (.1 * lens->tc_)) ||
+        exifAperMax > (lens->aperMaxTele_ + (.1 * lens->tc_))) {
       continue;
     }
 
     if (unmatched) {
       unmatched = false;
-      os << label;
+      os << lens->label_;
       continue;
     }
 
-    os << " *OR* " << label;
+    os << " *OR* " << lens->label_;
   }
 
   // if the entire for loop left us with unmatched==false
@@ -2997,8 +3050,8 @@ std::ostream& CanonMakerNote::printCsLensType(std::ostream& os, const Value& val
   // #1034
   const std::string undefined("undefined");
   const std::string section("canon");
-  if (Internal::readExiv2Config(section, value.toString(), undefined) != undefined) {
-    return os << Internal::readExiv2Config(section, value.toString(), undefined);
+  if (auto label = Internal::readExiv2Config(section, value.toString(), undefined); label != undefined) {
+    return os << label;
   }
 
   // try our best to determine the lens based on metadata
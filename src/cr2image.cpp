@@ -69,11 +69,27 @@ void Cr2Image::readMetadata() {
     throw Error(ErrorCode::kerNotAnImage, "CR2");
   }
   clearMetadata();
-  ByteOrder bo = Cr2Parser::decode(exifData_, iptcData_, xmpData_, io_->mmap(), io_->size());
+  recordReadFilter();
+  ByteOrder bo = Cr2Parser::decode(exifData_, iptcData_, xmpData_, io_->mmap(), io_->size(), readFilter());
   setByteOrder(bo);
 }  // Cr2Image::readMetadata
 
+void Cr2Image::scanExif(ExifScan& scan) {
+  if (io_->open() != 0) {
+    throw Error(ErrorCode::kerDataSourceOpenFailed, io_->path(), strError());
+  }
+  IoCloser closer(*io_);
+  // Ensure that this is the correct image type
+  if (!isCr2Type(*io_, false)) {
+    if (io_->error() || io_->eof())
+      throw Error(ErrorCode::kerFailedToReadImageData);
+    throw Error(ErrorCode::kerNotAnImage, "CR2");
+  }
+  Cr2Parser::scan(scan, io_->mmap(), io_->size());
+}
+
 void Cr2Image::writeMetadata() {
+  enforceCompleteMetadata();
 #ifdef EXIV2_DEBUG_MESSAGES
   std::cerr << "Writing CR2 file " << io_->path() << "\n";
 #endif
@@ -97,10 +113,16 @@ void Cr2Image::writeMetadata() {
   Cr2Parser::encode(*io_, pData, size, bo, exifData_, iptcData_, xmpData_);  // may throw
 }  // Cr2Image::writeMetadata
 
-ByteOrder Cr2Parser::decode(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, const byte* pData, size_t size) {
+ByteOrder Cr2Parser::decode(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, const byte* pData, size_t size,
+                            const ReadFilter& filter) {
   Internal::Cr2Header cr2Header;
   return Internal::TiffParserWorker::decode(exifData, iptcData, xmpData, pData, size, Internal::Tag::root,
-                                            Internal::TiffMapping::findDecoder, &cr2Header);
+                                            Internal::TiffMapping::findDecoder, &cr2Header, filter);
+}
+
+ByteOrder Cr2Parser::scan(ExifScan& scan, const byte* pData, size_t size) {
+  Internal::Cr2Header cr2Header;
+  return Internal::TiffParserWorker::scan(scan, pData, size, &cr2Header);
 }
 
 WriteMethod Cr2Parser::encode(BasicIo& io, const byte* pData, size_t size, ByteOrder byteOrder, ExifData& exifData,
@@ -1069,11 +1069,12 @@ void EpsImage::readMetadata() {
   EXV_DEBUG << "Exiv2::EpsImage::readMetadata: Reading EPS file " << io_->path() << "\n";
 #endif
 
+  recordReadFilter();
   // read metadata
   readWriteEpsMetadata(*io_, xmpPacket_, nativePreviews_, /* write = */ false);
 
   // decode XMP metadata
-  if (!xmpPacket_.empty() && XmpParser::decode(xmpData_, xmpPacket_) > 1) {
+  if (!xmpPacket_.empty() && XmpParser::decode(xmpData_, xmpPacket_, readFilter()) > 1) {
 #ifndef SUPPRESS_WARNINGS
     EXV_WARNING << "Failed to decode XMP metadata.\n";
 #endif
@@ -1086,6 +1087,7 @@ void EpsImage::readMetadata() {
 }
 
 void EpsImage::writeMetadata() {
+  enforceCompleteMetadata();
 #ifdef DEBUG
   EXV_DEBUG << "Exiv2::EpsImage::writeMetadata: Writing EPS file " << io_->path() << "\n";
 #endif
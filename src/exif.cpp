@@ -27,6 +27,7 @@
 #include <algorithm>
 #include <array>
 #include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <utility>
 
@@ -36,20 +37,58 @@ namespace {
 class FindExifdatumByKey {
  public:
   //! Constructor, initializes the object with the key to look for
-  explicit FindExifdatumByKey(std::string key) : key_(std::move(key)) {
+  explicit FindExifdatumByKey(const Exiv2::ExifKey& key) : ifdId_(key.ifdId()), tag_(key.tag()) {
   }
   /*!
     @brief Returns true if the key of \em exifdatum is equal
-           to that of the object.
+           to that of the object. The group and tag identify the key,
+           so the key strings are not compared.
   */
   bool operator()(const Exiv2::Exifdatum& exifdatum) const {
-    return key_ == exifdatum.key();
+    return ifdId_ == exifdatum.ifdId() && tag_ == exifdatum.tag();
   }
 
  private:
-  std::string key_;
+  Exiv2::IfdId ifdId_;
+  uint16_t tag_;
 };  // class FindExifdatumByKey
 
+//! Return the tag name part of the key of \em md, without a copy for known tags
+std::string_view keyTagName(const Exiv2::Exifdatum& md, std::string& hexName) {
+  auto ti = Exiv2::Internal::tagInfo(md.tag(), md.ifdId());
+  if (ti && ti->tag_ != 0xffff)
+    return ti->name_;
+  hexName = md.tagName();  // 0xabcd, fits the small string buffer
+  return hexName;
+}
+
+/*!
+  @brief Compare two Exifdatums by key, with the same order as comparing the
+         key strings. Group and tag names are read from the static tables
+         instead of building the key strings.
+ */
+bool cmpExifdatumByKey(const Exiv2::Exifdatum& lhs, const Exiv2::Exifdatum& rhs) {
+  if (lhs.ifdId() != rhs.ifdId()) {
+    // Group names are letters and digits, which sort after the '.' separator
+    return std::strcmp(Exiv2::Internal::groupName(lhs.ifdId()), Exiv2::Internal::groupName(rhs.ifdId())) < 0;
+  }
+  if (lhs.tag() == rhs.tag())
+    return false;
+  std::string lhsHex;
+  std::string rhsHex;
+  return keyTagName(lhs, lhsHex) < keyTagName(rhs, rhsHex);
+}
+
+//! Return the key of the ExifData index for an IFD id and tag
+uint64_t indexKey(Exiv2::IfdId ifdId, uint16_t tag) {
+  return (static_cast<uint64_t>(ifdId) << 16) | tag;
+}
+
+//! Return true if \em key is in one of the groups decoded from the makernote
+bool isMakernoteKey(const Exiv2::ExifKey& key) {
+  return Exiv2::Internal::isMakerIfd(key.ifdId()) || key.ifdId() == Exiv2::IfdId::mnId;
+}
+
 /*!
   @brief Exif %Thumbnail image. This abstract base class provides the
          interface for the thumbnail image that is optionally embedded in
@@ -151,14 +190,12 @@ Exiv2::Exifdatum& setValue(Exiv2::Exifdatum& exifDatum, const T& value) {
   return exifDatum;
 }
 
-Exifdatum::Exifdatum(const ExifKey& key, const Value* pValue) : key_(key.clone()) {
+Exifdatum::Exifdatum(const ExifKey& key, const Value* pValue) : key_(key) {
   if (pValue)
     value_ = pValue->clone();
 }
 
-Exifdatum::Exifdatum(const Exifdatum& rhs) {
-  if (rhs.key_)
-    key_ = rhs.key_->clone();  // deep copy
+Exifdatum::Exifdatum(const Exifdatum& rhs) : key_(rhs.key_) {
   if (rhs.value_)
     value_ = rhs.value_->clone();  // deep copy
 }
@@ -205,9 +242,9 @@ Exifdatum& Exifdatum::operator=(const Exifdatum& rhs) {
   if (this == &rhs)
     return *this;
 
-  key_.reset();
-  if (rhs.key_)
-    key_ = rhs.key_->clone();  // deep copy
+  if (owner_ && (key_.ifdId() != rhs.key_.ifdId() || key_.tag() != rhs.key_.tag()))
+    owner_->indexStale_ = true;
+  key_ = rhs.key_;
 
   value_.reset();
   if (rhs.value_)
@@ -258,7 +295,7 @@ void Exifdatum::setValue(const Value* pValue) {
 
 int Exifdatum::setValue(const std::string& value) {
   if (!value_) {
-    TypeId type = key_->defaultTypeId();
+    TypeId type = key_.defaultTypeId();
     value_ = Value::create(type);
   }
   return value_->read(value);
@@ -269,43 +306,43 @@ int Exifdatum::setDataArea(const byte* buf, size_t len) const {
 }
 
 std::string Exifdatum::key() const {
-  return key_ ? key_->key() : "";
+  return key_.key();
 }
 
 const char* Exifdatum::familyName() const {
-  return key_ ? key_->familyName() : "";
+  return key_.familyName();
 }
 
 std::string Exifdatum::groupName() const {
-  return key_ ? key_->groupName() : "";
+  return key_.groupName();
 }
 
 std::string Exifdatum::tagName() const {
-  return key_ ? key_->tagName() : "";
+  return key_.tagName();
 }
 
 std::string Exifdatum::tagLabel() const {
-  return key_ ? key_->tagLabel() : "";
+  return key_.tagLabel();
 }
 
 std::string Exifdatum::tagDesc() const {
-  return key_ ? key_->tagDesc() : "";
+  return key_.tagDesc();
 }
 
 uint16_t Exifdatum::tag() const {
-  return key_ ? key_->tag() : 0xffff;
+  return key_.tag();
 }
 
 IfdId Exifdatum::ifdId() const {
-  return key_ ? key_->ifdId() : IfdId::ifdIdNotSet;
+  return key_.ifdId();
 }
 
 const char* Exifdatum::ifdName() const {
-  return key_ ? Internal::ifdName(key_->ifdId()) : "";
+  return Internal::ifdName(key_.ifdId());
 }
 
 int Exifdatum::idx() const {
-  return key_ ? key_->idx() : 0;
+  return key_.idx();
 }
 
 size_t Exifdatum::copy(byte* buf, ByteOrder byteOrder) const {
@@ -439,11 +476,46 @@ void ExifThumb::erase() {
   eraseIfd(exifData_, IfdId::ifd1Id);
 }
 
+ExifData::ExifData(const ExifData& rhs) : exifMetadata_(rhs.exifMetadata_) {
+  if (rhs.makernote_) {
+    const auto n = std::distance(rhs.exifMetadata_.cbegin(), ExifMetadata::const_iterator(rhs.makernote_->pos_));
+    makernote_ = DeferredMakernote{std::next(exifMetadata_.begin(), n), rhs.makernote_->decode_};
+  }
+  rebuildIndex();
+}
+
+ExifData::ExifData(ExifData&& rhs) noexcept :
+    exifMetadata_(std::move(rhs.exifMetadata_)),
+    index_(std::move(rhs.index_)),
+    indexStale_(rhs.indexStale_),
+    makernote_(std::exchange(rhs.makernote_, std::nullopt)) {
+  for (auto& md : exifMetadata_)
+    md.owner_ = this;
+}
+
+ExifData& ExifData::operator=(const ExifData& rhs) {
+  if (this == &rhs)
+    return *this;
+  return *this = ExifData(rhs);
+}
+
+ExifData& ExifData::operator=(ExifData&& rhs) noexcept {
+  exifMetadata_ = std::move(rhs.exifMetadata_);
+  index_ = std::move(rhs.index_);
+  indexStale_ = rhs.indexStale_;
+  makernote_ = std::exchange(rhs.makernote_, std::nullopt);
+  for (auto& md : exifMetadata_)
+    md.owner_ = this;
+  return *this;
+}
+
 Exifdatum& ExifData::operator[](const std::string& key) {
   ExifKey exifKey(key);
   auto pos = findKey(exifKey);
   if (pos == end()) {
-    return exifMetadata_.emplace_back(exifKey);
+    exifMetadata_.emplace_back(exifKey);
+    indexAdd(std::prev(exifMetadata_.end()));
+    return exifMetadata_.back();
   }
   return *pos;
 }
@@ -455,40 +527,175 @@ void ExifData::add(const ExifKey& key, const Value* pValue) {
 void ExifData::add(const Exifdatum& exifdatum) {
   // allow duplicates
   exifMetadata_.push_back(exifdatum);
+  indexAdd(std::prev(exifMetadata_.end()));
 }
 
 ExifData::const_iterator ExifData::findKey(const ExifKey& key) const {
-  return std::find_if(exifMetadata_.begin(), exifMetadata_.end(), FindExifdatumByKey(key.key()));
+  if (makernote_ && isMakernoteKey(key))
+    const_cast<ExifData*>(this)->decodeMakernote();
+  bool stale = false;
+  auto entry = indexFind(key, stale);
+  if (stale) {
+    // Can't repair the index here, fall back to a linear search
+    return std::find_if(exifMetadata_.begin(), exifMetadata_.end(), FindExifdatumByKey(key));
+  }
+  if (!entry)
+    return exifMetadata_.end();
+  return entry->first_;
 }
 
 ExifData::iterator ExifData::findKey(const ExifKey& key) {
-  return std::find_if(exifMetadata_.begin(), exifMetadata_.end(), FindExifdatumByKey(key.key()));
+  if (makernote_ && isMakernoteKey(key))
+    decodeMakernote();
+  bool stale = false;
+  auto entry = indexFind(key, stale);
+  if (stale) {
+    rebuildIndex();
+    entry = indexFind(key, stale);
+  }
+  if (!entry)
+    return exifMetadata_.end();
+  return entry->first_;
 }
 
 void ExifData::clear() {
   exifMetadata_.clear();
+  index_.clear();
+  indexStale_ = false;
+  makernote_.reset();
 }
 
 void ExifData::sortByKey() {
-  exifMetadata_.sort(cmpMetadataByKey);
+  if (makernote_)
+    decodeMakernote();
+  exifMetadata_.sort(cmpExifdatumByKey);
+  rebuildIndex();
 }
 
 void ExifData::sortByTag() {
+  if (makernote_)
+    decodeMakernote();
   exifMetadata_.sort(cmpMetadataByTag);
+  rebuildIndex();
 }
 
 ExifData::iterator ExifData::erase(ExifData::iterator beg, ExifData::iterator end) {
-  return exifMetadata_.erase(beg, end);
+  // The makernote is erased with its tag if that is in the range
+  if (makernote_)
+    decodeMakernote();
+  // The range may be the tail left behind by std::remove_if, whose elements
+  // have been overwritten, hence the index can't be updated incrementally
+  auto pos = exifMetadata_.erase(beg, end);
+  rebuildIndex();
+  return pos;
 }
 
 ExifData::iterator ExifData::erase(ExifData::iterator pos) {
+  if (makernote_ && makernote_->pos_ == pos)
+    decodeMakernote();
+  indexErase(pos);
   return exifMetadata_.erase(pos);
 }
 
-ByteOrder ExifParser::decode(ExifData& exifData, const byte* pData, size_t size) {
-  IptcData iptcData;
-  XmpData xmpData;
-  ByteOrder bo = TiffParser::decode(exifData, iptcData, xmpData, pData, size);
+void ExifData::indexAdd(iterator pos) {
+  pos->owner_ = this;
+  auto [entry, inserted] = index_.try_emplace(indexKey(pos->ifdId(), pos->tag()), IndexEntry{pos, 1});
+  if (!inserted)
+    ++entry->second.count_;
+}
+
+void ExifData::indexErase(iterator pos) {
+  const auto k = indexKey(pos->ifdId(), pos->tag());
+  auto entry = index_.find(k);
+  if (entry == index_.end())
+    return;
+  if (--entry->second.count_ == 0) {
+    index_.erase(entry);
+    return;
+  }
+  if (entry->second.first_ != pos)
+    return;
+  // Find the next Exifdatum with the same key
+  auto next = std::find_if(std::next(pos), exifMetadata_.end(),
+                           [k](const Exifdatum& md) { return indexKey(md.ifdId(), md.tag()) == k; });
+  if (next == exifMetadata_.end()) {
+    index_.erase(entry);
+  } else {
+    entry->second.first_ = next;
+  }
+}
+
+void ExifData::decodeMakernote() {
+  auto makernote = std::move(*makernote_);
+  makernote_.reset();
+  try {
+    auto metadata = makernote.decode_();
+    exifMetadata_.splice(std::next(makernote.pos_), metadata);
+  } catch (const Error& e) {
+#ifndef SUPPRESS_WARNINGS
+    EXV_WARNING << "Failed to decode the makernote: " << e.what() << "\n";
+#endif
+  }
+  rebuildIndex();
+}
+
+void ExifData::rebuildIndex() {
+  indexStale_ = false;
+  index_.clear();
+  index_.reserve(exifMetadata_.size());
+  for (auto pos = exifMetadata_.begin(); pos != exifMetadata_.end(); ++pos) {
+    indexAdd(pos);
+  }
+}
+
+const ExifData::IndexEntry* ExifData::indexFind(const ExifKey& key, bool& stale) const {
+  // Entries may have been overwritten through an iterator, with another key
+  stale = indexStale_;
+  if (stale)
+    return nullptr;
+  auto entry = index_.find(indexKey(key.ifdId(), key.tag()));
+  return entry != index_.end() ? &entry->second : nullptr;
+}
+
+void ExifScan::addKey(const std::string& key) {
+  ExifKey exifKey(key);
+  if (exifKey.ifdId() != IfdId::ifd0Id && exifKey.ifdId() != IfdId::exifId && exifKey.ifdId() != IfdId::gpsId)
+    throw Error(ErrorCode::kerInvalidKey, key);
+  entries_.push_back({exifKey.key(), exifKey.ifdId(), exifKey.tag(), nullptr});
+}
+
+void ExifScan::clear() {
+  for (auto& entry : entries_)
+    entry.value_.reset();
+}
+
+void ExifScan::setValues(const ExifData& exifData) {
+  for (auto& entry : entries_) {
+    auto pos = exifData.findKey(ExifKey(entry.key_));
+    entry.value_ = pos == exifData.end() ? nullptr : pos->getValue();
+  }
+}
+
+std::vector<std::string> ExifScan::keys() const {
+  std::vector<std::string> keys;
+  keys.reserve(entries_.size());
+  for (const auto& entry : entries_)
+    keys.push_back(entry.key_);
+  return keys;
+}
+
+const Value* ExifScan::value(std::string_view key) const {
+  auto entry = std::find_if(entries_.begin(), entries_.end(), [key](const Entry& e) { return e.key_ == key; });
+  return entry == entries_.end() ? nullptr : entry->value_.get();
+}
+
+ByteOrder ExifParser::scan(ExifScan& scan, const byte* pData, size_t size) {
+  return TiffParser::scan(scan, pData, size);
+}
+
+namespace {
+//! Warn about IPTC and XMP data decoded along with Exif data, which ExifParser drops
+void warnIgnored([[maybe_unused]] const IptcData& iptcData, [[maybe_unused]] const XmpData& xmpData) {
 #ifndef SUPPRESS_WARNINGS
   if (!iptcData.empty()) {
     EXV_WARNING << "Ignoring IPTC information encoded in the Exif data.\n";
@@ -497,6 +704,23 @@ ByteOrder ExifParser::decode(ExifData& exifData, const byte* pData, size_t size)
     EXV_WARNING << "Ignoring XMP information encoded in the Exif data.\n";
   }
 #endif
+}
+}  // namespace
+
+ByteOrder ExifParser::decode(ExifData& exifData, const byte* pData, size_t size, const ReadFilter& filter) {
+  IptcData iptcData;
+  XmpData xmpData;
+  ByteOrder bo = TiffParser::decode(exifData, iptcData, xmpData, pData, size, filter);
+  warnIgnored(iptcData, xmpData);
+  return bo;
+}
+
+ByteOrder ExifParser::decode(ExifData& exifData, const std::shared_ptr<const DataBuf>& buf, size_t offset,
+                             const ReadFilter& filter) {
+  IptcData iptcData;
+  XmpData xmpData;
+  ByteOrder bo = TiffParser::decode(exifData, iptcData, xmpData, buf, offset, filter);
+  warnIgnored(iptcData, xmpData);
   return bo;
 }
 
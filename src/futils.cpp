@@ -6,6 +6,7 @@
 #include "config.h"
 #include "enforce.hpp"
 #include "image_int.hpp"
+#include "makernote_int.hpp"
 
 // + standard includes
 #include <algorithm>
@@ -400,4 +401,12 @@ std::string getProcessPath() {
   return "unknown";
 #endif
 }
+
+bool preloadConfig() {
+  return Internal::refreshExiv2Config();
+}
+
+void invalidateConfig() {
+  Internal::invalidateExiv2Config();
+}
 }  // namespace Exiv2
@@ -4,6 +4,7 @@
 
 #include "futils.hpp"
 #include "http.hpp"
+#include "utils.hpp"
 
 #include <array>
 #include <cerrno>
@@ -23,9 +24,13 @@
 #include <fcntl.h>
 #include <netdb.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <sys/socket.h>
+#include <sys/time.h>
 #include <unistd.h>
 
+using SOCKET = int;
+
 #define INVALID_SOCKET (-1)
 #define SOCKET_ERROR (-1)
 #define WSAEWOULDBLOCK EINPROGRESS
@@ -34,7 +39,16 @@
 static int WSAGetLastError() {
   return errno;
 }
+
+// A send on a connection which the server has closed fails with EPIPE instead
+// of raising SIGPIPE. Where there is no such flag, the socket has SO_NOSIGPIPE.
+#ifdef MSG_NOSIGNAL
+static constexpr int sendFlags = MSG_NOSIGNAL;
+#else
+static constexpr int sendFlags = 0;
+#endif
 #else
+static constexpr int sendFlags = 0;
 #include <winsock2.h>
 #include <ws2tcpip.h>
 #endif
@@ -112,6 +126,46 @@ static Exiv2::Dictionary stringToDict(const std::string& s) {
   return result;
 }
 
+//! Server and port to connect to and page to request, for a request of a page on a server
+struct Route {
+  std::string server_;  //!< Server to connect to, the proxy if one is used
+  std::string port_;    //!< Port to connect to
+  std::string page_;    //!< Page to request, the full URL if a proxy is used
+};
+
+//! Return the route of a request for \em page on \em server, using the proxy from the environment if there is one
+static Route route(const std::string& server, const std::string& port, const std::string& page) {
+  // parse and change server if using a proxy
+  const char* PROXI = "HTTP_PROXY";
+  const char* proxi = "http_proxy";
+  const char* PROXY = getenv(PROXI);
+  const char* proxy = getenv(proxi);
+  bool bProx = PROXY || proxy;
+  const char* prox = bProx ? (proxy ? proxy : PROXY) : "";
+
+  // find the dictionary of no_proxy servers
+  const char* NO_PROXI = "NO_PROXY";
+  const char* no_proxi = "no_proxy";
+  const char* NO_PROXY = getenv(NO_PROXI);
+  const char* no_proxy = getenv(no_proxi);
+  bool bNoProxy = NO_PROXY || no_proxy;
+  auto no_prox = std::string(bNoProxy ? (no_proxy ? no_proxy : NO_PROXY) : "");
+  Exiv2::Dictionary noProxy = stringToDict(no_prox + ",localhost,127.0.0.1");
+
+  // if the server is on the no_proxy list ... ignore the proxy!
+  if (noProxy.contains(server))
+    bProx = false;
+
+  Route result{server, port, page};
+  if (bProx) {
+    Exiv2::Uri Proxy = Exiv2::Uri::Parse(prox);
+    result = {Proxy.Host, Proxy.Port, "http://" + server + page};
+  }
+  if (result.port_.empty())
+    result.port_ = "80";
+  return result;
+}
+
 static int makeNonBlocking(auto sockfd) {
 #if defined(_WIN32)
   ULONG ioctl_opt = 1;
@@ -147,41 +201,13 @@ int Exiv2::http(Exiv2::Dictionary& request, Exiv2::Dictionary& response, std::st
   const char* version = request["version"].c_str();
   const char* port = request["port"].c_str();
 
-  const char* servername_p = servername;
-  const char* port_p = port;
-  std::string url = std::string("http://") + request["server"] + request["page"];
-
-  // parse and change server if using a proxy
-  const char* PROXI = "HTTP_PROXY";
-  const char* proxi = "http_proxy";
-  const char* PROXY = getenv(PROXI);
-  const char* proxy = getenv(proxi);
-  bool bProx = PROXY || proxy;
-  const char* prox = bProx ? (proxy ? proxy : PROXY) : "";
-  Exiv2::Uri Proxy = Exiv2::Uri::Parse(prox);
-
-  // find the dictionary of no_proxy servers
-  const char* NO_PROXI = "NO_PROXY";
-  const char* no_proxi = "no_proxy";
-  const char* NO_PROXY = getenv(NO_PROXI);
-  const char* no_proxy = getenv(no_proxi);
-  bool bNoProxy = NO_PROXY || no_proxy;
-  auto no_prox = std::string(bNoProxy ? (no_proxy ? no_proxy : NO_PROXY) : "");
-  Exiv2::Dictionary noProxy = stringToDict(no_prox + ",localhost,127.0.0.1");
-
-  // if the server is on the no_proxy list ... ignore the proxy!
-  if (noProxy.contains(servername))
-    bProx = false;
-
-  if (bProx) {
-    servername_p = Proxy.Host.c_str();
-    port_p = Proxy.Port.c_str();
-    page = url.c_str();
-  }
+  // change server if using a proxy
+  const Route target = route(request["server"], request["port"], request["page"]);
+  const char* servername_p = target.server_.c_str();
+  const char* port_p = target.port_.c_str();
+  page = target.page_.c_str();
   if (!port[0])
     port = "80";
-  if (!port_p[0])
-    port_p = "80";
 
   ////////////////////////////////////
   // open the socket
@@ -357,4 +383,300 @@ int Exiv2::http(Exiv2::Dictionary& request, Exiv2::Dictionary& response, std::st
   return result;
 }
 
+////////////////////////////////////////
+// persistent connections
+
+//! Internal Pimpl structure of class HttpConnection.
+struct Exiv2::HttpConnection::Impl {
+  //! Send and receive timeout of the socket
+  static constexpr int timeoutSeconds = 30;
+
+  //! Connect to \em server at \em port, return false and set \em errors if that fails
+  bool connect(const std::string& server, const std::string& port, std::string& errors);
+  //! Close the socket
+  void disconnect();
+  //! Send \em data, return false if that fails
+  [[nodiscard]] bool send(const std::string& data) const;
+  //! Receive more data into in_, return false if the server closed the connection or on error
+  bool receive();
+  //! Read a line without the line break from the received data, return false at the end of the data
+  bool readLine(std::string& line);
+  //! Read \em count bytes from the received data and append them to \em out
+  bool readBytes(size_t count, std::string& out);
+  //! Read the body until the server closes the connection and append it to \em out
+  void readAll(std::string& out);
+  /*!
+    @brief Read the response to a request, fill \em response with the
+           headers and the body.
+    @return The status code of the response, or -1 if no complete response was received.
+   */
+  int readResponse(bool isHead, Exiv2::Dictionary& response, bool& keepAlive);
+
+  // DATA
+  SOCKET sockfd_{INVALID_SOCKET};  //!< Socket of the connection
+  std::string peer_;               //!< Server and port the socket is connected to
+  std::string in_;                 //!< Data received and not yet read
+  size_t pos_{0};                  //!< Read position in in_
+  size_t connects_{0};             //!< Number of connections opened
+  size_t requests_{0};             //!< Number of requests sent
+};
+
+bool Exiv2::HttpConnection::Impl::connect(const std::string& server, const std::string& port, std::string& errors) {
+#if defined(_WIN32)
+  WSADATA wsaData;
+  if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+    error(errors, "could not start WinSock");
+    return false;
+  }
+#endif
+  addrinfo hints = {};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo* addresses = nullptr;
+  if (int res = getaddrinfo(server.c_str(), port.c_str(), &hints, &addresses); res != 0) {
+    error(errors, "no such host: %s", gai_strerror(res));
+    return false;
+  }
+  for (auto address = addresses; address && sockfd_ == INVALID_SOCKET; address = address->ai_next) {
+    sockfd_ = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+    if (sockfd_ == INVALID_SOCKET)
+      continue;
+    if (::connect(sockfd_, address->ai_addr, static_cast<int>(address->ai_addrlen)) == SOCKET_ERROR) {
+      closesocket(sockfd_);
+      sockfd_ = INVALID_SOCKET;
+    }
+  }
+  freeaddrinfo(addresses);
+  if (sockfd_ == INVALID_SOCKET) {
+    error(errors, "error - unable to connect to server = %s port = %s wsa_error = %d", server.c_str(), port.c_str(),
+          WSAGetLastError());
+    return false;
+  }
+
+  // Requests are small and answered one by one, don't let them wait for more data to send
+  int noDelay = 1;
+  setsockopt(sockfd_, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+#ifdef SO_NOSIGPIPE
+  int noSigPipe = 1;
+  setsockopt(sockfd_, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+#if defined(_WIN32)
+  DWORD timeout = timeoutSeconds * 1000;
+#else
+  timeval timeout = {timeoutSeconds, 0};
+#endif
+  setsockopt(sockfd_, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+  setsockopt(sockfd_, SOL_SOCKET, SO_SNDTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+
+  peer_ = server + ':' + port;
+  in_.clear();
+  pos_ = 0;
+  ++connects_;
+  return true;
+}
+
+void Exiv2::HttpConnection::Impl::disconnect() {
+  if (sockfd_ != INVALID_SOCKET)
+    closesocket(sockfd_);
+  sockfd_ = INVALID_SOCKET;
+  peer_.clear();
+}
+
+bool Exiv2::HttpConnection::Impl::send(const std::string& data) const {
+  for (size_t sent = 0; sent < data.size();) {
+    auto n = ::send(sockfd_, data.data() + sent, static_cast<int>(data.size() - sent), sendFlags);
+    if (n == SOCKET_ERROR || n == 0)
+      return false;
+    sent += n;
+  }
+  return true;
+}
+
+bool Exiv2::HttpConnection::Impl::receive() {
+  if (pos_ > 0) {
+    in_.erase(0, pos_);
+    pos_ = 0;
+  }
+  char buffer[32 * 1024];
+  auto n = recv(sockfd_, buffer, static_cast<int>(sizeof(buffer)), 0);
+  if (n == SOCKET_ERROR || n == 0)
+    return false;
+  in_.append(buffer, n);
+  return true;
+}
+
+bool Exiv2::HttpConnection::Impl::readLine(std::string& line) {
+  auto eol = in_.find('\n', pos_);
+  while (eol == std::string::npos) {
+    const size_t searched = in_.size() - pos_;
+    if (!receive())
+      return false;
+    eol = in_.find('\n', pos_ + searched);
+  }
+  line = in_.substr(pos_, eol - pos_);
+  if (!line.empty() && line.back() == '\r')
+    line.pop_back();
+  pos_ = eol + 1;
+  return true;
+}
+
+bool Exiv2::HttpConnection::Impl::readBytes(size_t count, std::string& out) {
+  while (in_.size() - pos_ < count) {
+    if (!receive())
+      return false;
+  }
+  out.append(in_, pos_, count);
+  pos_ += count;
+  return true;
+}
+
+void Exiv2::HttpConnection::Impl::readAll(std::string& out) {
+  do {
+    out.append(in_, pos_);
+    pos_ = in_.size();
+  } while (receive());
+}
+
+int Exiv2::HttpConnection::Impl::readResponse(bool isHead, Exiv2::Dictionary& response, bool& keepAlive) {
+  // status line, e.g. "HTTP/1.1 206 Partial Content"
+  std::string line;
+  if (!readLine(line))
+    return -1;
+  const auto firstSpace = line.find(' ');
+  if (line.compare(0, 5, "HTTP/") != 0 || firstSpace == std::string::npos)
+    return -1;
+  const int status = std::atoi(line.c_str() + firstSpace + 1);
+  keepAlive = line.compare(0, firstSpace, "HTTP/1.0") != 0;
+  response[""] = line;
+
+  // headers
+  bool chunked = false;
+  size_t contentLength = std::string::npos;
+  while (true) {
+    if (!readLine(line))
+      return -1;
+    if (line.empty())
+      break;
+    const auto colon = line.find(':');
+    if (colon == std::string::npos)
+      continue;
+    std::string key = line.substr(0, colon);
+    std::string value = line.substr(std::min(line.find_first_not_of(" \t", colon + 1), line.size()));
+    const std::string lowerKey = Internal::lower(key);
+    const std::string lowerValue = Internal::lower(value);
+    if (lowerKey == "content-length")
+      contentLength = std::strtoull(value.c_str(), nullptr, 10);
+    else if (lowerKey == "transfer-encoding" && lowerValue.find("chunked") != std::string::npos)
+      chunked = true;
+    else if (lowerKey == "connection" && lowerValue == "close")
+      keepAlive = false;
+    else if (lowerKey == "connection" && lowerValue == "keep-alive")
+      keepAlive = true;
+    response[key] = std::move(value);
+  }
+
+  // body
+  std::string body;
+  if (isHead || status / 100 == 1 || status == 204 || status == 304) {
+    // no body
+  } else if (chunked) {
+    while (true) {
+      if (!readLine(line))
+        return -1;
+      const size_t chunkSize = std::strtoull(line.c_str(), nullptr, 16);
+      if (chunkSize == 0)
+        break;
+      if (!readBytes(chunkSize, body) || !readLine(line))
+        return -1;
+    }
+    // trailer
+    do {
+      if (!readLine(line))
+        return -1;
+    } while (!line.empty());
+  } else if (contentLength != std::string::npos) {
+    if (!readBytes(contentLength, body))
+      return -1;
+  } else {
+    readAll(body);
+    keepAlive = false;
+  }
+  response["body"] = std::move(body);
+  return status;
+}
+
+Exiv2::HttpConnection::HttpConnection() : p_(std::make_unique<Impl>()) {
+}
+
+Exiv2::HttpConnection::~HttpConnection() {
+  p_->disconnect();
+}
+
+void Exiv2::HttpConnection::disconnect() {
+  p_->disconnect();
+}
+
+size_t Exiv2::HttpConnection::connects() const {
+  return p_->connects_;
+}
+
+size_t Exiv2::HttpConnection::requests() const {
+  return p_->requests_;
+}
+
+int Exiv2::HttpConnection::request(Exiv2::Dictionary& request, Exiv2::Dictionary& response, std::string& errors) {
+  request.try_emplace("verb", "GET");
+  request.try_emplace("header");
+  request.try_emplace("port");
+  errors.clear();
+
+  const Route target = route(request["server"], request["port"], request["page"]);
+  const std::string& verb = request["verb"];
+
+  ////////////////////////////////////
+  // format the request, one header per line
+  std::string text = verb + " " + target.page_ +
+                     " HTTP/1.1\r\n"
+                     "User-Agent: exiv2http/1.0.0\r\n"
+                     "Accept: */*\r\n"
+                     "Host: " +
+                     request["server"] + "\r\n";
+  const std::string& header = request["header"];
+  for (size_t pos = 0; pos < header.size();) {
+    auto eol = std::min(header.find('\n', pos), header.size());
+    auto line = header.substr(pos, eol - pos);
+    if (!line.empty() && line.back() == '\r')
+      line.pop_back();
+    if (!line.empty())
+      text += line + "\r\n";
+    pos = eol + 1;
+  }
+  text += "\r\n";
+  response["requestheaders"] = text;
+
+  ////////////////////////////////////
+  // send it on the open connection to the server, if there is one. A server
+  // may have closed an idle connection, so retry once on a new one.
+  const std::string peer = target.server_ + ':' + target.port_;
+  if (p_->peer_ != peer)
+    p_->disconnect();
+  for (int attempt = 0; attempt < 2; ++attempt) {
+    const bool reused = p_->sockfd_ != INVALID_SOCKET;
+    if (!reused && !p_->connect(target.server_, target.port_, errors))
+      return -1;
+    ++p_->requests_;
+    bool keepAlive = false;
+    int status = p_->send(text) ? p_->readResponse(verb == "HEAD", response, keepAlive) : -1;
+    if (status < 0 || !keepAlive)
+      p_->disconnect();
+    if (status >= 0)
+      return status;
+    if (!reused)
+      break;
+  }
+  error(errors, "error - no response from server = %s port = %s wsa_error = %d", target.server_.c_str(),
+        target.port_.c_str(), WSAGetLastError());
+  return -1;
+}
+
 // That's all Folks
@@ -45,10 +45,12 @@
 #endif  // EXV_ENABLE_VIDEO
 
 // + standard includes
+#include <array>
 #include <bit>
 #include <cstdio>
 #include <cstring>
 #include <set>
+#include <string_view>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -119,6 +121,114 @@ constexpr Registry registry[] = {
 #endif  // EXV_ENABLE_BMFF
 };
 
+//! Struct for storing magic bytes at a fixed offset of a file of an image type
+struct Magic {
+  ImageType imageType_;
+  size_t offset_;
+  std::string_view bytes_;
+};
+
+/*!
+  Magic bytes of the image types in the registry. Data can only be of an
+  image type with entries in this table if it matches one of them. Image
+  types without an entry, e.g., TGA, are always checked with their type
+  check function. The type check functions remain the final authority.
+ */
+constexpr Magic magicTable[] = {
+    {ImageType::jpeg, 0, std::string_view("\xff\xd8", 2)},
+    {ImageType::exv, 0, std::string_view("\xff\x01" "Exiv2", 7)},
+    {ImageType::cr2, 0, "II"},
+    {ImageType::cr2, 0, "MM"},
+    {ImageType::crw, 0, "II"},
+    {ImageType::crw, 0, "MM"},
+    {ImageType::mrw, 0, std::string_view("\0MRM", 4)},
+    {ImageType::tiff, 0, "II"},
+    {ImageType::tiff, 0, "MM"},
+    {ImageType::webp, 0, "RIFF"},
+    {ImageType::dng, 0, "II"},
+    {ImageType::dng, 0, "MM"},
+    {ImageType::nef, 0, "II"},
+    {ImageType::nef, 0, "MM"},
+    {ImageType::pef, 0, "II"},
+    {ImageType::pef, 0, "MM"},
+    {ImageType::arw, 0, "II"},
+    {ImageType::arw, 0, "MM"},
+    {ImageType::rw2, 0, "II"},
+    {ImageType::rw2, 0, "MM"},
+    {ImageType::sr2, 0, "II"},
+    {ImageType::sr2, 0, "MM"},
+    {ImageType::srw, 0, "II"},
+    {ImageType::srw, 0, "MM"},
+    {ImageType::orf, 0, "II"},
+    {ImageType::orf, 0, "MM"},
+    {ImageType::png, 0, "\x89PNG\r\n\x1a\n"},
+    {ImageType::pgf, 0, "PGF"},
+    {ImageType::raf, 0, "FUJIFILM"},
+    {ImageType::eps, 0, "\xc5\xd0\xd3\xc6"},
+    {ImageType::eps, 0, "%!PS-Adobe-3."},
+    {ImageType::xmp, 0, "<"},
+    {ImageType::xmp, 0, "\xef\xbb\xbf<"},
+    {ImageType::gif, 0, "GIF8"},
+    {ImageType::psd, 0, "8BPS"},
+    {ImageType::bmp, 0, "BM"},
+    {ImageType::jp2, 0, std::string_view("\0\0\0\x0cjP  \r\n\x87\n", 12)},
+    {ImageType::qtime, 4, "PICT"},
+    {ImageType::qtime, 4, "free"},
+    {ImageType::qtime, 4, "ftyp"},
+    {ImageType::qtime, 4, "junk"},
+    {ImageType::qtime, 4, "mdat"},
+    {ImageType::qtime, 4, "moov"},
+    {ImageType::qtime, 4, "pict"},
+    {ImageType::qtime, 4, "pnot"},
+    {ImageType::qtime, 4, "skip"},
+    {ImageType::qtime, 4, "uuid"},
+    {ImageType::qtime, 4, "wide"},
+    {ImageType::asf, 0, "\x30\x26\xb2\x75"},
+    {ImageType::riff, 0, "RIFF"},
+    {ImageType::mkv, 0, "\x1a\x45\xdf\xa3"},
+    {ImageType::bmff, 4, "ftyp"},
+    {ImageType::bmff, 4, "JXL "},
+};
+
+//! Number of bytes read from the start of the data to match the magic bytes
+constexpr size_t magicSize = 64;
+
+/*!
+  @brief Return false if the \em size bytes at \em data can't be the start
+         of an image of type \em imageType according to the magic table,
+         else true. Data too short to tell is not ruled out.
+ */
+bool maybeType(ImageType imageType, const byte* data, size_t size) {
+  bool hasMagic = false;
+  for (auto&& m : magicTable) {
+    if (m.imageType_ != imageType)
+      continue;
+    hasMagic = true;
+    if (m.offset_ + m.bytes_.size() > size || std::memcmp(data + m.offset_, m.bytes_.data(), m.bytes_.size()) == 0)
+      return true;
+  }
+  return !hasMagic;
+}
+
+/*!
+  @brief Return the registry entry of the first image type whose type check
+         accepts the data in \em io, nullptr if there is none. The start of
+         the data is read once and only the type checks of image types whose
+         magic bytes match it are called.
+ */
+const Registry* findRegistry(BasicIo& io) {
+  std::array<byte, magicSize> head;
+  const auto pos = static_cast<int64_t>(io.tell());
+  const size_t size = io.read(head.data(), head.size());
+  io.seek(pos, BasicIo::beg);
+  for (const auto& r : registry) {
+    if (maybeType(r.imageType_, head.data(), size) && r.isThisType_(io, false)) {
+      return &r;
+    }
+  }
+  return nullptr;
+}
+
 #ifdef EXV_ENABLE_FILESYSTEM
 std::string pathOfFileUrl(const std::string& url) {
   std::string path = url.substr(7);
@@ -530,6 +640,47 @@ void Image::printTiffStructure(BasicIo& io, std::ostream& out, Exiv2::PrintStruc
   }
 }
 
+void Image::scanExif(ExifScan& scan) {
+  ReadFilter filter;
+  for (const auto& key : scan.keys())
+    filter.addKey(key);
+  // readMetadata() replaces the metadata of the image, keep it to restore it afterwards
+  auto exifData = std::move(exifData_);
+  auto iptcData = std::move(iptcData_);
+  auto xmpData = std::move(xmpData_);
+  auto iccProfile = std::move(iccProfile_);
+  auto comment = std::move(comment_);
+  auto xmpPacket = std::move(xmpPacket_);
+  auto nativePreviews = std::move(nativePreviews_);
+  const auto pixelWidth = pixelWidth_;
+  const auto pixelHeight = pixelHeight_;
+  const auto byteOrder = byteOrder_;
+  const auto partialMetadata = partialMetadata_;
+  auto readFilter = std::exchange(readFilter_, std::move(filter));
+  auto restore = [&] {
+    exifData_ = std::move(exifData);
+    iptcData_ = std::move(iptcData);
+    xmpData_ = std::move(xmpData);
+    iccProfile_ = std::move(iccProfile);
+    comment_ = std::move(comment);
+    xmpPacket_ = std::move(xmpPacket);
+    nativePreviews_ = std::move(nativePreviews);
+    pixelWidth_ = pixelWidth;
+    pixelHeight_ = pixelHeight;
+    byteOrder_ = byteOrder;
+    partialMetadata_ = partialMetadata;
+    readFilter_ = std::move(readFilter);
+  };
+  try {
+    readMetadata();
+    scan.setValues(exifData_);
+  } catch (...) {
+    restore();
+    throw;
+  }
+  restore();
+}
+
 void Image::clearMetadata() {
   clearExifData();
   clearIptcData();
@@ -668,6 +819,14 @@ void Image::setByteOrder(ByteOrder byteOrder) {
   byteOrder_ = byteOrder;
 }
 
+void Image::setWritePolicy(const WritePolicy& writePolicy) {
+  writePolicy_ = writePolicy;
+}
+
+void Image::setReadFilter(ReadFilter readFilter) {
+  readFilter_ = std::move(readFilter);
+}
+
 ByteOrder Image::byteOrder() const {
   return byteOrder_;
 }
@@ -708,6 +867,31 @@ bool Image::writeXmpFromPacket() const {
   return writeXmpFromPacket_;
 }
 
+const WritePolicy& Image::writePolicy() const {
+  return writePolicy_;
+}
+
+const WriteResult& Image::writeResult() const {
+  return writeResult_;
+}
+
+const ReadFilter& Image::readFilter() const {
+  return readFilter_;
+}
+
+bool Image::partialMetadata() const {
+  return partialMetadata_;
+}
+
+void Image::recordReadFilter() {
+  partialMetadata_ = !readFilter_.empty();
+}
+
+void Image::enforceCompleteMetadata() const {
+  if (partialMetadata_)
+    throw Error(ErrorCode::kerPartialMetadata, io_->path());
+}
+
 const NativePreviewList& Image::nativePreviews() const {
   return nativePreviews_;
 }
@@ -791,11 +975,8 @@ ImageType ImageFactory::getType(BasicIo& io) {
   if (io.open() != 0)
     return ImageType::none;
   IoCloser closer(io);
-  for (const auto& r : registry) {
-    if (r.isThisType_(io, false)) {
-      return r.imageType_;
-    }
-  }
+  if (auto r = findRegistry(io))
+    return r->imageType_;
   return ImageType::none;
 }
 
@@ -864,11 +1045,8 @@ Image::UniquePtr ImageFactory::open(BasicIo::UniquePtr io) {
   if (io->open() != 0) {
     throw Error(ErrorCode::kerDataSourceOpenFailed, io->path(), strError());
   }
-  for (const auto& r : registry) {
-    if (r.isThisType_(*io, false)) {
-      return r.newInstance_(std::move(io), false);
-    }
-  }
+  if (auto r = findRegistry(*io))
+    return r->newInstance_(std::move(io), false);
   return nullptr;
 }
 
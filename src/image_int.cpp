@@ -4,12 +4,111 @@
 
 #include "image_int.hpp"
 
+#include "basicio.hpp"
+#include "futils.hpp"
+
+#include <cctype>
+#include <cerrno>
 #include <cstddef>
+#include <random>
 #include <string>
 
+#ifdef EXV_ENABLE_FILESYSTEM
+#include <filesystem>
+namespace fs = std::filesystem;
+#if defined(__linux__) && __has_include(<sys/xattr.h>)
+#include <sys/stat.h>
+#include <sys/xattr.h>
+#include <unistd.h>
+#define EXV_CHECK_OWNER_AND_XATTRS
+#endif
+#endif
+
 namespace Exiv2::Internal {
 [[nodiscard]] std::string indent(size_t i) {
   return std::string(2 * i, ' ');
 }
 
+std::optional<XmpPadding> findXmpPadding(std::string_view packet) {
+  const auto end = packet.rfind("<?xpacket end=");
+  if (end == std::string_view::npos)
+    return std::nullopt;
+  auto start = end;
+  while (start > 0 && std::isspace(static_cast<unsigned char>(packet[start - 1])))
+    --start;
+  return XmpPadding{start, end};
+}
+
+bool resizeXmpPadding(std::string& packet, size_t size) {
+  const auto padding = findXmpPadding(packet);
+  if (!padding)
+    return false;
+  const size_t rest = packet.size() - (padding->end_ - padding->start_);
+  if (rest > size)
+    return false;
+  packet.replace(padding->start_, padding->end_ - padding->start_, size - rest, ' ');
+  return true;
+}
+
+#ifdef EXV_ENABLE_FILESYSTEM
+namespace {
+/*!
+  @brief Return true if the file \em tempPath keeps everything of the file
+         \em path but its content when it is renamed over it: the owner,
+         the group and the extended attributes, which hold the ACLs. Sets
+         the group of \em tempPath to the one of \em path.
+ */
+bool takesOverAttributes([[maybe_unused]] const fs::path& path, [[maybe_unused]] const fs::path& tempPath) {
+#if defined(_WIN32)
+  // ReplaceFile keeps the attributes and ACLs of the original
+  return true;
+#elif defined(EXV_CHECK_OWNER_AND_XATTRS)
+  struct stat st {};
+  if (::stat(path.c_str(), &st) != 0 || st.st_uid != ::geteuid())
+    return false;
+  if (::chown(tempPath.c_str(), static_cast<uid_t>(-1), st.st_gid) != 0)
+    return false;
+  const auto size = ::listxattr(path.c_str(), nullptr, 0);
+  return size == 0 || (size < 0 && errno == ENOTSUP);
+#else
+  // No way to tell what a rename would lose
+  return false;
+#endif
+}
+}  // namespace
+
+std::unique_ptr<FileIo> createTempFileFor(const BasicIo& io) {
+  if (!dynamic_cast<const FileIo*>(&io) || fileProtocol(io.path()) != pFile)
+    return nullptr;
+  std::error_code ec;
+  // A rename would replace the link rather than the file it points to
+  if (fs::is_symlink(io.path(), ec) || ec)
+    return nullptr;
+  if (fs::hard_link_count(io.path(), ec) != 1 || ec)
+    return nullptr;
+  const auto path = fs::canonical(io.path(), ec);
+  if (ec)
+    return nullptr;
+
+  std::random_device random;
+  for (int i = 0; i < 8; ++i) {
+    auto tempIo = std::make_unique<FileIo>(stringFormat("{}.exiv2_{:08x}", path.string(), random()));
+    // "x": fail if the file exists, so that no other file is ever overwritten
+    if (tempIo->open("w+bx") == 0) {
+      if (!takesOverAttributes(path, tempIo->path())) {
+        tempIo->close();
+        fs::remove(tempIo->path(), ec);
+        return nullptr;
+      }
+      // Publish the new file with the permissions of the original
+      fs::permissions(tempIo->path(), fs::status(path).permissions(), ec);
+      return tempIo;
+    }
+    if (errno != EEXIST)
+      break;
+  }
+  return nullptr;
+}
+#endif
+
 }  // namespace Exiv2::Internal
@@ -11,8 +11,11 @@
 
 #include <cstddef>  // for size_t
 #include <cstdint>  // for int32_t
+#include <memory>   // for unique_ptr
+#include <optional>
 #include <ostream>  // for ostream, basic_ostream::put
 #include <string>
+#include <string_view>
 
 #if __has_include(<format>)
 #include <format>
@@ -26,6 +29,13 @@
 #define stringFormatTo std::format_to
 #endif
 
+// *****************************************************************************
+// class declarations
+namespace Exiv2 {
+class BasicIo;
+class FileIo;
+}  // namespace Exiv2
+
 // *****************************************************************************
 // namespace extensions
 namespace Exiv2::Internal {
@@ -102,6 +112,40 @@ constexpr binaryToStringHelper<T> binaryToString(Slice<T>&& sl) noexcept {
 /// @brief indent output for kpsRecursive in \em printStructure() \em .
 std::string indent(size_t i);
 
+//! Padding of an XMP packet, the whitespace before the packet trailer which lets the packet grow in place
+struct XmpPadding {
+  size_t start_;  //!< Offset of the first byte of the padding
+  size_t end_;    //!< Offset of the packet trailer, the end of the padding
+};
+
+//! Find the padding of the XMP packet \em packet, return std::nullopt if the packet has no trailer.
+std::optional<XmpPadding> findXmpPadding(std::string_view packet);
+
+/*!
+  @brief Grow or shrink the padding of the XMP packet \em packet, so that
+         the packet is \em size bytes long.
+  @return true if the packet has the requested size
+ */
+bool resizeXmpPadding(std::string& packet, size_t size);
+
+#ifdef EXV_ENABLE_FILESYSTEM
+/*!
+  @brief Create a new, empty temporary file in the directory of the file
+         \em io refers to. An image writes its new version to this file and
+         then replaces the original with FileIo::transfer(), which renames it.
+
+  @return The temporary file, open for writing, or nullptr if a rename
+          would lose something of the original or the temporary file can't
+          be created: if \em io is not a local file, is a symbolic link, has
+          more than one hard link, has an owner other than the process or
+          extended attributes (ACLs), or if its group can't be kept. Callers
+          fall back to a MemIo then. Owners and extended attributes can only
+          be checked on Linux. On other systems except Windows, where
+          ReplaceFile keeps them, the function always returns nullptr.
+ */
+std::unique_ptr<FileIo> createTempFileFor(const BasicIo& io);
+#endif
+
 }  // namespace Exiv2::Internal
 
 #endif  // #ifndef IMAGE_INT_HPP_
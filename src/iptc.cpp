@@ -359,13 +359,15 @@ const char* IptcData::detectCharset() const {
   return nullptr;
 }
 
-int IptcParser::decode(IptcData& iptcData, const byte* pData, size_t size) {
+int IptcParser::decode(IptcData& iptcData, const byte* pData, size_t size, const ReadFilter& filter) {
 #ifdef EXIV2_DEBUG_MESSAGES
   std::cerr << "IptcParser::decode, size = " << size << "\n";
 #endif
   auto pRead = pData;
   const auto pEnd = pData + size;
   iptcData.clear();
+  if (!filter.passesGroup("Iptc"))
+    return 0;
 
   uint16_t record = 0;
   uint16_t dataSet = 0;
@@ -400,6 +402,10 @@ int IptcParser::decode(IptcData& iptcData, const byte* pData, size_t size) {
       pRead += 2;
     }
     if (sizeData <= static_cast<size_t>(pEnd - pRead)) {
+      if (!filter.empty() && !filter.passesGroup("Iptc." + IptcDataSets::recordName(record))) {
+        pRead += sizeData;
+        continue;
+      }
       int rc = readData(iptcData, dataSet, record, pRead, sizeData);
       if (rc != 0) {
 #ifndef SUPPRESS_WARNINGS
@@ -141,6 +141,7 @@ void Jp2Image::readMetadata() {
   if (!isJp2Type(*io_, false)) {
     throw Error(ErrorCode::kerNotAnImage, "JPEG-2000");
   }
+  recordReadFilter();
 
   Internal::Jp2BoxHeader box = {0, 0};
   Internal::Jp2BoxHeader subBox = {0, 0};
@@ -312,8 +313,8 @@ void Jp2Image::readMetadata() {
 #ifdef EXIV2_DEBUG_MESSAGES
                 std::cout << "Exiv2::Jp2Image::readMetadata: Exif header found at position " << pos << '\n';
 #endif
-                ByteOrder bo =
-                    TiffParser::decode(exifData(), iptcData(), xmpData(), rawData.c_data(pos), rawData.size() - pos);
+                ByteOrder bo = TiffParser::decode(exifData(), iptcData(), xmpData(), rawData.c_data(pos),
+                                                  rawData.size() - pos, readFilter());
                 setByteOrder(bo);
               }
             } else {
@@ -336,7 +337,7 @@ void Jp2Image::readMetadata() {
             if (bufRead != rawData.size())
               throw Error(ErrorCode::kerInputDataReadFailed);
 
-            if (IptcParser::decode(iptcData_, rawData.c_data(), rawData.size())) {
+            if (IptcParser::decode(iptcData_, rawData.c_data(), rawData.size(), readFilter())) {
 #ifndef SUPPRESS_WARNINGS
               EXV_WARNING << "Failed to decode IPTC metadata." << '\n';
 #endif
@@ -365,7 +366,7 @@ void Jp2Image::readMetadata() {
               xmpPacket_ = xmpPacket_.substr(idx);
             }
 
-            if (!xmpPacket_.empty() && XmpParser::decode(xmpData_, xmpPacket_)) {
+            if (!xmpPacket_.empty() && XmpParser::decode(xmpData_, xmpPacket_, readFilter())) {
 #ifndef SUPPRESS_WARNINGS
               EXV_WARNING << "Failed to decode XMP metadata." << '\n';
 #endif
@@ -580,6 +581,7 @@ void Jp2Image::printStructure(std::ostream& out, PrintStructureOption option, si
 }
 
 void Jp2Image::writeMetadata() {
+  enforceCompleteMetadata();
   if (io_->open() != 0) {
     throw Error(ErrorCode::kerDataSourceOpenFailed, io_->path(), strError());
   }
@@ -16,6 +16,13 @@
 
 #include <array>
 #include <iostream>
+#include <string_view>
+#include <vector>
+
+#ifdef EXV_ENABLE_FILESYSTEM
+#include <filesystem>
+namespace fs = std::filesystem;
+#endif
 
 // *****************************************************************************
 // class member definitions
@@ -111,6 +118,70 @@ std::pair<std::array<byte, 2>, uint16_t> readSegmentSize(const byte marker, Basi
   }
   return {buf, size};
 }
+
+//! Padding in the segments written by JpegBase, which can be resized to let them fit in place
+struct SegmentPadding {
+  size_t segment_;  //!< Offset of the segment with the padding
+  size_t start_;    //!< Offset of the padding
+  size_t end_;      //!< Offset of the end of the padding
+  byte fill_;       //!< Byte to pad with
+};
+
+/*!
+  @brief Find the padding in \em segments: the padding of the XMP packet and
+         the slack of \em exifSlack bytes at the end of the Exif segment.
+  @param segments  JPEG segments, up to and including the marker of the first
+         segment which is copied unchanged
+  @param start     Offset of the first segment
+  @param exifSlack Number of zero bytes at the end of the Exif segment
+ */
+std::vector<SegmentPadding> findPadding(const DataBuf& segments, size_t start, size_t exifSlack) {
+  std::vector<SegmentPadding> padding;
+  for (size_t pos = start; pos + 4 <= segments.size() - 2;) {
+    const byte marker = segments.read_uint8(pos + 1);
+    if (!markerHasLength(marker))
+      break;
+    const size_t end = pos + 2 + segments.read_uint16(pos + 2, bigEndian);
+    if (end > segments.size() - 2)
+      break;
+    if (marker == app1_ && end - pos >= 33 && segments.cmpBytes(pos + 4, xmpId_.data(), 29) == 0) {
+      if (auto xmp = Internal::findXmpPadding({segments.c_str(pos + 33), end - pos - 33}))
+        padding.push_back({pos, pos + 33 + xmp->start_, pos + 33 + xmp->end_, ' '});
+    } else if (marker == app1_ && end - pos >= 10 + exifSlack && exifSlack > 0 &&
+               segments.cmpBytes(pos + 4, exifId_.data(), 6) == 0) {
+      padding.push_back({pos, end - exifSlack, end, 0});
+    }
+    pos = end;
+  }
+  return padding;
+}
+
+/*!
+  @brief Resize one of the \em padding in \em segments, so that the segments
+         are \em size bytes long and fill the space of the segments they
+         replace. The XMP packet padding is preferred over the Exif slack.
+  @return The padding which was resized, or nullptr if the segments can't be
+          made to fit
+ */
+const SegmentPadding* fitPadding(DataBuf& segments, const std::vector<SegmentPadding>& padding, size_t size) {
+  for (const auto& pad : padding) {
+    const size_t length = segments.read_uint16(pad.segment_ + 2, bigEndian);
+    if (size > segments.size() ? length + (size - segments.size()) > 0xffff
+                               : pad.end_ - pad.start_ < segments.size() - size) {
+      continue;
+    }
+    // Copy the segments with the new amount of padding
+    const size_t newSize = pad.end_ - pad.start_ + size - segments.size();
+    DataBuf fitted(size);
+    std::copy_n(segments.c_data(), pad.start_, fitted.begin());
+    std::fill_n(fitted.begin() + pad.start_, newSize, pad.fill_);
+    std::copy(segments.begin() + pad.end_, segments.end(), fitted.begin() + pad.start_ + newSize);
+    fitted.write_uint16(pad.segment_ + 2, static_cast<uint16_t>(length + size - segments.size()), bigEndian);
+    segments = std::move(fitted);
+    return &pad;
+  }
+  return nullptr;
+}
 }  // namespace
 
 JpegBase::JpegBase(ImageType type, BasicIo::UniquePtr io, bool create, const byte initData[], size_t dataSize) :
@@ -161,6 +232,7 @@ void JpegBase::readMetadata() {
     throw Error(ErrorCode::kerNotAJpeg);
   }
   clearMetadata();
+  recordReadFilter();
   int search = 6;  // Exif, ICC, XMP, Comment, IPTC, SOF
   Blob psBlob;
   bool foundCompletePsData = false;
@@ -191,7 +263,9 @@ void JpegBase::readMetadata() {
 
     if (!foundExifData && marker == app1_ && size >= 8  // prevent out-of-bounds read in memcmp on next line
         && buf.cmpBytes(2, exifId_.data(), 6) == 0) {
-      ByteOrder bo = ExifParser::decode(exifData_, buf.c_data(8), size - 8);
+      // The Exif data may keep the segment, large values refer to it
+      auto exif = std::make_shared<const DataBuf>(std::move(buf));
+      ByteOrder bo = ExifParser::decode(exifData_, exif, 8, readFilter());
       setByteOrder(bo);
       if (size > 8 && byteOrder() == invalidByteOrder) {
 #ifndef SUPPRESS_WARNINGS
@@ -204,7 +278,7 @@ void JpegBase::readMetadata() {
     } else if (!foundXmpData && marker == app1_ && size >= 31  // prevent out-of-bounds read in memcmp on next line
                && buf.cmpBytes(2, xmpId_.data(), 29) == 0) {
       xmpPacket_.assign(buf.c_str(31), size - 31);
-      if (!xmpPacket_.empty() && XmpParser::decode(xmpData_, xmpPacket_)) {
+      if (!xmpPacket_.empty() && XmpParser::decode(xmpData_, xmpPacket_, readFilter())) {
 #ifndef SUPPRESS_WARNINGS
         EXV_WARNING << "Failed to decode XMP metadata.\n";
 #endif
@@ -302,7 +376,7 @@ void JpegBase::readMetadata() {
       }
       pCur = record + sizeHdr + sizeIptc + (sizeIptc & 1);
     }
-    if (!iptcBlob.empty() && IptcParser::decode(iptcData_, iptcBlob.data(), iptcBlob.size())) {
+    if (!iptcBlob.empty() && IptcParser::decode(iptcData_, iptcBlob.data(), iptcBlob.size(), readFilter())) {
 #ifndef SUPPRESS_WARNINGS
       EXV_WARNING << "Failed to decode IPTC metadata.\n";
 #endif
@@ -317,6 +391,40 @@ void JpegBase::readMetadata() {
   }
 }  // JpegBase::readMetadata
 
+void JpegBase::scanExif(ExifScan& scan) {
+  if (io_->open() != 0)
+    throw Error(ErrorCode::kerDataSourceOpenFailed, io_->path(), strError());
+  IoCloser closer(*io_);
+  // Ensure that this is the correct image type
+  if (!isThisType(*io_, true)) {
+    if (io_->error() || io_->eof())
+      throw Error(ErrorCode::kerFailedToReadImageData);
+    throw Error(ErrorCode::kerNotAJpeg);
+  }
+  scan.clear();
+
+  // Skip the segments up to the Exif segment without reading them
+  byte marker = advanceToMarker(ErrorCode::kerNotAJpeg);
+  while (marker != sos_ && marker != eoi_) {
+    const auto [sizebuf, size] = readSegmentSize(marker, *io_);
+    if (marker == app1_ && size >= 8) {
+      DataBuf buf(size);
+      io_->readOrThrow(buf.data(2), size - 2, ErrorCode::kerFailedToReadImageData);
+      if (buf.cmpBytes(2, exifId_.data(), 6) == 0) {
+        ExifParser::scan(scan, buf.c_data(8), size - 8);
+        return;
+      }
+    } else if (size > 2 && io_->seek(size - 2, BasicIo::cur) != 0) {
+      return;
+    }
+    try {
+      marker = advanceToMarker(ErrorCode::kerFailedToReadImageData);
+    } catch (const Error&) {
+      return;
+    }
+  }
+}
+
 #define REPORT_MARKER                                 \
   if ((option == kpsBasic || option == kpsRecursive)) \
   out << stringFormat("{:8} | 0xff{:02x} {:<5}", io_->tell() - 2, marker, nm[marker].c_str())
@@ -574,17 +682,118 @@ void JpegBase::printStructure(std::ostream& out, PrintStructureOption option, si
 }  // JpegBase::printStructure
 
 void JpegBase::writeMetadata() {
+  enforceCompleteMetadata();
   if (io_->open() != 0) {
     throw Error(ErrorCode::kerDataSourceOpenFailed, io_->path(), strError());
   }
   IoCloser closer(*io_);
+  // The metadata segments are small, encode them first
+  writeResult_ = WriteResult();
+  MemIo segmentsIo;
+  writeSegments(segmentsIo);  // may throw
+  DataBuf segments(segmentsIo.size());
+  segmentsIo.seekOrThrow(0, BasicIo::beg, ErrorCode::kerImageWriteFailed);
+  segmentsIo.readOrThrow(segments.data(), segments.size(), ErrorCode::kerImageWriteFailed);
+
+  const size_t restStart = io_->tell();
+  MemIo headerIo;
+  writeHeader(headerIo);
+  writeResult_.inPlace_ = patchInPlace(segments, headerIo.size());
+  for (const auto& pad : findPadding(segments, headerIo.size(), writeResult_.exifPadding_)) {
+    if (pad.fill_ == ' ')
+      writeResult_.xmpPadding_ = pad.end_ - pad.start_;
+  }
+  if (writeResult_.inPlace_) {
+#ifndef SUPPRESS_WARNINGS
+    EXV_INFO << "Write strategy: In-place\n";
+#endif
+    return;
+  }
+  writeResult_.reserveUsed_ = 0;
+#ifndef SUPPRESS_WARNINGS
+  EXV_INFO << "Write strategy: Rewrite\n";
+#endif
+
+  // The rest is the entropy-coded data, copied in one go (by the kernel, if possible)
+  auto writeFile = [&](BasicIo& outIo) {
+    if (outIo.write(segments.c_data(), segments.size()) != segments.size())
+      throw Error(ErrorCode::kerImageWriteFailed);
+    io_->seekOrThrow(restStart, BasicIo::beg, ErrorCode::kerFailedToReadImageData);
+    if (outIo.write(*io_) != io_->size() - restStart || outIo.error())
+      throw Error(ErrorCode::kerImageWriteFailed);
+  };
+
+#ifdef EXV_ENABLE_FILESYSTEM
+  // Stream the new file to a temporary file next to the original, so that
+  // the memory needed does not grow with the size of the image
+  if (auto tempIo = Internal::createTempFileFor(*io_)) {
+    try {
+      writeFile(*tempIo);  // may throw
+      io_->close();
+      io_->transfer(*tempIo);  // may throw
+    } catch (...) {
+      tempIo->close();
+      std::error_code ec;
+      fs::remove(tempIo->path(), ec);
+      throw;
+    }
+    return;
+  }
+#endif
   MemIo tempIo;
 
-  doWriteMetadata(tempIo);  // may throw
+  writeFile(tempIo);  // may throw
   io_->close();
   io_->transfer(tempIo);  // may throw
 }
 
+bool JpegBase::patchInPlace(DataBuf& segments, size_t start) {
+#ifdef EXV_ENABLE_FILESYSTEM
+  auto fileIo = dynamic_cast<FileIo*>(io_.get());
+  if (!fileIo || fileProtocol(io_->path()) != pFile)
+    return false;
+  // The new segments must fill the space of the old ones exactly
+  const size_t size = io_->tell();
+  if (segments.size() != size) {
+    const auto padding = findPadding(segments, start, writeResult_.exifPadding_);
+    const size_t oldSize = segments.size();
+    const auto pad = fitPadding(segments, padding, size);
+    if (!pad)
+      return false;
+    if (pad->fill_ == 0)
+      writeResult_.exifPadding_ += size - oldSize;
+    writeResult_.reserveUsed_ = static_cast<int64_t>(oldSize) - static_cast<int64_t>(size);
+  }
+
+  // Only write the bytes which changed
+  DataBuf old(size);
+  io_->seekOrThrow(0, BasicIo::beg, ErrorCode::kerFailedToReadImageData);
+  io_->readOrThrow(old.data(), old.size(), ErrorCode::kerFailedToReadImageData);
+  size_t first = 0;
+  while (first < size && old.read_uint8(first) == segments.read_uint8(first))
+    ++first;
+  if (first == size)
+    return true;
+  size_t last = size;
+  while (old.read_uint8(last - 1) == segments.read_uint8(last - 1))
+    --last;
+
+  if (fileIo->open("r+b") != 0) {
+    // The file is read-only, it may still be replaced by a new one
+    fileIo->open();
+    return false;
+  }
+  fileIo->seekOrThrow(static_cast<int64_t>(first), BasicIo::beg, ErrorCode::kerImageWriteFailed);
+  if (fileIo->write(segments.c_data(first), last - first) != last - first || fileIo->error())
+    throw Error(ErrorCode::kerImageWriteFailed);
+  return true;
+#else
+  (void)segments;
+  (void)start;
+  return false;
+#endif
+}
+
 DataBuf JpegBase::readNextSegment(byte marker) {
   const auto [sizebuf, size] = readSegmentSize(marker, *io_);
 
@@ -599,7 +808,7 @@ DataBuf JpegBase::readNextSegment(byte marker) {
   return buf;
 }
 
-void JpegBase::doWriteMetadata(BasicIo& outIo) {
+void JpegBase::writeSegments(BasicIo& outIo) {
   if (!io_->isopen())
     throw Error(ErrorCode::kerInputDataReadFailed);
   if (!outIo.isopen())
@@ -748,6 +957,9 @@ void JpegBase::doWriteMetadata(BasicIo& outIo) {
         if (ExifParser::encode(blob, pExifData, exifSize, bo, exifData_) == wmIntrusive) {
           pExifData = !blob.empty() ? blob.data() : nullptr;
           exifSize = blob.size();
+          // Reserve slack after re-encoded Exif data, for later edits in place
+          if (exifSize > 0 && exifSize <= 0xffff - 8)
+            writeResult_.exifPadding_ = std::min<size_t>(writePolicy().exifPadding_, 0xffff - 8 - exifSize);
         }
         if (exifSize > 0) {
           std::array<byte, 10> tmpBuf;
@@ -757,7 +969,7 @@ void JpegBase::doWriteMetadata(BasicIo& outIo) {
 
           if (exifSize > 0xffff - 8)
             throw Error(ErrorCode::kerTooLargeJpegSegment, "Exif");
-          us2Data(tmpBuf.data() + 2, static_cast<uint16_t>(exifSize + 8), bigEndian);
+          us2Data(tmpBuf.data() + 2, static_cast<uint16_t>(exifSize + 8 + writeResult_.exifPadding_), bigEndian);
           std::copy(exifId_.begin(), exifId_.end(), tmpBuf.begin() + 4);
           if (outIo.write(tmpBuf.data(), 10) != 10)
             throw Error(ErrorCode::kerImageWriteFailed);
@@ -765,13 +977,17 @@ void JpegBase::doWriteMetadata(BasicIo& outIo) {
           // Write new Exif data buffer
           if (outIo.write(pExifData, exifSize) != exifSize)
             throw Error(ErrorCode::kerImageWriteFailed);
+          const Blob slack(writeResult_.exifPadding_);
+          if (outIo.write(slack.data(), slack.size()) != slack.size())
+            throw Error(ErrorCode::kerImageWriteFailed);
           if (outIo.error())
             throw Error(ErrorCode::kerImageWriteFailed);
           --search;
         }
       }
       if (!writeXmpFromPacket() &&
-          XmpParser::encode(xmpPacket_, xmpData_, XmpParser::useCompactFormat | XmpParser::omitAllFormatting) > 1) {
+          XmpParser::encode(xmpPacket_, xmpData_, XmpParser::useCompactFormat | XmpParser::omitAllFormatting,
+                            writePolicy().xmpPadding_) > 1) {
 #ifndef SUPPRESS_WARNINGS
         EXV_ERROR << "Failed to encode XMP metadata.\n";
 #endif
@@ -930,24 +1146,16 @@ void JpegBase::doWriteMetadata(BasicIo& outIo) {
   // it avoids allocating memory for parts of the file that contain image-date.
   io_->populateFakeData();
 
-  // Write the final marker, then copy rest of the Io.
+  // Write the final marker, the rest of the Io follows unchanged.
   byte tmpBuf[2];
   tmpBuf[0] = 0xff;
   tmpBuf[1] = marker;
   if (outIo.write(tmpBuf, 2) != 2)
     throw Error(ErrorCode::kerImageWriteFailed);
-
-  DataBuf buf(4096);
-  size_t readSize = io_->read(buf.data(), buf.size());
-  while (readSize != 0) {
-    if (outIo.write(buf.c_data(), readSize) != readSize)
-      throw Error(ErrorCode::kerImageWriteFailed);
-    readSize = io_->read(buf.data(), buf.size());
-  }
   if (outIo.error())
     throw Error(ErrorCode::kerImageWriteFailed);
 
-}  // JpegBase::doWriteMetadata
+}  // JpegBase::writeSegments
 
 const byte JpegImage::blank_[] = {
     0xFF, 0xD8, 0xFF, 0xDB, 0x00, 0x84, 0x00, 0x10, 0x0B, 0x0B, 0x0B, 0x0C, 0x0B, 0x10, 0x0C, 0x0C, 0x10, 0x17,
@@ -15,7 +15,10 @@
 #include "utils.hpp"
 
 // + standard includes
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <mutex>
 
 #ifdef EXV_ENABLE_FILESYSTEM
 #include <filesystem>
@@ -45,6 +48,101 @@ std::string getExifModel(Exiv2::Internal::TiffComponent* pRoot);
 
 //! Nikon en/decryption function
 void ncrypt(Exiv2::byte* pData, uint32_t size, uint32_t count, uint32_t serial);
+
+#if defined(EXV_ENABLE_INIH) && defined(EXV_ENABLE_FILESYSTEM)
+/*!
+  @brief Process-wide cache of the parsed Exiv2 configuration file. The file
+         is parsed on first use and again only when its modification time
+         changes. Lookups check the time at most once a second, refresh()
+         every time. All member functions are thread-safe.
+ */
+class ConfigCache {
+ public:
+  //! Return the cache instance
+  static ConfigCache& instance() {
+    static ConfigCache cache;
+    return cache;
+  }
+  //! Return the parsed configuration file or nullptr if there is none, (re)load it if a check is due
+  std::shared_ptr<const INIReader> reader() {
+    const auto now = Clock::now().time_since_epoch().count();
+    const auto checked = checked_.load(std::memory_order_acquire);
+    if (checked != 0 && now - checked < checkInterval)
+      return loadReader();
+    return refresh();
+  }
+  //! Check the configuration file now, (re)load it if needed and return it
+  std::shared_ptr<const INIReader> refresh() {
+    std::scoped_lock lock(mutex_);
+    if (!loaded_ || modified())
+      load();
+    checked_.store(Clock::now().time_since_epoch().count(), std::memory_order_release);
+    return loadReader();
+  }
+  //! Discard the cached configuration, the next lookup locates and parses the file again
+  void invalidate() {
+    std::scoped_lock lock(mutex_);
+    loaded_ = false;
+    checked_.store(0, std::memory_order_release);
+  }
+
+ private:
+  using Clock = std::chrono::steady_clock;
+  //! Interval between the checks of the modification time by lookups, in clock ticks
+  static constexpr auto checkInterval = std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(1)).count();
+
+  //! Return true if the file has been created, removed or modified since it was loaded
+  [[nodiscard]] bool modified() const {
+    std::error_code ec;
+    auto mtime = fs::last_write_time(path_, ec);
+    const bool exists = !ec;
+    return exists != exists_ || (exists && mtime != mtime_);
+  }
+  //! Locate and parse the configuration file
+  void load() {
+    path_ = Exiv2::Internal::getExiv2ConfigPath();
+    std::error_code ec;
+    mtime_ = fs::last_write_time(path_, ec);
+    exists_ = !ec;
+    std::shared_ptr<const INIReader> reader;
+    if (exists_) {
+      reader = std::make_shared<const INIReader>(path_);
+      if (reader->ParseError() != 0)
+        reader.reset();
+    }
+    storeReader(std::move(reader));
+    loaded_ = true;
+  }
+#ifdef __cpp_lib_atomic_shared_ptr
+  [[nodiscard]] std::shared_ptr<const INIReader> loadReader() const {
+    return reader_.load();
+  }
+  void storeReader(std::shared_ptr<const INIReader> reader) {
+    reader_.store(std::move(reader));
+  }
+#else
+  [[nodiscard]] std::shared_ptr<const INIReader> loadReader() const {
+    return std::atomic_load(&reader_);
+  }
+  void storeReader(std::shared_ptr<const INIReader> reader) {
+    std::atomic_store(&reader_, std::move(reader));
+  }
+#endif
+
+  // DATA
+  std::mutex mutex_;                    //!< Serializes checks and loads of the file
+  bool loaded_{false};                  //!< True if the configuration has been loaded
+  std::string path_;                    //!< Path of the configuration file
+  bool exists_{false};                  //!< True if the file existed when it was loaded
+  fs::file_time_type mtime_;            //!< Modification time of the file when it was loaded
+  std::atomic<Clock::rep> checked_{0};  //!< Time of the last check of the file, 0 if one is due
+#ifdef __cpp_lib_atomic_shared_ptr
+  std::atomic<std::shared_ptr<const INIReader>> reader_;  //!< Parsed configuration, nullptr if there is none
+#else
+  std::shared_ptr<const INIReader> reader_;  //!< Parsed configuration, nullptr if there is none
+#endif
+};
+#endif
 }  // namespace
 
 // *****************************************************************************
@@ -89,15 +187,27 @@ std::string readExiv2Config([[maybe_unused]] const std::string& section, [[maybe
   std::string result = def;
 
 #if defined(EXV_ENABLE_INIH) && defined(EXV_ENABLE_FILESYSTEM)
-  INIReader reader(Exiv2::Internal::getExiv2ConfigPath());
-  if (reader.ParseError() == 0) {
-    result = reader.Get(section, value, def);
-  }
+  if (auto reader = ConfigCache::instance().reader())
+    result = reader->Get(section, value, def);
 #endif
 
   return result;
 }
 
+bool refreshExiv2Config() {
+#if defined(EXV_ENABLE_INIH) && defined(EXV_ENABLE_FILESYSTEM)
+  return ConfigCache::instance().refresh() != nullptr;
+#else
+  return false;
+#endif
+}
+
+void invalidateExiv2Config() {
+#if defined(EXV_ENABLE_INIH) && defined(EXV_ENABLE_FILESYSTEM)
+  ConfigCache::instance().invalidate();
+#endif
+}
+
 const TiffMnRegistry TiffMnCreator::registry_[] = {
     {"Canon", IfdId::canonId, newIfdMn, newIfdMn2},
     {"FOVEON", IfdId::sigmaId, newSigmaMn, newSigmaMn2},
@@ -25,6 +25,19 @@ std::string getExiv2ConfigPath();
  */
 std::string readExiv2Config(const std::string& section, const std::string& value, const std::string& def);
 
+/*!
+  @brief Check the Exiv2 configuration file now and parse it again if it has
+         changed since it was cached. Implements Exiv2::preloadConfig().
+  @return true if a configuration file was found and parsed successfully.
+ */
+bool refreshExiv2Config();
+
+/*!
+  @brief Discard the cached Exiv2 configuration file. Implements
+         Exiv2::invalidateConfig().
+ */
+void invalidateExiv2Config();
+
 // *****************************************************************************
 // class definitions
 
@@ -24,6 +24,45 @@ uint32_t Metadatum::toUint32(size_t n) const {
   return static_cast<uint32_t>(toInt64(n));
 }
 
+void ReadFilter::addKey(const std::string& key) {
+  keys_.insert(key);
+}
+
+void ReadFilter::addGroup(const std::string& group) {
+  groups_.insert(group);
+}
+
+void ReadFilter::setDeferMakernote(bool defer) {
+  deferMakernote_ = defer;
+}
+
+bool ReadFilter::empty() const {
+  return keys_.empty() && groups_.empty();
+}
+
+bool ReadFilter::passes(std::string_view key) const {
+  if (empty() || keys_.contains(key))
+    return true;
+  // the group or the family of the key
+  for (auto pos = key.rfind('.'); pos != std::string_view::npos && pos > 0; pos = key.rfind('.', pos - 1)) {
+    if (groups_.contains(key.substr(0, pos)))
+      return true;
+  }
+  return false;
+}
+
+bool ReadFilter::passesGroup(std::string_view group) const {
+  if (empty() || groups_.contains(group) || groups_.contains(group.substr(0, group.find('.'))))
+    return true;
+  // a key or a group within the group
+  const auto prefix = std::string(group) + '.';
+  auto within = [&prefix](const std::set<std::string, std::less<>>& set) {
+    auto it = set.lower_bound(prefix);
+    return it != set.end() && it->starts_with(prefix);
+  };
+  return within(keys_) || within(groups_);
+}
+
 bool cmpMetadataByTag(const Metadatum& lhs, const Metadatum& rhs) {
   return lhs.tag() < rhs.tag();
 }
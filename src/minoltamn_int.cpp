@@ -1858,11 +1858,11 @@ std::ostream& printMinoltaSonyLensID(std::ostream& os, const Value& value, const
   const std::string undefined("undefined");
   const std::string minolta("minolta");
   const std::string sony("sony");
-  if (Internal::readExiv2Config(minolta, value.toString(), undefined) != undefined) {
-    return os << Internal::readExiv2Config(minolta, value.toString(), undefined);
+  if (auto label = Internal::readExiv2Config(minolta, value.toString(), undefined); label != undefined) {
+    return os << label;
   }
-  if (Internal::readExiv2Config(sony, value.toString(), undefined) != undefined) {
-    return os << Internal::readExiv2Config(sony, value.toString(), undefined);
+  if (auto label = Internal::readExiv2Config(sony, value.toString(), undefined); label != undefined) {
+    return os << label;
   }
 
   // #1145 - respect lenses with shared LensID
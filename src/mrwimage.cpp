@@ -72,6 +72,7 @@ void MrwImage::readMetadata() {
     throw Error(ErrorCode::kerNotAnImage, "MRW");
   }
   clearMetadata();
+  recordReadFilter();
 
   // Find the TTW block and read it into a buffer
   uint32_t const len = 8;
@@ -110,7 +111,7 @@ void MrwImage::readMetadata() {
   io_->read(buf.data(), buf.size());
   Internal::enforce(!io_->error() && !io_->eof(), ErrorCode::kerFailedToReadImageData);
 
-  ByteOrder bo = TiffParser::decode(exifData_, iptcData_, xmpData_, buf.c_data(), buf.size());
+  ByteOrder bo = TiffParser::decode(exifData_, iptcData_, xmpData_, buf.c_data(), buf.size(), readFilter());
   setByteOrder(bo);
 }  // MrwImage::readMetadata
 
@@ -2057,8 +2057,8 @@ static bool testConfigFile(std::ostream& os, const Value& value) {
   bool result = false;
   const std::string undefined("undefined");
   const std::string section("nikon");
-  if (Internal::readExiv2Config(section, value.toString(), undefined) != undefined) {
-    os << Internal::readExiv2Config(section, value.toString(), undefined);
+  if (auto label = Internal::readExiv2Config(section, value.toString(), undefined); label != undefined) {
+    os << label;
     result = true;
   }
   return result;
@@ -3325,8 +3325,8 @@ std::ostream& Nikon3MakerNote::printLensId(std::ostream& os, const Value& value,
       const std::string undefined("undefined");
       const std::string section("nikon");
       auto lensIDStream = std::to_string(raw[7]);
-      if (Internal::readExiv2Config(section, lensIDStream, undefined) != undefined) {
-        return os << Internal::readExiv2Config(section, lensIDStream, undefined);
+      if (auto label = Internal::readExiv2Config(section, lensIDStream, undefined); label != undefined) {
+        return os << label;
       }
     }
 
@@ -1349,8 +1349,8 @@ std::ostream& OlympusMakerNote::print0x0201(std::ostream& os, const Value& value
   // #1034
   const std::string undefined("undefined");
   const std::string section("olympus");
-  if (Internal::readExiv2Config(section, value.toString(), undefined) != undefined) {
-    return os << Internal::readExiv2Config(section, value.toString(), undefined);
+  if (auto label = Internal::readExiv2Config(section, value.toString(), undefined); label != undefined) {
+    return os << label;
   }
 
   // 6 numbers: 0. Make, 1. Unknown, 2. Model, 3. Sub-model, 4-5. Unknown.
@@ -81,11 +81,27 @@ void OrfImage::readMetadata() {
     throw Error(ErrorCode::kerNotAnImage, "ORF");
   }
   clearMetadata();
-  ByteOrder bo = OrfParser::decode(exifData_, iptcData_, xmpData_, io_->mmap(), io_->size());
+  recordReadFilter();
+  ByteOrder bo = OrfParser::decode(exifData_, iptcData_, xmpData_, io_->mmap(), io_->size(), readFilter());
   setByteOrder(bo);
 }
 
+void OrfImage::scanExif(ExifScan& scan) {
+  if (io_->open() != 0) {
+    throw Error(ErrorCode::kerDataSourceOpenFailed, io_->path(), strError());
+  }
+  IoCloser closer(*io_);
+  // Ensure that this is the correct image type
+  if (!isOrfType(*io_, false)) {
+    if (io_->error() || io_->eof())
+      throw Error(ErrorCode::kerFailedToReadImageData);
+    throw Error(ErrorCode::kerNotAnImage, "ORF");
+  }
+  OrfParser::scan(scan, io_->mmap(), io_->size());
+}
+
 void OrfImage::writeMetadata() {
+  enforceCompleteMetadata();
 #ifdef EXIV2_DEBUG_MESSAGES
   std::cerr << "Writing ORF file " << io_->path() << "\n";
 #endif
@@ -109,10 +125,16 @@ void OrfImage::writeMetadata() {
   OrfParser::encode(*io_, pData, size, bo, exifData_, iptcData_, xmpData_);  // may throw
 }  // OrfImage::writeMetadata
 
-ByteOrder OrfParser::decode(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, const byte* pData, size_t size) {
+ByteOrder OrfParser::decode(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, const byte* pData, size_t size,
+                            const ReadFilter& filter) {
   OrfHeader orfHeader;
   return TiffParserWorker::decode(exifData, iptcData, xmpData, pData, size, Tag::root, TiffMapping::findDecoder,
-                                  &orfHeader);
+                                  &orfHeader, filter);
+}
+
+ByteOrder OrfParser::scan(ExifScan& scan, const byte* pData, size_t size) {
+  OrfHeader orfHeader;
+  return TiffParserWorker::scan(scan, pData, size, &orfHeader);
 }
 
 WriteMethod OrfParser::encode(BasicIo& io, const byte* pData, size_t size, ByteOrder byteOrder, ExifData& exifData,
@@ -1272,8 +1272,8 @@ static std::ostream& printLensType(std::ostream& os, const Value& value, const E
   // #1034
   const std::string undefined("undefined");
   const std::string section("pentax");
-  if (Internal::readExiv2Config(section, value.toString(), undefined) != undefined) {
-    return os << Internal::readExiv2Config(section, value.toString(), undefined);
+  if (auto label = Internal::readExiv2Config(section, value.toString(), undefined); label != undefined) {
+    return os << label;
   }
 
   const auto index = (value.toUint32(0) * 256) + value.toUint32(1);
@@ -211,7 +211,7 @@ void PngChunk::parseChunkContent(Image* pImage, const byte* key, size_t keySize,
         std::cout << "Exiv2::PngChunk::parseChunkContent: TIFF header found at position " << pos << "\n";
 #endif
         ByteOrder bo = TiffParser::decode(pImage->exifData(), pImage->iptcData(), pImage->xmpData(),
-                                          exifData.c_data(pos), length - pos);
+                                          exifData.c_data(pos), length - pos, pImage->readFilter());
         pImage->setByteOrder(bo);
       } else {
 #ifndef SUPPRESS_WARNINGS
@@ -244,14 +244,16 @@ void PngChunk::parseChunkContent(Image* pImage, const byte* key, size_t keySize,
         pCur = record + sizeHdr + sizeIptc;
         pCur += (sizeIptc & 1);
       }
-      if (!iptcBlob.empty() && IptcParser::decode(pImage->iptcData(), iptcBlob.data(), iptcBlob.size())) {
+      if (!iptcBlob.empty() &&
+          IptcParser::decode(pImage->iptcData(), iptcBlob.data(), iptcBlob.size(), pImage->readFilter())) {
 #ifndef SUPPRESS_WARNINGS
         EXV_WARNING << "Failed to decode IPTC metadata.\n";
 #endif
         pImage->clearIptcData();
       }
       // If there is no IRB, try to decode the complete chunk data
-      if (iptcBlob.empty() && IptcParser::decode(pImage->iptcData(), psData.c_data(), psData.size())) {
+      if (iptcBlob.empty() &&
+          IptcParser::decode(pImage->iptcData(), psData.c_data(), psData.size(), pImage->readFilter())) {
 #ifndef SUPPRESS_WARNINGS
         EXV_WARNING << "Failed to decode IPTC metadata.\n";
 #endif
@@ -275,7 +277,7 @@ void PngChunk::parseChunkContent(Image* pImage, const byte* key, size_t keySize,
 #endif
         xmpPacket = xmpPacket.substr(idx);
       }
-      if (XmpParser::decode(pImage->xmpData(), xmpPacket)) {
+      if (XmpParser::decode(pImage->xmpData(), xmpPacket, pImage->readFilter())) {
 #ifndef SUPPRESS_WARNINGS
         EXV_WARNING << "Failed to decode XMP metadata.\n";
 #endif
@@ -295,7 +297,7 @@ void PngChunk::parseChunkContent(Image* pImage, const byte* key, size_t keySize,
 #endif
       xmpPacket = xmpPacket.substr(idx);
     }
-    if (XmpParser::decode(pImage->xmpData(), xmpPacket)) {
+    if (XmpParser::decode(pImage->xmpData(), xmpPacket, pImage->readFilter())) {
 #ifndef SUPPRESS_WARNINGS
       EXV_WARNING << "Failed to decode XMP metadata.\n";
 #endif
@@ -400,6 +400,7 @@ void PngImage::readMetadata() {
     throw Error(ErrorCode::kerNotAnImage, "PNG");
   }
   clearMetadata();
+  recordReadFilter();
 
   const size_t imgSize = io_->size();
   DataBuf cheaderBuf(8);  // Chunk header: 4 bytes (data size) + 4 bytes (chunk type).
@@ -439,7 +440,8 @@ void PngImage::readMetadata() {
       } else if (chunkType == "iTXt") {
         PngChunk::decodeTXTChunk(this, chunkData, PngChunk::iTXt_Chunk);
       } else if (chunkType == "eXIf") {
-        ByteOrder bo = TiffParser::decode(exifData(), iptcData(), xmpData(), chunkData.c_data(), chunkData.size());
+        ByteOrder bo = TiffParser::decode(exifData(), iptcData(), xmpData(), chunkData.c_data(), chunkData.size(),
+                                          readFilter());
         setByteOrder(bo);
       } else if (chunkType == "iCCP") {
         // The ICC profile name can vary from 1-79 characters.
@@ -476,6 +478,7 @@ void PngImage::readMetadata() {
 }  // PngImage::readMetadata
 
 void PngImage::writeMetadata() {
+  enforceCompleteMetadata();
   if (io_->open() != 0) {
     throw Error(ErrorCode::kerDataSourceOpenFailed, io_->path(), strError());
   }
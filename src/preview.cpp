@@ -15,6 +15,7 @@
 
 #include <algorithm>
 #include <climits>
+#include <optional>
 
 namespace {
 using namespace Exiv2;
@@ -32,6 +33,64 @@ DataBuf decodeAi7Thumbnail(const DataBuf& src);
 /// @brief Create a PNM image from raw RGB data.
 DataBuf makePnm(size_t width, size_t height, const DataBuf& rgb);
 
+/// @brief Set the values of the entry \em tag in IFD0 of the little endian TIFF image \em tiff.
+void setTiffValues(DataBuf& tiff, uint16_t tag, const std::vector<uint32_t>& values);
+
+/*!
+  Destination of a preview image, which takes the data from buffers and from
+  byte ranges of the source image.
+ */
+class PreviewSink {
+ public:
+  //! Virtual destructor.
+  virtual ~PreviewSink() = default;
+
+  //! Write \em size bytes at \em data
+  virtual size_t write(const byte* data, size_t size) = 0;
+
+  //! Write \em size bytes at \em offset of the open IO source \em src
+  virtual size_t write(BasicIo& src, size_t offset, size_t size) = 0;
+};
+
+//! Sink that writes a preview image to a BasicIo instance
+class IoSink : public PreviewSink {
+ public:
+  //! Constructor
+  explicit IoSink(BasicIo& io) : io_(io) {
+  }
+
+  size_t write(const byte* data, size_t size) override {
+    return io_.write(data, size);
+  }
+
+  size_t write(BasicIo& src, size_t offset, size_t size) override {
+    return io_.writeRange(src, offset, size);
+  }
+
+ private:
+  BasicIo& io_;
+};
+
+//! Sink that writes a preview image to a file descriptor
+class FdSink : public PreviewSink {
+ public:
+  //! Constructor
+  explicit FdSink(int fd) : fd_(fd) {
+  }
+
+  size_t write(const byte* data, size_t size) override {
+    MemIo mio(data, size);
+    return sendRange(fd_, mio, 0, size);
+  }
+
+  size_t write(BasicIo& src, size_t offset, size_t size) override {
+    return sendRange(fd_, src, offset, size);
+  }
+
+ private:
+  int fd_;
+};
+
 /*!
   Base class for image loaders. Provides virtual methods for reading properties
   and DataBuf.
@@ -61,6 +120,19 @@ class Loader {
   //! Get a buffer that contains the preview image
   [[nodiscard]] virtual DataBuf getData() const = 0;
 
+  //! Get the size of the buffer returned by getData() without reading the preview image
+  [[nodiscard]] virtual size_t getSize() const {
+    return size_;
+  }
+
+  //! Get the position of the preview image in image_.io(), if it is stored there unchanged as one block
+  [[nodiscard]] virtual std::optional<size_t> getPosition() const {
+    return std::nullopt;
+  }
+
+  //! Write the data returned by getData() to \em sink, if possible without reading them into a buffer
+  virtual size_t writeData(PreviewSink& sink) const;
+
   //! Read preview image dimensions when they are not available directly
   virtual bool readDimensions() {
     return true;
@@ -117,6 +189,12 @@ class LoaderNative : public Loader {
   //! Get a buffer that contains the preview image
   [[nodiscard]] DataBuf getData() const override;
 
+  //! Get the size of the buffer returned by getData()
+  [[nodiscard]] size_t getSize() const override;
+
+  //! Get the position of the preview image in image_.io()
+  [[nodiscard]] std::optional<size_t> getPosition() const override;
+
   //! Read preview image dimensions
   bool readDimensions() override;
 
@@ -140,6 +218,11 @@ class LoaderExifJpeg : public Loader {
   //! Get a buffer that contains the preview image
   [[nodiscard]] DataBuf getData() const override;
 
+  //! Get the position of the preview image in image_.io()
+  [[nodiscard]] std::optional<size_t> getPosition() const override {
+    return offset_;
+  }
+
   //! Read preview image dimensions
   bool readDimensions() override;
 
@@ -205,7 +288,25 @@ class LoaderTiff : public Loader {
   //! Get a buffer that contains the preview image
   [[nodiscard]] DataBuf getData() const override;
 
+  //! Get the size of the buffer returned by getData()
+  [[nodiscard]] size_t getSize() const override;
+
+  //! Write the data returned by getData() to \em sink, with the image data copied from image_.io() strip by strip
+  size_t writeData(PreviewSink& sink) const override;
+
  protected:
+  //! Copy the TIFF image tags of the preview image to a new ExifData container
+  [[nodiscard]] ExifData copyTags() const;
+
+  //! Get the size of the image data that getData() reads from image_.io(), or 0 if it reads none
+  [[nodiscard]] size_t ioDataSize(const Value& offsets, const Value& sizes) const;
+
+  //! Write \em preview as a new TIFF image
+  [[nodiscard]] DataBuf encode(ExifData& preview) const;
+
+  //! Write \em preview as a new TIFF image without the image data, which getData() adds after the tags
+  [[nodiscard]] DataBuf encodeTags(ExifData& preview) const;
+
   //! Name of the group that contains the preview image
   const char* group_;
 
@@ -335,6 +436,21 @@ PreviewProperties Loader::getProperties() const {
   return {"", "", size_, width_, height_, id_};
 }
 
+size_t Loader::writeData(PreviewSink& sink) const {
+  if (auto position = getPosition()) {
+    if (const size_t size = getSize(); size != 0) {
+      BasicIo& io = image_.io();
+      if (io.open() != 0) {
+        throw Error(ErrorCode::kerDataSourceOpenFailed, io.path(), strError());
+      }
+      IoCloser closer(io);
+      return sink.write(io, *position, size);
+    }
+  }
+  const DataBuf buf = getData();
+  return sink.write(buf.c_data(), buf.size());
+}
+
 PreviewId Loader::getNumLoaders() {
   return PreviewId{std::size(loaderList_)};
 }
@@ -417,6 +533,21 @@ DataBuf LoaderNative::getData() const {
   throw Error(ErrorCode::kerErrorMessage, "Invalid native preview filter: ", nativePreview_.filter_);
 }
 
+size_t LoaderNative::getSize() const {
+  if (!nativePreview_.filter_.empty())
+    return size_;
+  // getData() returns no data if the preview is not within the image
+  if (image_.io().size() < nativePreview_.position_ + nativePreview_.size_)
+    return 0;
+  return size_;
+}
+
+std::optional<size_t> LoaderNative::getPosition() const {
+  if (!nativePreview_.filter_.empty())
+    return std::nullopt;
+  return nativePreview_.position_;
+}
+
 bool LoaderNative::readDimensions() {
   if (!valid())
     return false;
@@ -669,13 +800,9 @@ PreviewProperties LoaderTiff::getProperties() const {
   return prop;
 }
 
-DataBuf LoaderTiff::getData() const {
-  const ExifData& exifData = image_.exifData();
-
+ExifData LoaderTiff::copyTags() const {
   ExifData preview;
-
-  // copy tags
-  for (auto&& pos : exifData) {
+  for (auto&& pos : image_.exifData()) {
     if (pos.groupName() == group_) {
       /*
          Write only the necessary TIFF image tags
@@ -690,10 +817,54 @@ DataBuf LoaderTiff::getData() const {
       }
     }
   }
+  return preview;
+}
+
+size_t LoaderTiff::ioDataSize(const Value& offsets, const Value& sizes) const {
+  if (sizes.count() != offsets.count())
+    return 0;
+  const size_t ioSize = image_.io().size();
+  if (sizes.count() == 1) {
+    uint32_t offset = offsets.toUint32(0);
+    uint32_t size = sizes.toUint32(0);
+    return Safe::add(offset, size) <= static_cast<uint32_t>(ioSize) ? size : 0;
+  }
+  Internal::enforce(size_ <= ioSize, ErrorCode::kerCorruptedMetadata);
+  uint32_t idxBuf = 0;
+  for (size_t i = 0; i < sizes.count(); i++) {
+    uint32_t size = sizes.toUint32(i);
+
+    // the size_ parameter is originally computed by summing all values inside sizes
+    // see the constructor of LoaderTiff
+    // But e.g in malicious files some of these values could be negative
+    // That's why we check again for each step here to really make sure we don't overstep
+    Internal::enforce(Safe::add(idxBuf, size) <= size_, ErrorCode::kerCorruptedMetadata);
+    idxBuf += size;
+  }
+  return size_;
+}
+
+DataBuf LoaderTiff::encode(ExifData& preview) const {
+  // Fix compression value in the CR2 IFD2 image
+  if (0 == strcmp(group_, "Image2") && image_.mimeType() == "image/x-canon-cr2") {
+    preview["Exif.Image.Compression"] = std::uint16_t{1};
+  }
+
+  // write new image
+  MemIo mio;
+  IptcData emptyIptc;
+  XmpData emptyXmp;
+  TiffParser::encode(mio, nullptr, 0, Exiv2::littleEndian, preview, emptyIptc, emptyXmp);
+  return {mio.mmap(), mio.size()};
+}
+
+DataBuf LoaderTiff::getData() const {
+  ExifData preview = copyTags();
 
   auto& dataValue = const_cast<Value&>(preview["Exif.Image." + offsetTag_].value());
+  const Value& sizes = preview["Exif.Image." + sizeTag_].value();
 
-  if (dataValue.sizeDataArea() == 0) {
+  if (dataValue.sizeDataArea() == 0 && ioDataSize(dataValue, sizes) != 0) {
     // image data are not available via exifData, read them from image_.io()
     BasicIo& io = image_.io();
 
@@ -704,51 +875,120 @@ DataBuf LoaderTiff::getData() const {
 
     const Exiv2::byte* base = io.mmap();
 
-    const Value& sizes = preview["Exif.Image." + sizeTag_].value();
-
-    if (sizes.count() == dataValue.count()) {
-      if (sizes.count() == 1) {
-        // this saves one copying of the buffer
-        uint32_t offset = dataValue.toUint32(0);
-        uint32_t size = sizes.toUint32(0);
-        if (Safe::add(offset, size) <= static_cast<uint32_t>(io.size()))
-          dataValue.setDataArea(base + offset, size);
-      } else {
-        // FIXME: the buffer is probably copied twice, it should be optimized
-        Internal::enforce(size_ <= io.size(), ErrorCode::kerCorruptedMetadata);
-        DataBuf buf(size_);
-        uint32_t idxBuf = 0;
-        for (size_t i = 0; i < sizes.count(); i++) {
-          uint32_t offset = dataValue.toUint32(i);
-          uint32_t size = sizes.toUint32(i);
-
-          // the size_ parameter is originally computed by summing all values inside sizes
-          // see the constructor of LoaderTiff
-          // But e.g in malicious files some of these values could be negative
-          // That's why we check again for each step here to really make sure we don't overstep
-          Internal::enforce(Safe::add(idxBuf, size) <= size_, ErrorCode::kerCorruptedMetadata);
-          if (size != 0 && Safe::add(offset, size) <= static_cast<uint32_t>(io.size())) {
-            std::copy_n(base + offset, size, buf.begin() + idxBuf);
-          }
-
-          idxBuf += size;
+    if (sizes.count() == 1) {
+      // this saves one copying of the buffer
+      dataValue.setDataArea(base + dataValue.toUint32(0), sizes.toUint32(0));
+    } else {
+      // FIXME: the buffer is probably copied twice, it should be optimized
+      DataBuf buf(size_);
+      uint32_t idxBuf = 0;
+      for (size_t i = 0; i < sizes.count(); i++) {
+        uint32_t offset = dataValue.toUint32(i);
+        uint32_t size = sizes.toUint32(i);
+        if (size != 0 && Safe::add(offset, size) <= static_cast<uint32_t>(io.size())) {
+          std::copy_n(base + offset, size, buf.begin() + idxBuf);
         }
-        dataValue.setDataArea(buf.c_data(), buf.size());
+
+        idxBuf += size;
       }
+      dataValue.setDataArea(buf.c_data(), buf.size());
     }
   }
 
-  // Fix compression value in the CR2 IFD2 image
-  if (0 == strcmp(group_, "Image2") && image_.mimeType() == "image/x-canon-cr2") {
-    preview["Exif.Image.Compression"] = std::uint16_t{1};
+  return encode(preview);
+}
+
+DataBuf LoaderTiff::encodeTags(ExifData& preview) const {
+  auto& dataValue = const_cast<Value&>(preview["Exif.Image." + offsetTag_].value());
+  const Value& sizes = preview["Exif.Image." + sizeTag_].value();
+
+  // Encode the tags with a two byte stand-in for the image data, which the
+  // encoder writes after the tags (see TiffImageEntry::doWriteImage)
+  std::string standInSizes = "2";
+  for (size_t i = 1; i < sizes.count(); i++)
+    standInSizes += " 0";
+  auto standInValue = sizes.clone();
+  standInValue->read(standInSizes);
+  preview["Exif.Image." + sizeTag_].setValue(standInValue.get());
+  const byte standIn[2] = {};
+  dataValue.setDataArea(standIn, sizeof(standIn));
+
+  DataBuf tiff = encode(preview);
+  tiff.resize(tiff.size() - sizeof(standIn));
+  return tiff;
+}
+
+size_t LoaderTiff::getSize() const {
+  ExifData preview = copyTags();
+
+  const Value& dataValue = preview["Exif.Image." + offsetTag_].value();
+  size_t dataSize = dataValue.sizeDataArea();
+  if (dataSize == 0)
+    dataSize = ioDataSize(dataValue, preview["Exif.Image." + sizeTag_].value());
+  if (dataSize == 0)
+    return encode(preview).size();
+
+  // The image data are aligned to a word boundary
+  return encodeTags(preview).size() + dataSize + (dataSize & 1);
+}
+
+size_t LoaderTiff::writeData(PreviewSink& sink) const {
+  ExifData preview = copyTags();
+
+  const Value& dataValue = preview["Exif.Image." + offsetTag_].value();
+  const Value& sizes = preview["Exif.Image." + sizeTag_].value();
+  if (dataValue.sizeDataArea() != 0 || ioDataSize(dataValue, sizes) == 0)
+    return Loader::writeData(sink);
+
+  std::vector<std::pair<uint32_t, uint32_t>> strips;
+  for (size_t i = 0; i < sizes.count(); i++) {
+    strips.emplace_back(dataValue.toUint32(i), sizes.toUint32(i));
+  }
+  const uint16_t offsetTag = ExifKey("Exif.Image." + offsetTag_).tag();
+  const uint16_t sizeTag = ExifKey("Exif.Image." + sizeTag_).tag();
+  DataBuf tiff = encodeTags(preview);
+
+  // Set the offsets and sizes of the strips in place of those of the stand-in,
+  // the same way the encoder sets them for the image data read by getData()
+  std::vector<uint32_t> offsets;
+  std::vector<uint32_t> stripSizes;
+  size_t dataSize = 0;
+  for (auto&& [_, size] : strips) {
+    offsets.push_back(static_cast<uint32_t>(Safe::add(tiff.size(), dataSize)));
+    stripSizes.push_back(size);
+    dataSize = Safe::add<size_t>(dataSize, Safe::add<size_t>(size, size & 1));
   }
+  setTiffValues(tiff, offsetTag, offsets);
+  setTiffValues(tiff, sizeTag, stripSizes);
+  size_t written = sink.write(tiff.c_data(), tiff.size());
 
-  // write new image
-  MemIo mio;
-  IptcData emptyIptc;
-  XmpData emptyXmp;
-  TiffParser::encode(mio, nullptr, 0, Exiv2::littleEndian, preview, emptyIptc, emptyXmp);
-  return {mio.mmap(), mio.size()};
+  BasicIo& io = image_.io();
+  if (io.open() != 0) {
+    throw Error(ErrorCode::kerDataSourceOpenFailed, io.path(), strError());
+  }
+  IoCloser closer(io);
+
+  // Like getData(), write the strips one after the other and strips which are
+  // not within the image as zeros, then align the image data to a word boundary
+  const byte zeros[4096] = {};
+  auto writeZeros = [&](size_t count) {
+    for (size_t n = 0; n < count;) {
+      const size_t chunk = std::min(count - n, sizeof(zeros));
+      written += sink.write(zeros, chunk);
+      n += chunk;
+    }
+  };
+  dataSize = 0;
+  for (auto&& [offset, size] : strips) {
+    if (size != 0 && Safe::add(offset, size) <= static_cast<uint32_t>(io.size())) {
+      written += sink.write(io, offset, size);
+    } else {
+      writeZeros(size);
+    }
+    dataSize += size;
+  }
+  writeZeros(dataSize & 1);
+  return written;
 }
 
 LoaderXmpJpeg::LoaderXmpJpeg(PreviewId id, const Image& image, int parIdx) : Loader(id, image) {
@@ -922,6 +1162,29 @@ DataBuf decodeAi7Thumbnail(const DataBuf& src) {
   return {reinterpret_cast<const byte*>(dest.data()), dest.size()};
 }
 
+void setTiffValues(DataBuf& tiff, uint16_t tag, const std::vector<uint32_t>& values) {
+  const size_t ifd = tiff.read_uint32(4, littleEndian);
+  const size_t count = tiff.read_uint16(ifd, littleEndian);
+  for (size_t entry = ifd + 2; entry < ifd + 2 + (12 * count); entry += 12) {
+    if (tiff.read_uint16(entry, littleEndian) != tag)
+      continue;
+    const bool isShort = tiff.read_uint16(entry + 2, littleEndian) == unsignedShort;
+    Internal::enforce(tiff.read_uint32(entry + 4, littleEndian) == values.size(), ErrorCode::kerImageWriteFailed);
+    const size_t valueSize = isShort ? 2 : 4;
+    size_t idx = values.size() * valueSize <= 4 ? entry + 8 : tiff.read_uint32(entry + 8, littleEndian);
+    for (auto value : values) {
+      if (isShort) {
+        tiff.write_uint16(idx, static_cast<uint16_t>(value), littleEndian);
+      } else {
+        tiff.write_uint32(idx, value, littleEndian);
+      }
+      idx += valueSize;
+    }
+    return;
+  }
+  throw Error(ErrorCode::kerImageWriteFailed);
+}
+
 DataBuf makePnm(size_t width, size_t height, const DataBuf& rgb) {
   DataBuf dest;
   if (size_t expectedSize = width * height * 3UL; rgb.size() != expectedSize) {
@@ -949,23 +1212,35 @@ PreviewImage::PreviewImage(PreviewProperties properties, DataBuf&& data) :
     properties_(std::move(properties)), preview_(std::move(data)) {
 }
 
-PreviewImage::PreviewImage(const PreviewImage& rhs) : properties_(rhs.properties_), preview_(rhs.pData(), rhs.size()) {
+PreviewImage::PreviewImage(PreviewProperties properties, std::shared_ptr<const byte> view, size_t size) :
+    properties_(std::move(properties)), view_(std::move(view)), viewSize_(size) {
+}
+
+PreviewImage::PreviewImage(const PreviewImage& rhs) :
+    properties_(rhs.properties_),
+    preview_(rhs.preview_.c_data(), rhs.preview_.size()),
+    view_(rhs.view_),
+    viewSize_(rhs.viewSize_) {
 }
 
 PreviewImage& PreviewImage::operator=(const PreviewImage& rhs) {
   if (this == &rhs)
     return *this;
   properties_ = rhs.properties_;
-  preview_ = DataBuf(rhs.pData(), rhs.size());
+  preview_ = DataBuf(rhs.preview_.c_data(), rhs.preview_.size());
+  view_ = rhs.view_;
+  viewSize_ = rhs.viewSize_;
   return *this;
 }
 
 #ifdef EXV_ENABLE_FILESYSTEM
 size_t PreviewImage::writeFile(const std::string& path) const {
   std::string name = path + extension();
-  // Todo: Creating a DataBuf here unnecessarily copies the memory
-  DataBuf buf(pData(), size());
-  return Exiv2::writeFile(buf, name);
+  FileIo file(name);
+  if (file.open("wb") != 0) {
+    throw Error(ErrorCode::kerFileOpenFailed, name, "wb", strError());
+  }
+  return file.write(pData(), size());
 }
 #endif
 
@@ -974,13 +1249,21 @@ DataBuf PreviewImage::copy() const {
 }
 
 const byte* PreviewImage::pData() const {
+  if (view_)
+    return view_.get();
   return preview_.c_data();
 }
 
 uint32_t PreviewImage::size() const {
+  if (view_)
+    return static_cast<uint32_t>(viewSize_);
   return static_cast<uint32_t>(preview_.size());
 }
 
+bool PreviewImage::isView() const {
+  return view_ != nullptr;
+}
+
 std::string PreviewImage::mimeType() const {
   return properties_.mimeType_;
 }
@@ -1011,8 +1294,7 @@ PreviewPropertiesList PreviewManager::getPreviewProperties() const {
     auto loader = Loader::create(id, image_);
     if (loader && loader->readDimensions()) {
       PreviewProperties props = loader->getProperties();
-      DataBuf buf = loader->getData();  // #16 getPreviewImage()
-      props.size_ = buf.size();         //     update the size
+      props.size_ = loader->getSize();  // #16 the size of getPreviewImage()
       list.push_back(std::move(props));
     }
   }
@@ -1031,4 +1313,44 @@ PreviewImage PreviewManager::getPreviewImage(const PreviewProperties& properties
 
   return {properties, std::move(buf)};
 }
+
+size_t PreviewManager::writePreviewImage(const PreviewProperties& properties, BasicIo& io) const {
+  auto loader = Loader::create(properties.id_, image_);
+  if (!loader)
+    return 0;
+  IoSink sink(io);
+  return loader->writeData(sink);
+}
+
+size_t PreviewManager::writePreviewImage(const PreviewProperties& properties, int fd) const {
+  auto loader = Loader::create(properties.id_, image_);
+  if (!loader)
+    return 0;
+  FdSink sink(fd);
+  return loader->writeData(sink);
+}
+
+PreviewImage PreviewManager::getPreviewImageView(const PreviewProperties& properties) const {
+  auto loader = Loader::create(properties.id_, image_);
+  if (!loader)
+    return {properties, DataBuf()};
+
+#ifdef EXV_ENABLE_FILESYSTEM
+  auto position = loader->getPosition();
+  const size_t size = loader->getSize();
+  if (position && size != 0 && dynamic_cast<const FileIo*>(&image_.io())) {
+    // Map the file with an io of its own, which is independent of the state of image_.io()
+    auto io = std::make_shared<FileIo>(image_.io().path());
+    if (io->open() != 0) {
+      throw Error(ErrorCode::kerDataSourceOpenFailed, io->path(), strError());
+    }
+    if (Safe::add(*position, size) <= io->size()) {
+      const byte* base = io->mmap();
+      return {properties, std::shared_ptr<const byte>(io, base + *position), size};
+    }
+  }
+#endif
+
+  return {properties, loader->getData()};
+}
 }  // namespace Exiv2
@@ -13,7 +13,11 @@
 #include "value.hpp"
 #include "xmp_exiv2.hpp"
 
+#include <atomic>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <unordered_map>
 
 namespace {
 //! Struct used in the lookup table for pretty print functions
@@ -27,6 +31,115 @@ struct XmpPrintInfo {
   Exiv2::PrintFct printFct_;  //!< Print function
 };
 
+//! Copy of a custom namespace, with its own strings
+struct NsEntry {
+  explicit NsEntry(const Exiv2::XmpNsInfo& info) : ns_(info.ns_), prefix_(info.prefix_), info_(info) {
+    info_.ns_ = ns_.c_str();
+    info_.prefix_ = prefix_.c_str();
+  }
+  NsEntry(const NsEntry&) = delete;
+  NsEntry& operator=(const NsEntry&) = delete;
+
+  std::string ns_;         //!< Namespace
+  std::string prefix_;     //!< Prefix
+  Exiv2::XmpNsInfo info_;  //!< The entry, refers to the strings above
+};
+
+/*!
+  @brief Immutable copy of the custom namespace registry.
+
+  Readers look up custom namespaces in a snapshot without taking a lock.
+  Writers modify XmpProperties::nsRegistry_ under XmpProperties::mutex_ and
+  publish a new snapshot afterwards. Snapshots share the entries of the
+  namespaces which did not change, so that pointers to an entry stay valid
+  until its namespace is unregistered, like pointers into the registry itself.
+ */
+struct NsSnapshot {
+  //! Entries keyed by namespace
+  std::map<std::string_view, std::shared_ptr<const NsEntry>> entries_;
+
+  //! Return the entry registered with \em prefix or nullptr
+  [[nodiscard]] const Exiv2::XmpNsInfo* lookup(std::string_view prefix) const {
+    for (const auto& [_, e] : entries_) {
+      if (e->prefix_ == prefix)
+        return &e->info_;
+    }
+    return nullptr;
+  }
+};
+
+//! Number of snapshots published, tells readers whether their copy of the snapshot is current
+std::atomic<uint64_t> nsGeneration{0};
+#ifdef __cpp_lib_atomic_shared_ptr
+//! Current snapshot of the registry, nullptr if there are no custom namespaces
+std::atomic<std::shared_ptr<const NsSnapshot>> nsSnapshot;
+
+std::shared_ptr<const NsSnapshot> currentNsSnapshot() {
+  return nsSnapshot.load();
+}
+
+void storeNsSnapshot(std::shared_ptr<const NsSnapshot> snapshot) {
+  nsSnapshot.store(std::move(snapshot));
+  nsGeneration.fetch_add(1, std::memory_order_release);
+}
+#else
+//! Current snapshot of the registry, nullptr if there are no custom namespaces
+std::shared_ptr<const NsSnapshot> nsSnapshot;
+
+std::shared_ptr<const NsSnapshot> currentNsSnapshot() {
+  return std::atomic_load(&nsSnapshot);
+}
+
+void storeNsSnapshot(std::shared_ptr<const NsSnapshot> snapshot) {
+  std::atomic_store(&nsSnapshot, std::move(snapshot));
+  nsGeneration.fetch_add(1, std::memory_order_release);
+}
+#endif
+
+/*!
+  @brief Return the snapshot of the registry for lookups in this thread,
+         nullptr if there are no custom namespaces.
+
+  Each thread keeps a copy of the snapshot and loads the current one only
+  after the registry changed: loading a shared_ptr atomically takes a lock
+  in some standard libraries, and copying it contends on its reference
+  count. The copy also keeps the entries which the thread looked up alive
+  until its next lookup, even if another thread unregisters them meanwhile.
+ */
+const std::shared_ptr<const NsSnapshot>& loadNsSnapshot() {
+  thread_local std::shared_ptr<const NsSnapshot> snapshot;
+  thread_local uint64_t generation = 0;
+  const auto current = nsGeneration.load(std::memory_order_acquire);
+  if (generation != current) {
+    snapshot = currentNsSnapshot();
+    generation = current;
+  }
+  return snapshot;
+}
+
+//! Publish a snapshot of XmpProperties::nsRegistry_. Requires XmpProperties::mutex_.
+void publishNsSnapshot() {
+  const auto& registry = Exiv2::XmpProperties::nsRegistry_;
+  if (registry.empty()) {
+    storeNsSnapshot(nullptr);
+    return;
+  }
+  const auto previous = currentNsSnapshot();
+  auto snapshot = std::make_shared<NsSnapshot>();
+  for (const auto& [ns, info] : registry) {
+    std::shared_ptr<const NsEntry> entry;
+    if (previous) {
+      auto i = previous->entries_.find(ns);
+      if (i != previous->entries_.end() && i->second->prefix_ == info.prefix_)
+        entry = i->second;
+    }
+    if (!entry)
+      entry = std::make_shared<const NsEntry>(info);
+    snapshot->entries_.try_emplace(entry->ns_, std::move(entry));
+  }
+  storeNsSnapshot(std::move(snapshot));
+}
+
 }  // namespace
 
 // *****************************************************************************
@@ -4949,13 +5062,100 @@ bool XmpPropertyInfo::operator==(const std::string& name) const {
   return name_ == name;
 }
 
+struct XmpKey::Impl {
+  Impl() = default;                                              //!< Default constructor
+  Impl(const std::string& prefix, const std::string& property);  //!< Constructor
+
+  /*!
+    @brief Parse and convert the \em key string into property and prefix.
+           Updates data members if the string can be decomposed, or throws
+           \em Error.
+
+    @throw Error if the key cannot be decomposed.
+  */
+  void decomposeKey(const std::string& key);  //!< Mysterious magic
+  /*!
+    @brief Locate the innermost element of the property. If the property is a
+           path to a nested property (like \c RegionInfo/MPRI:Regions), this
+           is the last element of the path, which may have its own prefix.
+  */
+  void parsePath();
+  //! Return the prefix of the innermost element of the property
+  [[nodiscard]] std::string_view propertyPrefix() const;
+  //! Return the name of the innermost element of the property
+  [[nodiscard]] std::string_view propertyName() const;
+
+  // DATA
+  static constexpr auto familyName_ = "Xmp";  //!< "Xmp"
+
+  std::string prefix_;                   //!< Prefix
+  std::string property_;                 //!< Property name
+  size_t namePos_{0};                    //!< Position of the innermost element in property_
+  size_t prefixPos_{std::string::npos};  //!< Position of its own prefix in property_, npos if none
+};
+
+namespace {
+//! Key of a property in the index of built-in properties
+struct PropertyKey {
+  const XmpPropertyInfo* list_;  //!< Property list of the namespace
+  std::string_view name_;        //!< Property name
+
+  bool operator==(const PropertyKey& rhs) const = default;
+};
+
+//! Hash function for PropertyKey
+struct PropertyKeyHash {
+  size_t operator()(const PropertyKey& key) const noexcept {
+    return std::hash<const XmpPropertyInfo*>()(key.list_) ^ std::hash<std::string_view>()(key.name_);
+  }
+};
+
+//! Hash indexes of the built-in namespace and property tables, built once on first use
+struct BuiltinIndex {
+  BuiltinIndex();
+
+  // DATA
+  std::unordered_map<std::string_view, const XmpNsInfo*> byPrefix_;                      //!< Namespaces by prefix
+  std::unordered_map<std::string_view, const XmpNsInfo*> byNs_;                          //!< Namespaces by URI
+  std::unordered_map<PropertyKey, const XmpPropertyInfo*, PropertyKeyHash> properties_;  //!< Properties
+};
+
+BuiltinIndex::BuiltinIndex() {
+  // Like a linear search of the tables, the first entry of duplicates wins
+  for (auto&& xn : xmpNsInfo) {
+    byPrefix_.try_emplace(xn.prefix_, &xn);
+    byNs_.try_emplace(xn.ns_, &xn);
+    for (auto pi = xn.xmpPropertyInfo_; pi && pi->name_; ++pi) {
+      properties_.try_emplace(PropertyKey{xn.xmpPropertyInfo_, pi->name_}, pi);
+    }
+  }
+}
+
+const BuiltinIndex& builtinIndex() {
+  static const BuiltinIndex index;
+  return index;
+}
+
+//! Return the namespace information for \em prefix, custom namespaces first, or nullptr
+const XmpNsInfo* findNsInfo(std::string_view prefix) {
+  if (const auto& snapshot = loadNsSnapshot()) {
+    if (auto xn = snapshot->lookup(prefix))
+      return xn;
+  }
+  const auto& byPrefix = builtinIndex().byPrefix_;
+  auto i = byPrefix.find(prefix);
+  return i != byPrefix.end() ? i->second : nullptr;
+}
+}  // namespace
+
 XmpProperties::NsRegistry XmpProperties::nsRegistry_;
 std::mutex XmpProperties::mutex_;
 
 /// \todo not used internally. At least we should test it
 const XmpNsInfo* XmpProperties::lookupNsRegistry(const XmpNsInfo::Prefix& prefix) {
-  auto scopedReadLock = std::scoped_lock(mutex_);
-  return lookupNsRegistryUnsafe(prefix);
+  if (const auto& snapshot = loadNsSnapshot())
+    return snapshot->lookup(prefix.prefix_);
+  return nullptr;
 }
 
 const XmpNsInfo* XmpProperties::lookupNsRegistryUnsafe(const XmpNsInfo::Prefix& prefix) {
@@ -4992,11 +5192,13 @@ void XmpProperties::registerNs(const std::string& ns, const std::string& prefix)
   xn.xmpPropertyInfo_ = nullptr;
   xn.desc_ = "";
   nsRegistry_[ns2] = xn;
+  publishNsSnapshot();
 }
 
 void XmpProperties::unregisterNs(const std::string& ns) {
   auto scoped_write_lock = std::scoped_lock(mutex_);
   unregisterNsUnsafe(ns);
+  publishNsSnapshot();
 }
 
 void XmpProperties::unregisterNsUnsafe(const std::string& ns) {
@@ -5016,28 +5218,26 @@ void XmpProperties::unregisterNs() {
     auto kill = i++;
     unregisterNsUnsafe(kill->first);
   }
+  publishNsSnapshot();
 }
 
 std::string XmpProperties::prefix(const std::string& ns) {
-  auto scoped_read_lock = std::scoped_lock(mutex_);
   std::string ns2 = ns;
   if (ns2.back() != '/' && ns2.back() != '#')
     ns2 += '/';
 
-  auto i = nsRegistry_.find(ns2);
-  std::string p;
-  if (i != nsRegistry_.end())
-    p = i->second.prefix_;
-  else if (auto xn = Exiv2::find(xmpNsInfo, XmpNsInfo::Ns{std::move(ns2)}))
-    p = std::string(xn->prefix_);
-  return p;
+  if (const auto& snapshot = loadNsSnapshot()) {
+    if (auto i = snapshot->entries_.find(ns2); i != snapshot->entries_.end())
+      return i->second->prefix_;
+  }
+  const auto& byNs = builtinIndex().byNs_;
+  if (auto i = byNs.find(ns2); i != byNs.end())
+    return i->second->prefix_;
+  return {};
 }
 
 std::string XmpProperties::ns(const std::string& prefix) {
-  auto scoped_read_lock = std::scoped_lock(mutex_);
-  if (auto xn = lookupNsRegistryUnsafe(XmpNsInfo::Prefix{prefix}))
-    return xn->ns_;
-  return nsInfoUnsafe(prefix)->ns_;
+  return nsInfo(prefix)->ns_;
 }
 
 const char* XmpProperties::propertyTitle(const XmpKey& key) {
@@ -5056,29 +5256,21 @@ TypeId XmpProperties::propertyType(const XmpKey& key) {
 }
 
 const XmpPropertyInfo* XmpProperties::propertyInfo(const XmpKey& key) {
-  std::string prefix = key.groupName();
-  std::string property = key.tagName();
-  // If property is a path for a nested property, determines the innermost element
-  if (auto i = property.find_last_of('/'); i != std::string::npos) {
-    i = std::distance(property.begin(), std::find_if(property.begin() + i, property.end(), isalpha));
-    property = property.substr(i);
-    i = property.find_first_of(':');
-    if (i != std::string::npos) {
-      prefix = property.substr(0, i);
-      property = property.substr(i + 1);
-    }
+  // If property is a path for a nested property, the key has located the innermost element
+  const auto prefix = key.p_->propertyPrefix();
+  const auto property = key.p_->propertyName();
 #ifdef EXIV2_DEBUG_MESSAGES
+  if (key.p_->namePos_ != 0)
     std::cout << "Nested key: " << key.key() << ", prefix: " << prefix << ", property: " << property << "\n";
 #endif
-  }
-  if (auto pl = propertyList(prefix)) {
-    for (size_t j = 0; pl[j].name_; ++j) {
-      if (property == pl[j].name_) {
-        return pl + j;
-      }
-    }
-  }
-  return nullptr;
+  auto xn = findNsInfo(prefix);
+  if (!xn)
+    throw Error(ErrorCode::kerNoNamespaceInfoForXmpPrefix, std::string(prefix));
+  if (!xn->xmpPropertyInfo_)
+    return nullptr;
+  const auto& properties = builtinIndex().properties_;
+  auto i = properties.find(PropertyKey{xn->xmpPropertyInfo_, property});
+  return i != properties.end() ? i->second : nullptr;
 }
 
 /// \todo not used internally. At least we should test it
@@ -5091,15 +5283,7 @@ const XmpPropertyInfo* XmpProperties::propertyList(const std::string& prefix) {
 }
 
 const XmpNsInfo* XmpProperties::nsInfo(const std::string& prefix) {
-  auto scoped_read_lock = std::scoped_lock(mutex_);
-  return nsInfoUnsafe(prefix);
-}
-
-const XmpNsInfo* XmpProperties::nsInfoUnsafe(const std::string& prefix) {
-  const auto pf = XmpNsInfo::Prefix{prefix};
-  const XmpNsInfo* xn = lookupNsRegistryUnsafe(pf);
-  if (!xn)
-    xn = Exiv2::find(xmpNsInfo, pf);
+  const XmpNsInfo* xn = findNsInfo(prefix);
   if (!xn)
     throw Error(ErrorCode::kerNoNamespaceInfoForXmpPrefix, prefix);
   return xn;
@@ -5131,25 +5315,6 @@ std::ostream& XmpProperties::printProperty(std::ostream& os, const std::string&
 }
 
 //! @brief Internal Pimpl structure with private members and data of class XmpKey.
-struct XmpKey::Impl {
-  Impl() = default;                                              //!< Default constructor
-  Impl(const std::string& prefix, const std::string& property);  //!< Constructor
-
-  /*!
-    @brief Parse and convert the \em key string into property and prefix.
-           Updates data members if the string can be decomposed, or throws
-           \em Error.
-
-    @throw Error if the key cannot be decomposed.
-  */
-  void decomposeKey(const std::string& key);  //!< Mysterious magic
-
-  // DATA
-  static constexpr auto familyName_ = "Xmp";  //!< "Xmp"
-
-  std::string prefix_;    //!< Prefix
-  std::string property_;  //!< Property name
-};
 
 //! @brief Constructor for Internal Pimpl structure XmpKey::Impl::Impl
 XmpKey::Impl::Impl(const std::string& prefix, const std::string& property) {
@@ -5159,6 +5324,7 @@ XmpKey::Impl::Impl(const std::string& prefix, const std::string& property) {
 
   property_ = property;
   prefix_ = prefix;
+  parsePath();
 }
 
 XmpKey::XmpKey(const std::string& key) : p_(std::make_unique<Impl>()) {
@@ -5249,8 +5415,34 @@ void XmpKey::Impl::decomposeKey(const std::string& key) {
 
   property_ = std::move(property);
   prefix_ = std::move(prefix);
+  parsePath();
 }  // XmpKey::Impl::decomposeKey
 
+void XmpKey::Impl::parsePath() {
+  namePos_ = 0;
+  prefixPos_ = std::string::npos;
+  auto i = property_.find_last_of('/');
+  if (i == std::string::npos)
+    return;
+  i = std::distance(property_.begin(), std::find_if(property_.begin() + i, property_.end(), isalpha));
+  if (auto colon = property_.find(':', i); colon != std::string::npos) {
+    prefixPos_ = i;
+    namePos_ = colon + 1;
+  } else {
+    namePos_ = i;
+  }
+}
+
+std::string_view XmpKey::Impl::propertyPrefix() const {
+  if (prefixPos_ == std::string::npos)
+    return prefix_;
+  return std::string_view(property_).substr(prefixPos_, namePos_ - 1 - prefixPos_);
+}
+
+std::string_view XmpKey::Impl::propertyName() const {
+  return std::string_view(property_).substr(namePos_);
+}
+
 // *************************************************************************
 // free functions
 // *************************************************************************
@@ -124,6 +124,7 @@ void PsdImage::readMetadata() {
     throw Error(ErrorCode::kerNotAnImage, "Photoshop");
   }
   clearMetadata();
+  recordReadFilter();
 
   /*
     The Photoshop header goes as follows -- all numbers are in big-endian byte order:
@@ -214,7 +215,7 @@ void PsdImage::readResourceBlock(uint16_t resourceId, uint32_t resourceSize) {
       io_->read(rawIPTC.data(), rawIPTC.size());
       if (io_->error() || io_->eof())
         throw Error(ErrorCode::kerFailedToReadImageData);
-      if (IptcParser::decode(iptcData_, rawIPTC.c_data(), rawIPTC.size())) {
+      if (IptcParser::decode(iptcData_, rawIPTC.c_data(), rawIPTC.size(), readFilter())) {
 #ifndef SUPPRESS_WARNINGS
         EXV_WARNING << "Failed to decode IPTC metadata.\n";
 #endif
@@ -228,7 +229,7 @@ void PsdImage::readResourceBlock(uint16_t resourceId, uint32_t resourceSize) {
       io_->read(rawExif.data(), rawExif.size());
       if (io_->error() || io_->eof())
         throw Error(ErrorCode::kerFailedToReadImageData);
-      ByteOrder bo = ExifParser::decode(exifData_, rawExif.c_data(), rawExif.size());
+      ByteOrder bo = ExifParser::decode(exifData_, rawExif.c_data(), rawExif.size(), readFilter());
       setByteOrder(bo);
       if (!rawExif.empty() && byteOrder() == invalidByteOrder) {
 #ifndef SUPPRESS_WARNINGS
@@ -245,7 +246,7 @@ void PsdImage::readResourceBlock(uint16_t resourceId, uint32_t resourceSize) {
       if (io_->error() || io_->eof())
         throw Error(ErrorCode::kerFailedToReadImageData);
       xmpPacket_.assign(xmpPacket.c_str(), xmpPacket.size());
-      if (!xmpPacket_.empty() && XmpParser::decode(xmpData_, xmpPacket_)) {
+      if (!xmpPacket_.empty() && XmpParser::decode(xmpData_, xmpPacket_, readFilter())) {
 #ifndef SUPPRESS_WARNINGS
         EXV_WARNING << "Failed to decode XMP metadata.\n";
 #endif
@@ -305,6 +306,7 @@ void PsdImage::readResourceBlock(uint16_t resourceId, uint32_t resourceSize) {
 }  // PsdImage::readResourceBlock
 
 void PsdImage::writeMetadata() {
+  enforceCompleteMetadata();
   if (io_->open() != 0) {
     throw Error(ErrorCode::kerDataSourceOpenFailed, io_->path(), strError());
   }
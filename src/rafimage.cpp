@@ -263,6 +263,7 @@ void RafImage::readMetadata() {
   }
 
   clearMetadata();
+  recordReadFilter();
 
   if (io_->seek(84, BasicIo::beg) != 0)
     throw Error(ErrorCode::kerFailedToReadImageData);
@@ -341,11 +342,12 @@ void RafImage::readMetadata() {
   const std::array<byte, 4> Id1{0x49, 0x49, 0x2A, 0x00};
   const std::array<byte, 4> Id2{0x4D, 0x4D, 0x00, 0x2A};
   if (readBuff == Id1 || readBuff == Id2) {
+    // The TIFF data holds the raw image, too large to lend to the values
     DataBuf tiff(tiffLength);
     io_->read(tiff.data(), tiff.size());
 
     if (!io_->error() && !io_->eof()) {
-      TiffParser::decode(exifData_, iptcData_, xmpData_, tiff.c_data(), tiff.size());
+      TiffParser::decode(exifData_, iptcData_, xmpData_, tiff.c_data(), tiff.size(), readFilter());
     }
   }
 }
@@ -90,7 +90,8 @@ void Rw2Image::readMetadata() {
     throw Error(ErrorCode::kerNotAnImage, "RW2");
   }
   clearMetadata();
-  ByteOrder bo = Rw2Parser::decode(exifData_, iptcData_, xmpData_, io_->mmap(), io_->size());
+  recordReadFilter();
+  ByteOrder bo = Rw2Parser::decode(exifData_, iptcData_, xmpData_, io_->mmap(), io_->size(), readFilter());
   setByteOrder(bo);
 
   // A lot more metadata is hidden in the embedded preview image
@@ -179,15 +180,35 @@ void Rw2Image::readMetadata() {
 
 }  // Rw2Image::readMetadata
 
+void Rw2Image::scanExif(ExifScan& scan) {
+  if (io_->open() != 0) {
+    throw Error(ErrorCode::kerDataSourceOpenFailed, io_->path(), strError());
+  }
+  IoCloser closer(*io_);
+  // Ensure that this is the correct image type
+  if (!isRw2Type(*io_, false)) {
+    if (io_->error() || io_->eof())
+      throw Error(ErrorCode::kerFailedToReadImageData);
+    throw Error(ErrorCode::kerNotAnImage, "RW2");
+  }
+  Rw2Parser::scan(scan, io_->mmap(), io_->size());
+}
+
 void Rw2Image::writeMetadata() {
   // Todo: implement me!
   throw(Error(ErrorCode::kerWritingImageFormatUnsupported, "RW2"));
 }  // Rw2Image::writeMetadata
 
-ByteOrder Rw2Parser::decode(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, const byte* pData, size_t size) {
+ByteOrder Rw2Parser::decode(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, const byte* pData, size_t size,
+                            const ReadFilter& filter) {
   Rw2Header rw2Header;
   return TiffParserWorker::decode(exifData, iptcData, xmpData, pData, size, Tag::pana, TiffMapping::findDecoder,
-                                  &rw2Header);
+                                  &rw2Header, filter);
+}
+
+ByteOrder Rw2Parser::scan(ExifScan& scan, const byte* pData, size_t size) {
+  Rw2Header rw2Header;
+  return TiffParserWorker::scan(scan, pData, size, &rw2Header);
 }
 
 // *************************************************************************
@@ -10,6 +10,7 @@
 #include "types.hpp"
 
 #include <memory>
+#include <string_view>
 
 // *****************************************************************************
 // class member definitions
@@ -140,65 +141,26 @@ void ExifTags::taglist(std::ostream& os, const std::string& groupName) {
   Internal::taglist(os, ifdId);
 }
 
-//! %Internal Pimpl structure with private members and data of class ExifKey.
-struct ExifKey::Impl {
-  //! @name Manipulators
-  //@{
-  /*!
-    @brief Set the key corresponding to the \em tag, \em ifdId and \em tagInfo.
-           The key is of the form '<b>Exif</b>.groupName.tagName'.
-   */
-  void makeKey(uint16_t tag, IfdId ifdId, const TagInfo* tagInfo);
-  /*!
-    @brief Parse and convert the key string into tag and IFD Id.
-           Updates data members if the string can be decomposed,
-           or throws \em Error .
-
-    @throw Error if the key cannot be decomposed.
-   */
-  void decomposeKey(const std::string& key);
-  //@}
-
-  //! @name Accessors
-  //@{
-  //! Return the name of the tag
-  [[nodiscard]] std::string tagName() const;
-  //@}
-
-  // DATA
-  static constexpr auto familyName_ = "Exif";  //!< "Exif"
-
-  const TagInfo* tagInfo_{};         //!< Tag info
-  uint16_t tag_{0};                  //!< Tag value
-  IfdId ifdId_{IfdId::ifdIdNotSet};  //!< The IFD associated with this tag
-  int idx_{0};                       //!< Unique id of the Exif key in the image
-  std::string groupName_;            //!< The group name
-  std::string key_;                  //!< %Key
-};
-
-std::string ExifKey::Impl::tagName() const {
-  if (tagInfo_ && tagInfo_->tag_ != 0xffff) {
-    return tagInfo_->name_;
-  }
-  return stringFormat("0x{:04x}", tag_);
-}
+namespace {
+constexpr std::string_view exifFamilyName = "Exif";  //!< "Exif"
+}  // namespace
 
-void ExifKey::Impl::decomposeKey(const std::string& key) {
+void ExifKey::decomposeKey(const std::string& key) {
   // Get the family name, IFD name and tag name parts of the key
-  std::string::size_type pos1 = key.find('.');
-  if (pos1 == std::string::npos)
+  const std::string_view k(key);
+  std::string_view::size_type pos1 = k.find('.');
+  if (pos1 == std::string_view::npos)
     throw Error(ErrorCode::kerInvalidKey, key);
-  std::string familyName = key.substr(0, pos1);
-  if (familyName != familyName_)
+  if (k.substr(0, pos1) != exifFamilyName)
     throw Error(ErrorCode::kerInvalidKey, key);
-  std::string::size_type pos0 = pos1 + 1;
-  pos1 = key.find('.', pos0);
-  if (pos1 == std::string::npos)
+  std::string_view::size_type pos0 = pos1 + 1;
+  pos1 = k.find('.', pos0);
+  if (pos1 == std::string_view::npos)
     throw Error(ErrorCode::kerInvalidKey, key);
-  std::string groupName = key.substr(pos0, pos1 - pos0);
+  std::string_view groupName = k.substr(pos0, pos1 - pos0);
   if (groupName.empty())
     throw Error(ErrorCode::kerInvalidKey, key);
-  std::string tn = key.substr(pos1 + 1);
+  std::string_view tn = k.substr(pos1 + 1);
   if (tn.empty())
     throw Error(ErrorCode::kerInvalidKey, key);
 
@@ -218,97 +180,90 @@ void ExifKey::Impl::decomposeKey(const std::string& key) {
 
   tag_ = tag;
   ifdId_ = ifdId;
-  groupName_ = groupName;
-  // tagName() translates hex tag name (0xabcd) to a real tag name if there is one
-  key_ = familyName + "." + groupName + "." + tagName();
-}
-
-void ExifKey::Impl::makeKey(uint16_t tag, IfdId ifdId, const TagInfo* tagInfo) {
-  tagInfo_ = tagInfo;
-  tag_ = tag;
-  ifdId_ = ifdId;
-  key_ = std::string(familyName_) + "." + groupName_ + "." + tagName();
+  groupName_ = Internal::groupName(ifdId);
 }
 
-ExifKey::ExifKey(uint16_t tag, const std::string& groupName) : p_(std::make_unique<Impl>()) {
+ExifKey::ExifKey(uint16_t tag, const std::string& groupName) {
   IfdId ifdId = groupId(groupName);
   // Todo: Test if this condition can be removed
   if (!Internal::isExifIfd(ifdId) && !Internal::isMakerIfd(ifdId)) {
     throw Error(ErrorCode::kerInvalidIfdId, ifdId);
   }
-  const TagInfo* ti = tagInfo(tag, ifdId);
-  if (!ti) {
+  tagInfo_ = tagInfo(tag, ifdId);
+  if (!tagInfo_) {
     throw Error(ErrorCode::kerInvalidIfdId, ifdId);
   }
-  p_->groupName_ = groupName;
-  p_->makeKey(tag, ifdId, ti);
+  tag_ = tag;
+  ifdId_ = ifdId;
+  groupName_ = Internal::groupName(ifdId);
 }
 
-ExifKey::ExifKey(const TagInfo& ti) : p_(std::make_unique<Impl>()) {
-  auto ifdId = ti.ifdId_;
-  if (!Internal::isExifIfd(ifdId) && !Internal::isMakerIfd(ifdId)) {
-    throw Error(ErrorCode::kerInvalidIfdId, ifdId);
+ExifKey::ExifKey(const TagInfo& ti) : tagInfo_(&ti), tag_(ti.tag_), ifdId_(ti.ifdId_) {
+  if (!Internal::isExifIfd(ifdId_) && !Internal::isMakerIfd(ifdId_)) {
+    throw Error(ErrorCode::kerInvalidIfdId, ifdId_);
   }
-  p_->groupName_ = Exiv2::groupName(ifdId);
-  p_->makeKey(ti.tag_, ifdId, &ti);
+  groupName_ = Internal::groupName(ifdId_);
 }
 
-ExifKey::ExifKey(const std::string& key) : p_(std::make_unique<Impl>()) {
-  p_->decomposeKey(key);
+ExifKey::ExifKey(const std::string& key) {
+  decomposeKey(key);
 }
 
-ExifKey::ExifKey(const ExifKey& rhs) : p_(std::make_unique<Impl>(*rhs.p_)) {
-}
+ExifKey::ExifKey(const ExifKey& rhs) = default;
 
 ExifKey::~ExifKey() = default;
 
-ExifKey& ExifKey::operator=(const ExifKey& rhs) {
-  if (this == &rhs)
-    return *this;
-  *p_ = *rhs.p_;
-  return *this;
-}
+ExifKey& ExifKey::operator=(const ExifKey& rhs) = default;
 
 void ExifKey::setIdx(int idx) const {
-  p_->idx_ = idx;
+  idx_ = idx;
 }
 
 std::string ExifKey::key() const {
-  return p_->key_;
+  // The key is of the form 'Exif.groupName.tagName'
+  // tagName() translates hex tag name (0xabcd) to a real tag name if there is one
+  const std::string tn = tagName();
+  std::string key;
+  key.reserve(exifFamilyName.size() + groupName_.size() + tn.size() + 2);
+  key.append(exifFamilyName).append(1, '.').append(groupName_).append(1, '.').append(tn);
+  return key;
 }
 
 const char* ExifKey::familyName() const {
-  return Exiv2::ExifKey::Impl::familyName_;
+  return exifFamilyName.data();
 }
 
 std::string ExifKey::groupName() const {
-  return p_->groupName_;
+  return std::string(groupName_);
 }
 
 std::string ExifKey::tagName() const {
-  return p_->tagName();
+  if (tagInfo_ && tagInfo_->tag_ != 0xffff) {
+    return tagInfo_->name_;
+  }
+  return stringFormat("0x{:04x}", tag_);
 }
 
 std::string ExifKey::tagLabel() const {
-  if (!p_->tagInfo_ || p_->tagInfo_->tag_ == 0xffff)
+  if (!tagInfo_ || tagInfo_->tag_ == 0xffff)
     return "";
-  return _(p_->tagInfo_->title_);
+  return _(tagInfo_->title_);
 }
 
 std::string ExifKey::tagDesc() const {
-  if (!p_->tagInfo_ || p_->tagInfo_->tag_ == 0xffff)
+  if (!tagInfo_ || tagInfo_->tag_ == 0xffff)
     return {};
-  return _(p_->tagInfo_->desc_);
+  return _(tagInfo_->desc_);
 }
 
 TypeId ExifKey::defaultTypeId() const {
-  if (!p_->tagInfo_)
+  if (!tagInfo_)
     return unknownTag.typeId_;
-  return p_->tagInfo_->typeId_;
+  return tagInfo_->typeId_;
 }
 
 uint16_t ExifKey::tag() const {
-  return p_->tag_;
+  return tag_;
 }
 
 ExifKey::UniquePtr ExifKey::clone() const {
@@ -320,11 +275,11 @@ ExifKey* ExifKey::clone_() const {
 }
 
 IfdId ExifKey::ifdId() const {
-  return p_->ifdId_;
+  return ifdId_;
 }
 
 int ExifKey::idx() const {
-  return p_->idx_;
+  return idx_;
 }
 
 // *************************************************************************
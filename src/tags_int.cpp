@@ -20,9 +20,11 @@
 #include "sonymn_int.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <iomanip>
 #include <numeric>
+#include <unordered_map>
 
 // *****************************************************************************
 // local declarations
@@ -169,6 +171,72 @@ constexpr GroupInfo groupInfo[] = {
     {IfdId::lastId, "(Last IFD info)", "(Last IFD item)", nullptr},
 };
 
+namespace {
+//! Hash indexes of a tag list by tag number and by tag name
+struct TagListIndex {
+  explicit TagListIndex(const TagInfo* tagList);
+
+  // DATA
+  const TagInfo* end_;                                           //!< End of list marker, returned for unknown tags
+  std::unordered_map<uint16_t, const TagInfo*> byTag_;           //!< Tags by number
+  std::unordered_map<std::string_view, const TagInfo*> byName_;  //!< Tags by name
+};
+
+TagListIndex::TagListIndex(const TagInfo* tagList) {
+  // Like a linear search of the list, the first entry of duplicates wins
+  for (end_ = tagList; end_->tag_ != 0xffff; ++end_) {
+    byTag_.try_emplace(end_->tag_, end_);
+    byName_.try_emplace(end_->name_, end_);
+  }
+}
+
+//! Indexes of the group table and of the tag list of each group, built once on first use
+struct GroupIndex {
+  GroupIndex();
+
+  //! Return the group with \em ifdId or nullptr
+  [[nodiscard]] const GroupInfo* group(IfdId ifdId) const {
+    auto i = static_cast<size_t>(ifdId);
+    return i < byId_.size() ? byId_[i] : nullptr;
+  }
+  //! Return the group named \em groupName or nullptr
+  [[nodiscard]] const GroupInfo* group(std::string_view groupName) const {
+    auto i = byName_.find(groupName);
+    return i != byName_.end() ? i->second : nullptr;
+  }
+  //! Return the index of the tag list of the group with \em ifdId or nullptr
+  [[nodiscard]] const TagListIndex* tags(IfdId ifdId) const {
+    auto i = static_cast<size_t>(ifdId);
+    return i < tagsById_.size() ? tagsById_[i] : nullptr;
+  }
+
+  // DATA
+  std::array<const GroupInfo*, static_cast<size_t>(IfdId::lastId) + 1> byId_{};         //!< Groups by IfdId
+  std::unordered_map<std::string_view, const GroupInfo*> byName_;                       //!< Groups by name
+  std::unordered_map<const TagInfo*, TagListIndex> tagLists_;                           //!< Indexes by tag list
+  std::array<const TagListIndex*, static_cast<size_t>(IfdId::lastId) + 1> tagsById_{};  //!< Indexes by IfdId
+};
+
+GroupIndex::GroupIndex() {
+  for (auto&& gi : groupInfo) {
+    auto i = static_cast<size_t>(gi.ifdId_);
+    byName_.try_emplace(gi.groupName_, &gi);
+    if (byId_[i])
+      continue;
+    byId_[i] = &gi;
+    if (gi.tagList_) {
+      const TagInfo* tagList = gi.tagList_();
+      tagsById_[i] = &tagLists_.try_emplace(tagList, tagList).first->second;
+    }
+  }
+}
+
+const GroupIndex& groupIndex() {
+  static const GroupIndex index;
+  return index;
+}
+}  // namespace
+
 //! Units for measuring X and Y resolution, tags 0x0128, 0xa210
 constexpr TagDetails exifUnit[] = {
     {1, N_("none")},
@@ -2473,7 +2541,7 @@ const TagInfo* mnTagList() {
 }
 
 bool isMakerIfd(IfdId ifdId) {
-  auto ii = Exiv2::find(groupInfo, ifdId);
+  auto ii = groupIndex().group(ifdId);
   return ii && strcmp(ii->ifdName_, "Makernote") == 0;
 }
 
@@ -2513,51 +2581,44 @@ void taglist(std::ostream& os, IfdId ifdId) {
 }  // taglist
 
 const TagInfo* tagList(IfdId ifdId) {
-  if (auto ii = Exiv2::find(groupInfo, ifdId))
+  if (auto ii = groupIndex().group(ifdId))
     if (ii->tagList_)
       return ii->tagList_();
   return nullptr;
 }  // tagList
 
 const TagInfo* tagInfo(uint16_t tag, IfdId ifdId) {
-  if (auto ti = tagList(ifdId)) {
-    int idx = 0;
-    for (idx = 0; ti[idx].tag_ != 0xffff; ++idx) {
-      if (ti[idx].tag_ == tag)
-        break;
-    }
-    return ti + idx;
+  if (auto index = groupIndex().tags(ifdId)) {
+    auto i = index->byTag_.find(tag);
+    return i != index->byTag_.end() ? i->second : index->end_;
   }
   return nullptr;
 }  // tagInfo
 
-const TagInfo* tagInfo(const std::string& tagName, IfdId ifdId) {
+const TagInfo* tagInfo(std::string_view tagName, IfdId ifdId) {
   if (tagName.empty())
     return nullptr;
-  if (auto ti = tagList(ifdId)) {
-    for (int idx = 0; ti[idx].tag_ != 0xffff; ++idx) {
-      if (tagName == ti[idx].name_) {
-        return ti + idx;
-      }
-    }
+  if (auto index = groupIndex().tags(ifdId)) {
+    if (auto i = index->byName_.find(tagName); i != index->byName_.end())
+      return i->second;
   }
   return nullptr;
 }  // tagInfo
 
-IfdId groupId(const std::string& groupName) {
-  if (auto ii = Exiv2::find(groupInfo, groupName))
+IfdId groupId(std::string_view groupName) {
+  if (auto ii = groupIndex().group(groupName))
     return IfdId{ii->ifdId_};
   return IfdId::ifdIdNotSet;
 }
 
 const char* ifdName(IfdId ifdId) {
-  if (auto ii = Exiv2::find(groupInfo, ifdId))
+  if (auto ii = groupIndex().group(ifdId))
     return ii->ifdName_;
   return groupInfo[0].ifdName_;
 }
 
 const char* groupName(IfdId ifdId) {
-  if (auto ii = Exiv2::find(groupInfo, ifdId))
+  if (auto ii = groupIndex().group(ifdId))
     return ii->groupName_;
   return groupInfo[0].groupName_;
 }
@@ -2618,13 +2679,14 @@ URational exposureTime(float shutterSpeedValue) {
   return ur;
 }
 
-uint16_t tagNumber(const std::string& tagName, IfdId ifdId) {
+uint16_t tagNumber(std::string_view tagName, IfdId ifdId) {
   const TagInfo* ti = tagInfo(tagName, ifdId);
   if (ti && ti->tag_ != 0xffff)
     return ti->tag_;
-  if (!isHex(tagName, 4, "0x"))
-    throw Error(ErrorCode::kerInvalidTag, tagName, ifdId);
-  return static_cast<uint16_t>(std::stoi(tagName, nullptr, 16));
+  const std::string hex(tagName);
+  if (!isHex(hex, 4, "0x"))
+    throw Error(ErrorCode::kerInvalidTag, hex, ifdId);
+  return static_cast<uint16_t>(std::stoi(hex, nullptr, 16));
 }  // tagNumber
 
 std::ostream& printInt64(std::ostream& os, const Value& value, const ExifData*) {
@@ -2645,7 +2707,6 @@ std::ostream& printFloat(std::ostream& os, const Value& value, const ExifData*)
 }  // printFloat
 
 std::ostream& printDegrees(std::ostream& os, const Value& value, const ExifData*) {
-  std::ios::fmtflags f(os.flags());
   if (value.count() == 3) {
     Rational deg = value.toRational(0);
     Rational min = value.toRational(1);
@@ -2667,14 +2728,10 @@ std::ostream& printDegrees(std::ostream& os, const Value& value, const ExifData*
     const float ss = static_cast<float>(sec.first) / sec.second;
     os << dd << " deg ";
     os << mm << "' ";
-    std::ostringstream oss;
-    oss.copyfmt(os);
-    os << std::fixed << std::setprecision(sec.second > 1 ? 2 : 0) << ss << "\"";
-    os.copyfmt(oss);
+    os << toFixedString(ss, sec.second > 1 ? 2 : 0) << "\"";
   } else {
     os << "(" << value << ")";
   }
-  os.flags(f);
   return os;
 }  // printDegrees
 
@@ -2801,18 +2858,11 @@ std::ostream& print0x0005(std::ostream& os, const Value& value, const ExifData*
 }
 
 std::ostream& print0x0006(std::ostream& os, const Value& value, const ExifData*) {
-  std::ios::fmtflags f(os.flags());
-  std::ostringstream oss;
-  oss.copyfmt(os);
   const int32_t d = value.toRational().second;
   if (d == 0)
     return os << "(" << value << ")";
   const int p = d > 1 ? 1 : 0;
-  os << std::fixed << std::setprecision(p) << value.toFloat() << " m";
-  os.copyfmt(oss);
-
-  os.flags(f);
-  return os;
+  return os << toFixedString(value.toFloat(), p) << " m";
 }
 
 std::ostream& print0x0007(std::ostream& os, const Value& value, const ExifData*) {
@@ -2925,17 +2975,14 @@ std::ostream& print0x829a(std::ostream& os, const Value& value, const ExifData*)
 }
 
 std::ostream& print0x829d(std::ostream& os, const Value& value, const ExifData*) {
-  std::ios::fmtflags f(os.flags());
   Rational fnumber = value.toRational();
   if (fnumber.second != 0) {
-    std::ostringstream oss;
-    oss.copyfmt(os);
-    os << "F" << std::setprecision(2) << static_cast<float>(fnumber.first) / fnumber.second;
-    os.copyfmt(oss);
+    std::string str = "F";
+    appendNumber(str, static_cast<float>(fnumber.first) / fnumber.second, 2);
+    os << str;
   } else {
     os << "(" << value << ")";
   }
-  os.flags(f);
   return os;
 }
 
@@ -3000,16 +3047,12 @@ std::ostream& print0x9201(std::ostream& os, const Value& value, const ExifData*)
 }
 
 std::ostream& print0x9202(std::ostream& os, const Value& value, const ExifData*) {
-  std::ios::fmtflags f(os.flags());
   if (value.count() == 0 || value.toRational().second == 0) {
     return os << "(" << value << ")";
   }
-  std::ostringstream oss;
-  oss.copyfmt(os);
-  os << "F" << std::setprecision(2) << fnumber(value.toFloat());
-  os.copyfmt(oss);
-  os.flags(f);
-  return os;
+  std::string str = "F";
+  appendNumber(str, fnumber(value.toFloat()), 2);
+  return os << str;
 }
 
 std::ostream& print0x9204(std::ostream& os, const Value& value, const ExifData*) {
@@ -3033,21 +3076,16 @@ std::ostream& print0x9204(std::ostream& os, const Value& value, const ExifData*)
 }
 
 std::ostream& print0x9206(std::ostream& os, const Value& value, const ExifData*) {
-  std::ios::fmtflags f(os.flags());
   Rational distance = value.toRational();
   if (distance.first == 0) {
     os << _("Unknown");
   } else if (static_cast<uint32_t>(distance.first) == 0xffffffff) {
     os << _("Infinity");
   } else if (distance.second != 0) {
-    std::ostringstream oss;
-    oss.copyfmt(os);
-    os << std::fixed << std::setprecision(2) << static_cast<float>(distance.first) / distance.second << " m";
-    os.copyfmt(oss);
+    os << toFixedString(static_cast<float>(distance.first) / distance.second, 2) << " m";
   } else {
     os << "(" << value << ")";
   }
-  os.flags(f);
   return os;
 }
 
@@ -3067,17 +3105,12 @@ std::ostream& print0x9208(std::ostream& os, const Value& value, const ExifData*
 }
 
 std::ostream& print0x920a(std::ostream& os, const Value& value, const ExifData*) {
-  std::ios::fmtflags f(os.flags());
   Rational length = value.toRational();
   if (length.second != 0) {
-    std::ostringstream oss;
-    oss.copyfmt(os);
-    os << std::fixed << std::setprecision(1) << static_cast<float>(length.first) / length.second << " mm";
-    os.copyfmt(oss);
+    os << toFixedString(static_cast<float>(length.first) / length.second, 1) << " mm";
   } else {
     os << "(" << value << ")";
   }
-  os.flags(f);
   return os;
 }
 
@@ -3159,17 +3192,12 @@ std::ostream& print0xa403(std::ostream& os, const Value& value, const ExifData*
 }
 
 std::ostream& print0xa404(std::ostream& os, const Value& value, const ExifData*) {
-  std::ios::fmtflags f(os.flags());
   Rational zoom = value.toRational();
   if (zoom.second == 0) {
     os << _("Digital zoom not used");
   } else {
-    std::ostringstream oss;
-    oss.copyfmt(os);
-    os << std::fixed << std::setprecision(1) << static_cast<float>(zoom.first) / zoom.second;
-    os.copyfmt(oss);
+    os << toFixedString(static_cast<float>(zoom.first) / zoom.second, 1);
   }
-  os.flags(f);
   return os;
 }
 
@@ -3283,7 +3311,7 @@ const GroupInfo* groupList() {
 }
 
 const TagInfo* tagList(const std::string& groupName) {
-  auto ii = Exiv2::find(groupInfo, groupName);
+  auto ii = groupIndex().group(groupName);
   if (!ii || !ii->tagList_) {
     return nullptr;
   }
@@ -355,7 +355,7 @@ const GroupInfo* groupList();
 const TagInfo* tagList(const std::string& groupName);
 
 //! Return the group id for a group name
-IfdId groupId(const std::string& groupName);
+IfdId groupId(std::string_view groupName);
 //! Return the name of the IFD
 const char* ifdName(IfdId ifdId);
 //! Return the group name for a group id
@@ -373,7 +373,7 @@ const TagInfo* tagList(IfdId ifdId);
 //! Return the tag info for \em tag and \em ifdId
 const TagInfo* tagInfo(uint16_t tag, IfdId ifdId);
 //! Return the tag info for \em tagName and \em ifdId
-const TagInfo* tagInfo(const std::string& tagName, IfdId ifdId);
+const TagInfo* tagInfo(std::string_view tagName, IfdId ifdId);
 /*!
   @brief Return the tag number for one combination of IFD id and tagName.
          If the tagName is not known, it expects tag names in the
@@ -381,7 +381,7 @@ const TagInfo* tagInfo(const std::string& tagName, IfdId ifdId);
 
   @throw Error if the tagname or ifdId is invalid
  */
-uint16_t tagNumber(const std::string& tagName, IfdId ifdId);
+uint16_t tagNumber(std::string_view tagName, IfdId ifdId);
 
 //! @name Functions printing interpreted tag values
 //@{
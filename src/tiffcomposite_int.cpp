@@ -21,11 +21,23 @@
 #include <iostream>
 #include <memory>
 #include <numeric>
+#include <utility>
 
 // *****************************************************************************
 namespace {
 //! Add \em tobe - \em curr 0x00 filler bytes if necessary
 size_t fillGap(Exiv2::Internal::IoWrapper& ioWrapper, size_t curr, size_t tobe);
+
+//! Current TiffArena of the thread
+thread_local Exiv2::Internal::TiffArena* currentArena = nullptr;
+
+//! Header in front of each TiffComponent, with the memory resource it was allocated from
+struct alignas(std::max_align_t) ComponentHeader {
+  std::pmr::memory_resource* resource_;
+};
+
+//! Size of the first buffer of a TiffArena, enough for the tree of a typical JPEG image
+constexpr size_t initialArenaSize = 16 * 1024;
 }  // namespace
 
 // *****************************************************************************
@@ -36,6 +48,31 @@ bool TiffMappingInfo::operator==(const TiffMappingInfo::Key& key) const {
          key.g_ == group_;
 }
 
+TiffArena::TiffArena() :
+    buffer_(initialArenaSize, std::pmr::new_delete_resource()), previous_(std::exchange(currentArena, this)) {
+}
+
+TiffArena::~TiffArena() {
+  currentArena = previous_;
+}
+
+std::pmr::memory_resource* TiffArena::resource() {
+  return currentArena ? &currentArena->buffer_ : std::pmr::new_delete_resource();
+}
+
+void* TiffComponent::operator new(size_t size) {
+  auto resource = TiffArena::resource();
+  auto header = static_cast<ComponentHeader*>(
+      resource->allocate(sizeof(ComponentHeader) + size, alignof(ComponentHeader)));
+  header->resource_ = resource;
+  return header + 1;
+}
+
+void TiffComponent::operator delete(void* p, size_t size) {
+  auto header = static_cast<ComponentHeader*>(p) - 1;
+  header->resource_->deallocate(header, sizeof(ComponentHeader) + size, alignof(ComponentHeader));
+}
+
 IoWrapper::IoWrapper(BasicIo& io, const byte* pHeader, size_t size, OffsetWriter* pow) :
     io_(io), pHeader_(pHeader), size_(size), pow_(pow) {
   if (!pHeader_ || size_ == 0)
@@ -66,11 +103,12 @@ void IoWrapper::setTarget(int id, size_t target) {
     pow_->setTarget(static_cast<OffsetWriter::OffsetId>(id), static_cast<uint32_t>(target));
 }
 
-TiffDirectory::TiffDirectory(uint16_t tag, IfdId group, bool hasNext) : TiffComponent(tag, group), hasNext_(hasNext) {
+TiffDirectory::TiffDirectory(uint16_t tag, IfdId group, bool hasNext) :
+    TiffComponent(tag, group), components_(TiffArena::resource()), hasNext_(hasNext) {
 }
 
 TiffSubIfd::TiffSubIfd(uint16_t tag, IfdId group, IfdId newGroup) :
-    TiffEntryBase(tag, group, ttUnsignedLong), newGroup_(newGroup) {
+    TiffEntryBase(tag, group, ttUnsignedLong), newGroup_(newGroup), ifds_(TiffArena::resource()) {
 }
 
 TiffIfdMakernote::TiffIfdMakernote(uint16_t tag, IfdId group, IfdId mnGroup, std::unique_ptr<MnHeader> pHeader,
@@ -82,7 +120,11 @@ TiffIfdMakernote::~TiffIfdMakernote() = default;
 
 TiffBinaryArray::TiffBinaryArray(uint16_t tag, IfdId group, const ArrayCfg& arrayCfg, const ArrayDef* arrayDef,
                                  size_t defSize) :
-    TiffEntryBase(tag, group, arrayCfg.elTiffType_), arrayCfg_(&arrayCfg), arrayDef_(arrayDef), defSize_(defSize) {
+    TiffEntryBase(tag, group, arrayCfg.elTiffType_),
+    arrayCfg_(&arrayCfg),
+    arrayDef_(arrayDef),
+    defSize_(defSize),
+    elements_(TiffArena::resource()) {
 }
 
 TiffBinaryArray::TiffBinaryArray(uint16_t tag, IfdId group, const ArraySet* arraySet, size_t setSize,
@@ -90,7 +132,8 @@ TiffBinaryArray::TiffBinaryArray(uint16_t tag, IfdId group, const ArraySet* arra
     TiffEntryBase(tag, group),  // Todo: Does it make a difference that there is no type?
     cfgSelFct_(cfgSelFct),
     arraySet_(arraySet),
-    setSize_(setSize) {
+    setSize_(setSize),
+    elements_(TiffArena::resource()) {
   // We'll figure out the correct cfg later
 }
 
@@ -106,10 +149,12 @@ TiffEntryBase::TiffEntryBase(const TiffEntryBase& rhs) :
     storage_(rhs.storage_) {
 }
 
-TiffDirectory::TiffDirectory(const TiffDirectory& rhs) : TiffComponent(rhs), hasNext_(rhs.hasNext_) {
+TiffDirectory::TiffDirectory(const TiffDirectory& rhs) :
+    TiffComponent(rhs), components_(TiffArena::resource()), hasNext_(rhs.hasNext_) {
 }
 
-TiffSubIfd::TiffSubIfd(const TiffSubIfd& rhs) : TiffEntryBase(rhs), newGroup_(rhs.newGroup_) {
+TiffSubIfd::TiffSubIfd(const TiffSubIfd& rhs) :
+    TiffEntryBase(rhs), newGroup_(rhs.newGroup_), ifds_(TiffArena::resource()) {
 }
 
 TiffBinaryArray::TiffBinaryArray(const TiffBinaryArray& rhs) :
@@ -120,6 +165,7 @@ TiffBinaryArray::TiffBinaryArray(const TiffBinaryArray& rhs) :
     arrayDef_(rhs.arrayDef_),
     defSize_(rhs.defSize_),
     setSize_(rhs.setSize_),
+    elements_(TiffArena::resource()),
     origData_(rhs.origData_),
     origSize_(rhs.origSize_),
     pRoot_(rhs.pRoot_) {
@@ -8,6 +8,8 @@
 #include "tifffwd_int.hpp"
 
 #include <memory>
+#include <memory_resource>
+#include <vector>
 
 // *****************************************************************************
 // namespace extensions
@@ -141,6 +143,40 @@ class IoWrapper {
   OffsetWriter* pow_;        //! Pointer to an offset-writer, if any, or 0
 };
 
+/*!
+  @brief Arena for the TIFF components which are created on the calling
+         thread while it is in scope, see TiffComponent::operator new().
+
+  The components and their lists of children are allocated from a
+  monotonic buffer and released in one step with the arena, instead of
+  with one allocation for each. All trees built in the scope of an arena
+  must be destroyed before it. Arenas can be nested, components are
+  allocated from the innermost one.
+ */
+class TiffArena {
+ public:
+  //! @name Creators
+  //@{
+  //! Default constructor, makes the arena the current one of the calling thread.
+  TiffArena();
+  //! Destructor, restores the previous arena and releases the memory.
+  ~TiffArena();
+  TiffArena(const TiffArena&) = delete;
+  TiffArena& operator=(const TiffArena&) = delete;
+  //@}
+
+  /*!
+    @brief Return the memory resource of the current arena of the calling
+           thread, the new-delete resource if there is none.
+   */
+  static std::pmr::memory_resource* resource();
+
+ private:
+  // DATA
+  std::pmr::monotonic_buffer_resource buffer_;  //!< Memory of the arena
+  TiffArena* previous_;                          //!< Arena which was current before
+};
+
 /*!
   @brief Interface class for components of a TIFF directory hierarchy
          (Composite pattern).  Both TIFF directories as well as entries
@@ -154,7 +190,7 @@ class TiffComponent {
   //! TiffComponent auto_ptr type
   using UniquePtr = std::unique_ptr<TiffComponent>;
   //! Container type to hold all metadata
-  using Components = std::vector<UniquePtr>;
+  using Components = std::pmr::vector<UniquePtr>;
 
   //! @name Creators
   //@{
@@ -165,6 +201,14 @@ class TiffComponent {
   virtual ~TiffComponent() = default;
   //@}
 
+  //! @name Allocation
+  //@{
+  //! Allocate a component from the current TiffArena, from the heap if there is none.
+  static void* operator new(size_t size);
+  //! Release a component, a no-op if it was allocated from a TiffArena.
+  static void operator delete(void* p, size_t size);
+  //@}
+
   //! @name Manipulators
   //@{
   /*!
@@ -642,6 +686,7 @@ class TiffDataEntryBase : public TiffEntryBase {
  */
 class TiffDataEntry : public TiffDataEntryBase {
   friend class TiffEncoder;
+  friend class TiffExtent;
 
  public:
   using TiffDataEntryBase::TiffDataEntryBase;
@@ -986,7 +1031,7 @@ class TiffSubIfd : public TiffEntryBase {
 
  private:
   //! A collection of TIFF directories (IFDs)
-  using Ifds = std::vector<std::unique_ptr<TiffDirectory>>;
+  using Ifds = std::pmr::vector<std::unique_ptr<TiffDirectory>>;
 
   // DATA
   IfdId newGroup_;  //!< Start of the range of group numbers for the sub-IFDs
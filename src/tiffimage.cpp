@@ -8,10 +8,12 @@
 #include "error.hpp"
 #include "futils.hpp"
 #include "image.hpp"
+#include "image_int.hpp"
 #include "tiffcomposite_int.hpp"
 #include "tiffimage_int.hpp"
 #include "types.hpp"
 
+#include <algorithm>
 #include <array>
 #include <iostream>
 
@@ -144,8 +146,9 @@ void TiffImage::readMetadata() {
     throw Error(ErrorCode::kerNotAnImage, "TIFF");
   }
   clearMetadata();
+  recordReadFilter();
 
-  ByteOrder bo = TiffParser::decode(exifData_, iptcData_, xmpData_, io_->mmap(), io_->size());
+  ByteOrder bo = TiffParser::decode(exifData_, iptcData_, xmpData_, io_->mmap(), io_->size(), readFilter());
   setByteOrder(bo);
 
   // read profile from the metadata
@@ -162,6 +165,7 @@ void TiffImage::readMetadata() {
 }
 
 void TiffImage::writeMetadata() {
+  enforceCompleteMetadata();
 #ifdef EXIV2_DEBUG_MESSAGES
   std::cerr << "Writing TIFF file " << io_->path() << "\n";
 #endif
@@ -198,24 +202,96 @@ void TiffImage::writeMetadata() {
       exifData_.erase(pos);
   }
 
-  // set usePacket to influence TiffEncoder::encodeXmp() called by TiffVisitor.encode()
-  xmpData().usePacket(writeXmpFromPacket());
+  // Encode the XMP packet with the padding of the write policy. If the image
+  // has a packet, resize the padding to its size where possible, so that the
+  // packet can be updated in place. TiffEncoder::encodeXmp() takes the packet
+  // from xmpData_, the packet and flag of the caller are restored afterwards.
+  writeResult_ = WriteResult();
+  const bool usePacket = xmpData_.usePacket();
+  const bool encodeXmp = !writeXmpFromPacket();
+  std::string callerPacket;
+  size_t xmpSize = 0;
+  if (encodeXmp) {
+    std::string xmpPacket;
+    if (XmpParser::encode(xmpPacket, xmpData_, XmpParser::useCompactFormat, writePolicy().xmpPadding_) > 1) {
+#ifndef SUPPRESS_WARNINGS
+      EXV_ERROR << "Failed to encode XMP metadata.\n";
+#endif
+    }
+    xmpSize = xmpPacket.size();
+    if (auto pos = exifData_.findKey(ExifKey("Exif.Image.XMLPacket"));
+        pos != exifData_.end() && !xmpPacket.empty() && pos->size() != xmpPacket.size()) {
+      Internal::resizeXmpPadding(xmpPacket, pos->size());
+    }
+    callerPacket = xmpData_.xmpPacket();
+    xmpData_.setPacket(std::move(xmpPacket));
+  }
+  xmpData_.usePacket(true);
+  auto restoreXmpPacket = [&] {
+    if (encodeXmp)
+      xmpData_.setPacket(std::move(callerPacket));
+    xmpData_.usePacket(usePacket);
+  };
 
-  TiffParser::encode(*io_, pData, size, bo, exifData_, iptcData_, xmpData_);  // may throw
+  WriteMethod wm = wmIntrusive;
+  try {
+    wm = TiffParser::encode(*io_, pData, size, bo, exifData_, iptcData_, xmpData_);  // may throw
+  } catch (...) {
+    restoreXmpPacket();
+    throw;
+  }
+  writeResult_.inPlace_ = wm == wmNonIntrusive;
+  if (auto xmp = Internal::findXmpPadding(xmpData_.xmpPacket())) {
+    writeResult_.xmpPadding_ = xmp->end_ - xmp->start_;
+    if (writeResult_.inPlace_ && xmpSize > 0)
+      writeResult_.reserveUsed_ = static_cast<int64_t>(xmpSize) - static_cast<int64_t>(xmpData_.xmpPacket().size());
+  }
+  restoreXmpPacket();
 }  // TiffImage::writeMetadata
 
-ByteOrder TiffParser::decode(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, const byte* pData, size_t size) {
-  uint32_t root = Tag::root;
-
+namespace {
+//! Return the root tag for TIFF data decoded into \em exifData
+uint32_t tiffRoot(const ExifData& exifData) {
   // #1402  Fujifilm RAF. Change root when parsing embedded tiff
   Exiv2::ExifKey key("Exif.Image.Make");
   if (exifData.findKey(key) != exifData.end() && exifData.findKey(key)->toString() == "FUJIFILM") {
-    root = Tag::fuji;
+    return Tag::fuji;
   }
+  return Tag::root;
+}
+}  // namespace
+
+ByteOrder TiffParser::decode(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, const byte* pData, size_t size,
+                             const ReadFilter& filter) {
+  return TiffParserWorker::decode(exifData, iptcData, xmpData, pData, size, tiffRoot(exifData),
+                                  TiffMapping::findDecoder, nullptr, filter);
+}  // TiffParser::decode
 
-  return TiffParserWorker::decode(exifData, iptcData, xmpData, pData, size, root, TiffMapping::findDecoder);
+ByteOrder TiffParser::decode(ExifData& exifData, IptcData& iptcData, XmpData& xmpData,
+                             const std::shared_ptr<const DataBuf>& buf, size_t offset, const ReadFilter& filter) {
+  const size_t size = buf->size() - std::min(offset, buf->size());
+  return TiffParserWorker::decode(exifData, iptcData, xmpData, buf->c_data(offset), size, tiffRoot(exifData),
+                                  TiffMapping::findDecoder, nullptr, filter, buf);
 }  // TiffParser::decode
 
+void TiffImage::scanExif(ExifScan& scan) {
+  if (io_->open() != 0) {
+    throw Error(ErrorCode::kerDataSourceOpenFailed, io_->path(), strError());
+  }
+  IoCloser closer(*io_);
+  // Ensure that this is the correct image type
+  if (!isTiffType(*io_, false)) {
+    if (io_->error() || io_->eof())
+      throw Error(ErrorCode::kerFailedToReadImageData);
+    throw Error(ErrorCode::kerNotAnImage, "TIFF");
+  }
+  TiffParser::scan(scan, io_->mmap(), io_->size());
+}
+
+ByteOrder TiffParser::scan(ExifScan& scan, const byte* pData, size_t size) {
+  return TiffParserWorker::scan(scan, pData, size);
+}
+
 WriteMethod TiffParser::encode(BasicIo& io, const byte* pData, size_t size, ByteOrder byteOrder, ExifData& exifData,
                                IptcData& iptcData, XmpData& xmpData) {
   // Delete IFDs which do not occur in TIFF images
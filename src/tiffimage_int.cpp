@@ -6,15 +6,14 @@
 #include "error.hpp"
 #include "i18n.h"  // NLS support.
 #include "image_int.hpp"
+#include "iptc.hpp"
 #include "makernote_int.hpp"
 #include "sonymn_int.hpp"
+#include "tags_int.hpp"
 #include "tiffcomposite_int.hpp"
 #include "tiffimage_int.hpp"
 #include "tiffvisitor_int.hpp"
-
-#ifdef EXIV2_DEBUG_MESSAGES
-#include "tags_int.hpp"
-#endif
+#include "xmp_exiv2.hpp"
 
 #include <array>
 #include <iostream>
@@ -2039,17 +2038,28 @@ TiffPath TiffCreator::getPath(uint32_t extendedTag, IfdId group, uint32_t root)
 }
 
 ByteOrder TiffParserWorker::decode(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, const byte* pData,
-                                   size_t size, uint32_t root, FindDecoderFct findDecoderFct, TiffHeaderBase* pHeader) {
+                                   size_t size, uint32_t root, FindDecoderFct findDecoderFct, TiffHeaderBase* pHeader,
+                                   const ReadFilter& filter, const std::shared_ptr<const DataBuf>& owner) {
   // Create standard TIFF header if necessary
   std::unique_ptr<TiffHeaderBase> ph;
   if (!pHeader) {
     ph = std::make_unique<TiffHeader>();
     pHeader = ph.get();
   }
-
-  if (auto rootDir = parse(pData, size, root, pHeader)) {
-    auto decoder = TiffDecoder(exifData, iptcData, xmpData, rootDir.get(), findDecoderFct);
+  // The tree is only needed until it is decoded
+  TiffArena arena;
+
+  const bool readMakernote = passesMakernote(filter);
+  const bool defer = readMakernote && filter.deferMakernote();
+  // A makernote deferred by an earlier decode into the same container
+  if (exifData.makernote_)
+    exifData.decodeMakernote();
+  if (auto rootDir = parse(pData, size, root, pHeader, readMakernote && !defer, owner)) {
+    auto decoder = TiffDecoder(exifData, iptcData, xmpData, rootDir.get(), findDecoderFct, filter);
     rootDir->accept(decoder);
+    if (defer) {
+      deferMakernote(exifData, decoder, rootDir.get(), pData, size, pHeader->byteOrder(), findDecoderFct);
+    }
   }
   return pHeader->byteOrder();
 
@@ -2066,6 +2076,7 @@ WriteMethod TiffParserWorker::encode(BasicIo& io, const byte* pData, size_t size
         image data in this case.
    */
   WriteMethod writeMethod = wmIntrusive;
+  TiffArena arena;
   auto parsedTree = parse(pData, size, root, pHeader);
   auto primaryGroups = findPrimaryGroups(parsedTree);
   if (parsedTree) {
@@ -2108,7 +2119,8 @@ WriteMethod TiffParserWorker::encode(BasicIo& io, const byte* pData, size_t size
 }  // TiffParserWorker::encode
 
 TiffComponent::UniquePtr TiffParserWorker::parse(const byte* pData, size_t size, uint32_t root,
-                                                 TiffHeaderBase* pHeader) {
+                                                 TiffHeaderBase* pHeader, bool readMakernote,
+                                                 const std::shared_ptr<const DataBuf>& owner) {
   TiffComponent::UniquePtr rootDir;
   if (!pData || size == 0)
     return rootDir;
@@ -2119,7 +2131,7 @@ TiffComponent::UniquePtr TiffParserWorker::parse(const byte* pData, size_t size,
   if (rootDir) {
     rootDir->setStart(pData + pHeader->offset());
     auto state = TiffRwState{pHeader->byteOrder(), 0};
-    auto reader = TiffReader{pData, size, rootDir.get(), state};
+    auto reader = TiffReader{pData, size, rootDir.get(), state, readMakernote, owner};
     rootDir->accept(reader);
     reader.postProcess();
   }
@@ -2127,6 +2139,176 @@ TiffComponent::UniquePtr TiffParserWorker::parse(const byte* pData, size_t size,
 
 }  // TiffParserWorker::parse
 
+ByteOrder TiffParserWorker::scan(ExifScan& scan, const byte* pData, size_t size, TiffHeaderBase* pHeader) {
+  std::unique_ptr<TiffHeaderBase> ph;
+  if (!pHeader) {
+    ph = std::make_unique<TiffHeader>();
+    pHeader = ph.get();
+  }
+
+  scan.clear();
+  if (!pData || size == 0)
+    return pHeader->byteOrder();
+  if (!pHeader->read(pData, size) || pHeader->offset() >= size) {
+    throw Error(ErrorCode::kerNotAnImage, "TIFF");
+  }
+  auto wants = [&scan](IfdId group) {
+    return std::any_of(scan.entries_.begin(), scan.entries_.end(),
+                       [group](const ExifScan::Entry& e) { return e.ifdId_ == group; });
+  };
+  auto [exifOffset, gpsOffset] = scanIfd(scan, pData, size, pHeader->offset(), pHeader->byteOrder(), IfdId::ifd0Id);
+  if (exifOffset != 0 && wants(IfdId::exifId))
+    scanIfd(scan, pData, size, exifOffset, pHeader->byteOrder(), IfdId::exifId);
+  if (gpsOffset != 0 && wants(IfdId::gpsId))
+    scanIfd(scan, pData, size, gpsOffset, pHeader->byteOrder(), IfdId::gpsId);
+  return pHeader->byteOrder();
+
+}  // TiffParserWorker::scan
+
+std::pair<uint32_t, uint32_t> TiffParserWorker::scanIfd(ExifScan& scan, const byte* pData, size_t size,
+                                                        uint32_t offset, ByteOrder byteOrder, IfdId group) {
+  uint32_t exifOffset = 0;
+  uint32_t gpsOffset = 0;
+  if (size < 2 || offset > size - 2)
+    return {exifOffset, gpsOffset};
+  const uint16_t count = getUShort(pData + offset, byteOrder);
+  for (size_t i = 0; i < count && offset + 2 + 12 * (i + 1) <= size; ++i) {
+    const byte* p = pData + offset + 2 + 12 * i;
+    const uint16_t tag = getUShort(p, byteOrder);
+    if (group == IfdId::ifd0Id && tag == 0x8769) {
+      exifOffset = getULong(p + 8, byteOrder);
+      continue;
+    }
+    if (group == IfdId::ifd0Id && tag == 0x8825) {
+      gpsOffset = getULong(p + 8, byteOrder);
+      continue;
+    }
+    auto entry = std::find_if(scan.entries_.begin(), scan.entries_.end(), [=](const ExifScan::Entry& e) {
+      return e.ifdId_ == group && e.tag_ == tag && !e.value_;
+    });
+    if (entry == scan.entries_.end())
+      continue;
+    // Read the value the way TiffReader does, data out of bounds truncates the value
+    const TypeId typeId = toTypeId(static_cast<TiffType>(getUShort(p + 2, byteOrder)), tag, group);
+    const size_t typeSize = std::max<size_t>(TypeInfo::typeSize(typeId), 1);
+    const uint32_t n = getULong(p + 4, byteOrder);
+    if (n >= 0x10000000)
+      continue;
+    size_t dataSize = typeSize * n;
+    const byte* pValue = p + 8;
+    if (dataSize > 4) {
+      const uint32_t valueOffset = getULong(p + 8, byteOrder);
+      if (valueOffset >= size || dataSize > size - valueOffset)
+        dataSize = 0;
+      else
+        pValue = pData + valueOffset;
+    }
+    entry->value_ = Value::create(typeId);
+    entry->value_->read(pValue, dataSize, byteOrder);
+  }
+  return {exifOffset, gpsOffset};
+}
+
+bool TiffParserWorker::passesMakernote(const ReadFilter& filter) {
+  if (filter.empty())
+    return true;
+  for (auto group = ExifTags::groupList(); group->tagList_; ++group) {
+    if (Internal::isMakerIfd(group->ifdId_) && filter.passesGroup(std::string("Exif.") + group->groupName_))
+      return true;
+  }
+  return false;
+}
+
+void TiffParserWorker::deferMakernote(ExifData& exifData, const TiffDecoder& decoder, TiffComponent* pRoot,
+                                      const byte* pData, size_t size, ByteOrder byteOrder,
+                                      FindDecoderFct findDecoderFct) {
+  const auto& makernotes = decoder.unreadMakernotes();
+  if (makernotes.empty())
+    return;
+  auto findValue = [pRoot](uint16_t tag, IfdId group) -> Value::UniquePtr {
+    TiffFinder finder(tag, group);
+    pRoot->accept(finder);
+    auto te = dynamic_cast<const TiffEntryBase*>(finder.result());
+    return te && te->pValue() ? te->pValue()->clone() : nullptr;
+  };
+  std::vector<std::shared_ptr<UnreadMakernote>> mns;
+  size_t end = 0;
+  for (auto&& [entry, pos] : makernotes) {
+    auto mn = std::make_shared<UnreadMakernote>();
+    mn->entry_ = entry->start() - pData;
+    mn->tag_ = entry->tag();
+    mn->group_ = entry->group();
+    mn->byteOrder_ = byteOrder;
+    mn->make_ = findValue(0x010f, IfdId::ifd0Id);
+    mn->model_ = findValue(0x0110, IfdId::ifd0Id);
+    mn->findDecoderFct_ = findDecoderFct;
+    // Values in the makernote may be anywhere in the TIFF data, only
+    // reading the makernote finds the end of its data
+    TiffExtent extent(pData, size);
+    readMakernote(*mn, pData, size)->accept(extent);
+    end = std::max(end, extent.end());
+    // The unread makernote tag has all of its data, as it was written
+    if (entry->pData())
+      end = std::max(end, static_cast<size_t>(entry->pData() - pData) + entry->size());
+    mns.push_back(std::move(mn));
+  }
+  auto data = std::make_shared<const DataBuf>(pData, end);
+  for (size_t i = 0; i < mns.size(); ++i) {
+    auto mn = mns[i];
+    mn->data_ = data;
+    const auto pos = makernotes[i].second;
+    if (pos == exifData.end()) {
+      // Without its tag, decode the makernote right away
+      exifData.exifMetadata_.splice(exifData.exifMetadata_.end(), decodeMakernote(*mn));
+      exifData.rebuildIndex();
+      continue;
+    }
+    exifData.makernote_ = ExifData::DeferredMakernote{pos, [mn] { return decodeMakernote(*mn); }};
+    // Only one makernote is deferred, others are decoded right away
+    if (i + 1 != mns.size())
+      exifData.decodeMakernote();
+  }
+}  // TiffParserWorker::deferMakernote
+
+std::unique_ptr<TiffComponent> TiffParserWorker::readMakernote(const UnreadMakernote& mn, const byte* pData,
+                                                              size_t size, const std::shared_ptr<const DataBuf>& owner) {
+  // A tree with the makernote tag and the tags which reading the makernote looks up
+  auto root = std::make_unique<TiffDirectory>(Tag::root, IfdId::ifd0Id);
+  for (auto [tag, value] : {std::pair{uint16_t{0x010f}, mn.make_.get()}, std::pair{uint16_t{0x0110}, mn.model_.get()}}) {
+    if (!value)
+      continue;
+    auto entry = std::make_unique<TiffEntry>(tag, IfdId::ifd0Id);
+    entry->setValue(value->clone());
+    root->addChild(std::move(entry));
+  }
+  auto mnEntry = root->addChild(newTiffMnEntry(mn.tag_, mn.group_));
+  mnEntry->setStart(pData + mn.entry_);
+
+  auto reader = TiffReader{pData, size, root.get(), TiffRwState{mn.byteOrder_, 0}, true, owner};
+  mnEntry->accept(reader);
+  reader.postProcess();
+  return root;
+}  // TiffParserWorker::readMakernote
+
+ExifMetadata TiffParserWorker::decodeMakernote(const UnreadMakernote& mn) {
+  TiffArena arena;
+  auto root = readMakernote(mn, mn.data_->c_data(), mn.data_->size(), mn.data_);
+  TiffFinder finder(mn.tag_, mn.group_);
+  root->accept(finder);
+  auto mnEntry = finder.result();
+
+  ExifData exifData;
+  IptcData iptcData;
+  XmpData xmpData;
+  auto decoder = TiffDecoder(exifData, iptcData, xmpData, root.get(), mn.findDecoderFct_);
+  mnEntry->accept(decoder);
+  // The makernote tag itself is in the container already
+  auto metadata = std::move(exifData.exifMetadata_);
+  if (!metadata.empty() && metadata.front().tag() == mn.tag_ && metadata.front().ifdId() == mn.group_)
+    metadata.pop_front();
+  return metadata;
+}  // TiffParserWorker::decodeMakernote
+
 PrimaryGroups TiffParserWorker::findPrimaryGroups(const TiffComponent::UniquePtr& pSourceDir) {
   PrimaryGroups ret;
   if (!pSourceDir)
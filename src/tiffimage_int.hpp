@@ -181,6 +181,22 @@ class TiffCreator {
   static const TiffGroupTable tiffGroupTable_;  //!< TIFF group structure
 };
 
+/*!
+  @brief A makernote which was not read with the TIFF tree, with a copy of
+         the TIFF data up to the end of the makernote and of the tags of the
+         tree which reading the makernote uses.
+ */
+struct UnreadMakernote {
+  std::shared_ptr<const DataBuf> data_;  //!< Copy of the TIFF data up to the end of the makernote data
+  size_t entry_{};                       //!< Offset of the IFD entry of the makernote tag in the data
+  uint16_t tag_{};                       //!< Makernote tag
+  IfdId group_{};                        //!< Group of the makernote tag
+  ByteOrder byteOrder_{};                //!< Byte order of the TIFF data
+  Value::UniquePtr make_;                //!< Exif.Image.Make, if there is one
+  Value::UniquePtr model_;               //!< Exif.Image.Model, if there is one
+  FindDecoderFct findDecoderFct_;        //!< Function to access special decoding info
+};
+
 /*!
   @brief Stateless parser class for data in TIFF format. Images use this
          class to decode and encode TIFF-based data.
@@ -205,12 +221,36 @@ class TiffParserWorker {
     @param findDecoderFct Function to access special decoding info.
     @param pHeader   Optional pointer to a TIFF header. If not provided,
                      a standard TIFF header is used.
+    @param filter    The metadata to decode. The makernote is not read if
+                     the filter passes none of its groups, and it is only
+                     read when \em exifData first needs it if the filter
+                     defers it.
+    @param owner     Optional buffer which holds the data. The decoded
+                     values may then keep it and refer to it instead of
+                     copying large blobs, so it must not change any more.
 
     @return Byte order in which the data is encoded, invalidByteOrder if
             decoding failed.
   */
   static ByteOrder decode(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, const byte* pData, size_t size,
-                          uint32_t root, FindDecoderFct findDecoderFct, TiffHeaderBase* pHeader = nullptr);
+                          uint32_t root, FindDecoderFct findDecoderFct, TiffHeaderBase* pHeader = nullptr,
+                          const ReadFilter& filter = {}, const std::shared_ptr<const DataBuf>& owner = nullptr);
+  /*!
+    @brief Read the tags requested by \em scan from the TIFF data in
+           \em pData of length \em size, without parsing it into a TIFF
+           composite structure. Only IFD0 and its Exif and GPS IFDs are
+           read; the root directory is read as IFD0.
+
+    @param scan      The tags to read and the values found.
+    @param pData     Pointer to the data buffer. Must point to data
+                     in TIFF format; no checks are performed.
+    @param size      Length of the data buffer.
+    @param pHeader   Optional pointer to a TIFF header. If not provided,
+                     a standard TIFF header is used.
+
+    @return Byte order in which the data is encoded.
+  */
+  static ByteOrder scan(ExifScan& scan, const byte* pData, size_t size, TiffHeaderBase* pHeader = nullptr);
   /*!
     @brief Encode TIFF metadata from the metadata containers into a
            memory block \em blob.
@@ -235,11 +275,42 @@ class TiffParserWorker {
     @param size      Length of the data buffer.
     @param root      Root tag of the TIFF tree.
     @param pHeader   Pointer to a TIFF header.
+    @param readMakernote False to leave the makernote unread.
+    @param owner     Optional buffer which holds the data, see TiffReader.
     @return          An auto pointer with the root element of the TIFF
                      composite structure. If \em pData is 0 or \em size
                      is 0, the return value is a 0 pointer.
    */
-  static std::unique_ptr<TiffComponent> parse(const byte* pData, size_t size, uint32_t root, TiffHeaderBase* pHeader);
+  static std::unique_ptr<TiffComponent> parse(const byte* pData, size_t size, uint32_t root, TiffHeaderBase* pHeader,
+                                              bool readMakernote = true,
+                                              const std::shared_ptr<const DataBuf>& owner = nullptr);
+  //! Return true if \em filter passes any of the makernote groups
+  static bool passesMakernote(const ReadFilter& filter);
+  /*!
+    @brief Keep a copy of the TIFF data up to the end of the makernotes
+           which \em decoder found unread in the tree \em pRoot, for
+           \em exifData to decode the makernote when it is first needed.
+           The makernotes are read to find the end of their data, which
+           may be anywhere in the TIFF data.
+   */
+  static void deferMakernote(ExifData& exifData, const TiffDecoder& decoder, TiffComponent* pRoot,
+                             const byte* pData, size_t size, ByteOrder byteOrder, FindDecoderFct findDecoderFct);
+  /*!
+    @brief Read the makernote \em mn from the TIFF data \em pData of \em size
+           bytes, in a tree of its own with the tags it uses. Return the
+           tree.
+   */
+  static std::unique_ptr<TiffComponent> readMakernote(const UnreadMakernote& mn, const byte* pData, size_t size,
+                                                      const std::shared_ptr<const DataBuf>& owner = nullptr);
+  //! Read and decode the makernote \em mn, return its metadata.
+  static ExifMetadata decodeMakernote(const UnreadMakernote& mn);
+  /*!
+    @brief Read the tags of \em group requested by \em scan from the IFD at
+           \em offset. Return the offsets of the Exif and the GPS IFD, 0 if
+           the IFD has no pointer to them.
+   */
+  static std::pair<uint32_t, uint32_t> scanIfd(ExifScan& scan, const byte* pData, size_t size, uint32_t offset,
+                                               ByteOrder byteOrder, IfdId group);
   /*!
     @brief Find primary groups in the source tree provided and populate
            the list of primary groups.
@@ -19,6 +19,7 @@
 #include "value.hpp"
 #include "xmp_exiv2.hpp"
 
+#include <algorithm>
 #include <functional>
 #include <iomanip>
 
@@ -28,22 +29,15 @@
 
 // *****************************************************************************
 namespace {
-//! Unary predicate that matches an Exifdatum with a given group and index.
-class FindExifdatum2 {
- public:
-  //! Constructor, initializes the object with the group and index to look for.
-  FindExifdatum2(Exiv2::IfdId group, int idx) : groupName_(Exiv2::Internal::groupName(group)), idx_(idx) {
-  }
-  //! Returns true if group and index match.
-  bool operator()(const Exiv2::Exifdatum& md) const {
-    return idx_ == md.idx() && md.groupName() == groupName_;
-  }
-
- private:
-  const char* groupName_;
-  int idx_;
+//! Smallest value which TiffReader lets refer to its buffer rather than copy
+constexpr size_t minBorrowSize = 64;
+//! Largest buffer which TiffReader lends, a value may keep all of it alive
+constexpr size_t maxLendSize = 256 * 1024;
 
-};  // class FindExifdatum2
+//! Return the key of the TiffEncoder index for a group and index
+uint64_t idxKey(Exiv2::IfdId group, int idx) {
+  return (static_cast<uint64_t>(group) << 32) | static_cast<uint32_t>(idx);
+}
 
 Exiv2::ByteOrder stringToByteOrder(std::string_view val) {
   if (val == "II")
@@ -132,6 +126,60 @@ void TiffFinder::visitBinaryElement(TiffBinaryElement* object) {
   findObject(object);
 }
 
+void TiffExtent::extend(const byte* p, size_t size) {
+  // Deciphered binary arrays are not in the data
+  if (p < pData_ || p >= pData_ + size_)
+    return;
+  const auto offset = static_cast<size_t>(p - pData_);
+  end_ = std::max(end_, offset + std::min(size, size_ - offset));
+}
+
+void TiffExtent::extendEntry(const TiffEntryBase* object) {
+  extend(object->start(), 16);
+  extend(object->pData(), object->size());
+}
+
+void TiffExtent::visitEntry(TiffEntry* object) {
+  extendEntry(object);
+}
+
+void TiffExtent::visitDataEntry(TiffDataEntry* object) {
+  extendEntry(object);
+  extend(object->pDataArea_, object->sizeDataArea_);
+}
+
+void TiffExtent::visitImageEntry(TiffImageEntry* object) {
+  extendEntry(object);
+}
+
+void TiffExtent::visitSizeEntry(TiffSizeEntry* object) {
+  extendEntry(object);
+}
+
+void TiffExtent::visitDirectory(TiffDirectory* /*object*/) {
+  // Nothing to do
+}
+
+void TiffExtent::visitSubIfd(TiffSubIfd* object) {
+  extendEntry(object);
+}
+
+void TiffExtent::visitMnEntry(TiffMnEntry* object) {
+  extendEntry(object);
+}
+
+void TiffExtent::visitIfdMakernote(TiffIfdMakernote* /*object*/) {
+  // Nothing to do
+}
+
+void TiffExtent::visitBinaryArray(TiffBinaryArray* object) {
+  extendEntry(object);
+}
+
+void TiffExtent::visitBinaryElement(TiffBinaryElement* /*object*/) {
+  // Nothing to do
+}
+
 TiffCopier::TiffCopier(TiffComponent* pRoot, uint32_t root, const TiffHeaderBase* pHeader,
                        PrimaryGroups pPrimaryGroups) :
     pRoot_(pRoot), root_(root), pHeader_(pHeader), pPrimaryGroups_(std::move(pPrimaryGroups)) {
@@ -191,8 +239,13 @@ void TiffCopier::visitBinaryElement(TiffBinaryElement* object) {
 }
 
 TiffDecoder::TiffDecoder(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, TiffComponent* pRoot,
-                         FindDecoderFct findDecoderFct) :
-    exifData_(exifData), iptcData_(iptcData), xmpData_(xmpData), pRoot_(pRoot), findDecoderFct_(findDecoderFct) {
+                         FindDecoderFct findDecoderFct, const ReadFilter& filter) :
+    exifData_(exifData),
+    iptcData_(iptcData),
+    xmpData_(xmpData),
+    pRoot_(pRoot),
+    findDecoderFct_(findDecoderFct),
+    filter_(filter) {
   // #1402 Fujifilm RAF. Search for the make
   // Find camera make in existing metadata (read from the JPEG)
   ExifKey key("Exif.Image.Make");
@@ -235,7 +288,11 @@ void TiffDecoder::visitSubIfd(TiffSubIfd* object) {
 
 void TiffDecoder::visitMnEntry(TiffMnEntry* object) {
   // Always decode binary makernote tag
+  const size_t count = exifData_.count();
   decodeTiffEntry(object);
+  if (!object->mn_ && filter_.deferMakernote()) {
+    unreadMakernotes_.emplace_back(object, exifData_.count() > count ? std::prev(exifData_.end()) : exifData_.end());
+  }
 }
 
 void TiffDecoder::visitIfdMakernote(TiffIfdMakernote* object) {
@@ -284,7 +341,7 @@ void TiffDecoder::decodeXmp(const TiffEntryBase* object) {
 #endif
       xmpPacket = xmpPacket.substr(idx);
     }
-    if (XmpParser::decode(xmpData_, xmpPacket)) {
+    if (XmpParser::decode(xmpData_, xmpPacket, filter_)) {
 #ifndef SUPPRESS_WARNINGS
       EXV_WARNING << "Failed to decode XMP metadata.\n";
 #endif
@@ -307,7 +364,7 @@ void TiffDecoder::decodeIptc(const TiffEntryBase* object) {
   size_t size = 0;
   getObjData(pData, size, 0x83bb, IfdId::ifd0Id, object);
   if (pData) {
-    if (0 == IptcParser::decode(iptcData_, pData, size)) {
+    if (0 == IptcParser::decode(iptcData_, pData, size, filter_)) {
       return;
     }
 #ifndef SUPPRESS_WARNINGS
@@ -328,7 +385,7 @@ void TiffDecoder::decodeIptc(const TiffEntryBase* object) {
     if (0 != Photoshop::locateIptcIrb(pData, size, &record, sizeHdr, sizeData)) {
       return;
     }
-    if (0 == IptcParser::decode(iptcData_, record + sizeHdr, sizeData)) {
+    if (0 == IptcParser::decode(iptcData_, record + sizeHdr, sizeData, filter_)) {
       return;
     }
 #ifndef SUPPRESS_WARNINGS
@@ -485,7 +542,7 @@ void TiffEncoder::encodeIptc() {
   auto pos = exifData_.findKey(iptcNaaKey);
   if (pos != exifData_.end()) {
     iptcNaaKey.setIdx(pos->idx());
-    exifData_.erase(pos);
+    erase(pos);
     del = true;
   }
   DataBuf rawIptc = IptcParser::encode(iptcData_);
@@ -515,7 +572,7 @@ void TiffEncoder::encodeIptc() {
     DataBuf irbBuf(pos->value().size());
     pos->value().copy(irbBuf.data(), invalidByteOrder);
     irbBuf = Photoshop::setIptcIrb(irbBuf.c_data(), irbBuf.size(), iptcData_);
-    exifData_.erase(pos);
+    erase(pos);
     if (!irbBuf.empty()) {
       auto value = Value::create(unsignedByte);
       value->read(irbBuf.data(), irbBuf.size(), invalidByteOrder);
@@ -531,7 +588,7 @@ void TiffEncoder::encodeXmp() {
   // Remove any existing XMP Exif tag
   if (auto pos = exifData_.findKey(xmpKey); pos != exifData_.end()) {
     xmpKey.setIdx(pos->idx());
-    exifData_.erase(pos);
+    erase(pos);
   }
   std::string xmpPacket;
   if (xmpData_.usePacket()) {
@@ -623,7 +680,7 @@ void TiffEncoder::visitMnEntry(TiffMnEntry* object) {
     ExifKey key(object->tag(), groupName(object->group()));
     auto pos = exifData_.findKey(key);
     if (pos != exifData_.end())
-      exifData_.erase(pos);
+      erase(pos);
   }
 }
 
@@ -637,7 +694,7 @@ void TiffEncoder::visitIfdMakernote(TiffIfdMakernote* object) {
       setDirty();
     }
     if (del_)
-      exifData_.erase(pos);
+      erase(pos);
   }
   if (del_) {
     // Remove remaining synthesized tags
@@ -647,7 +704,7 @@ void TiffEncoder::visitIfdMakernote(TiffIfdMakernote* object) {
     for (auto synthesizedTag : synthesizedTags) {
       pos = exifData_.findKey(ExifKey(synthesizedTag));
       if (pos != exifData_.end())
-        exifData_.erase(pos);
+        erase(pos);
     }
   }
   // Modify encoder for Makernote peculiarities, byte order
@@ -718,8 +775,8 @@ void TiffEncoder::encodeTiffComponent(TiffEntryBase* object, const Exifdatum* da
       ed = &(*pos);
       if (object->idx() != pos->idx()) {
         // Try to find exact match (in case of duplicate tags)
-        auto pos2 = std::find_if(exifData_.begin(), exifData_.end(), FindExifdatum2(object->group(), object->idx()));
-        if (pos2 != exifData_.end() && pos2->key() == key.key()) {
+        auto pos2 = findIdx(object->group(), object->idx());
+        if (pos2 != exifData_.end() && pos2->ifdId() == key.ifdId() && pos2->tag() == key.tag()) {
           ed = &(*pos2);
           pos = pos2;  // make sure we delete the correct tag below
         }
@@ -748,13 +805,44 @@ void TiffEncoder::encodeTiffComponent(TiffEntryBase* object, const Exifdatum* da
     }
   }
   if (del_ && pos != exifData_.end()) {
-    exifData_.erase(pos);
+    erase(pos);
   }
 #ifdef EXIV2_DEBUG_MESSAGES
   std::cerr << "\n";
 #endif
 }  // TiffEncoder::encodeTiffComponent
 
+ExifData::iterator TiffEncoder::findIdx(IfdId group, int idx) {
+  if (!idxIndexed_) {
+    idxIndex_.reserve(exifData_.count());
+    for (auto pos = exifData_.begin(); pos != exifData_.end(); ++pos) {
+      auto [entry, inserted] = idxIndex_.try_emplace(idxKey(pos->ifdId(), pos->idx()), IdxEntry{pos, 1});
+      if (!inserted)
+        ++entry->second.count_;
+    }
+    idxIndexed_ = true;
+  }
+  auto entry = idxIndex_.find(idxKey(group, idx));
+  return entry != idxIndex_.end() ? entry->second.first_ : exifData_.end();
+}
+
+void TiffEncoder::erase(ExifData::iterator pos) {
+  if (idxIndexed_) {
+    const auto k = idxKey(pos->ifdId(), pos->idx());
+    if (auto entry = idxIndex_.find(k); entry != idxIndex_.end()) {
+      if (--entry->second.count_ == 0) {
+        idxIndex_.erase(entry);
+      } else if (entry->second.first_ == pos) {
+        // Find the next Exifdatum with the same group and idx
+        entry->second.first_ = std::find_if(std::next(pos), exifData_.end(), [k](const Exifdatum& md) {
+          return idxKey(md.ifdId(), md.idx()) == k;
+        });
+      }
+    }
+  }
+  exifData_.erase(pos);
+}
+
 void TiffEncoder::encodeBinaryArray(TiffBinaryArray* object, const Exifdatum* datum) {
   encodeOffsetEntry(object, datum);
 }  // TiffEncoder::encodeBinaryArray
@@ -926,7 +1014,7 @@ void TiffEncoder::add(TiffComponent* pRootDir, TiffComponent::UniquePtr pSourceD
 
   auto posBo = exifData_.end();
   for (auto i = exifData_.begin(); i != exifData_.end(); ++i) {
-    IfdId group = groupId(i->groupName());
+    IfdId group = i->ifdId();
     // Skip synthesized info tags
     if (group == IfdId::mnId) {
       if (i->tag() == 0x0002) {
@@ -978,8 +1066,16 @@ void TiffEncoder::add(TiffComponent* pRootDir, TiffComponent::UniquePtr pSourceD
 
 }  // TiffEncoder::add
 
-TiffReader::TiffReader(const byte* pData, size_t size, TiffComponent* pRoot, TiffRwState state) :
-    pData_(pData), size_(size), pLast_(pData + size), pRoot_(pRoot), origState_(state), mnState_(state) {
+TiffReader::TiffReader(const byte* pData, size_t size, TiffComponent* pRoot, TiffRwState state, bool readMakernote,
+                       std::shared_ptr<const DataBuf> owner) :
+    pData_(pData),
+    size_(size),
+    pLast_(pData + size),
+    pRoot_(pRoot),
+    origState_(state),
+    mnState_(state),
+    readMakernote_(readMakernote),
+    owner_(owner && owner->size() <= maxLendSize ? std::move(owner) : nullptr) {
   pState_ = &origState_;
 
 }  // TiffReader::TiffReader
@@ -1186,7 +1282,7 @@ void TiffReader::visitMnEntry(TiffMnEntry* object) {
   TiffFinder finder(0x010f, IfdId::ifd0Id);
   pRoot_->accept(finder);
   auto te = dynamic_cast<const TiffEntryBase*>(finder.result());
-  if (te && te->pValue()) {
+  if (readMakernote_ && te && te->pValue()) {
     auto make = te->pValue()->toString();
     // create concrete makernote, based on make and makernote contents
     object->mn_ =
@@ -1318,11 +1414,15 @@ void TiffReader::readTiffEntry(TiffEntryBase* object) {
     }
     auto v = Value::create(typeId);
     enforce(v != nullptr, ErrorCode::kerCorruptedMetadata);
-    v->read(pData, size, byteOrder());
+    // Large blobs like makernotes or ICC profiles refer to the buffer, if they can
+    auto dv = owner_ && size >= minBorrowSize ? dynamic_cast<DataValue*>(v.get()) : nullptr;
+    if (dv)
+      dv->borrow(std::shared_ptr<const byte>(owner_, pData), size);
+    else
+      v->read(pData, size, byteOrder());
 
     object->setValue(std::move(v));
-    auto d = std::make_shared<DataBuf>();
-    object->setData(pData, size, std::move(d));
+    object->setData(pData, size, nullptr);
     object->setOffset(offset);
     object->setIdx(nextIdx(object->group()));
   } catch (std::overflow_error&) {
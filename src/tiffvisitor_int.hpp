@@ -10,6 +10,7 @@
 #include "tiffcomposite_int.hpp"
 
 #include <array>
+#include <unordered_map>
 
 // *****************************************************************************
 // namespace extensions
@@ -184,6 +185,67 @@ class TiffFinder : public TiffVisitor {
   TiffComponent* tiffComponent_{};
 };  // class TiffFinder
 
+/*!
+  @brief Find the end of the data which the entries of a tree were read
+         from, including the data areas of their values. The data areas of
+         image entries are not included, decoding doesn't copy them.
+*/
+class TiffExtent : public TiffVisitor {
+ public:
+  //! @name Creators
+  //@{
+  //! Constructor, taking the data \em pData of \em size bytes which the tree was read from.
+  constexpr TiffExtent(const byte* pData, size_t size) : pData_(pData), size_(size) {
+  }
+  TiffExtent(const TiffExtent&) = delete;
+  TiffExtent& operator=(const TiffExtent&) = delete;
+  //! Virtual destructor
+  ~TiffExtent() override = default;
+  //@}
+
+  //! @name Manipulators
+  //@{
+  //! Extend to the end of a TIFF entry
+  void visitEntry(TiffEntry* object) override;
+  //! Extend to the end of a TIFF data entry and of its data area
+  void visitDataEntry(TiffDataEntry* object) override;
+  //! Extend to the end of a TIFF image entry
+  void visitImageEntry(TiffImageEntry* object) override;
+  //! Extend to the end of a TIFF size entry
+  void visitSizeEntry(TiffSizeEntry* object) override;
+  //! Nothing to do for a TIFF directory, its entries extend it
+  void visitDirectory(TiffDirectory* object) override;
+  //! Extend to the end of a TIFF sub-IFD
+  void visitSubIfd(TiffSubIfd* object) override;
+  //! Extend to the end of a TIFF makernote
+  void visitMnEntry(TiffMnEntry* object) override;
+  //! Nothing to do for an IFD makernote, the makernote entry and the IFD extend it
+  void visitIfdMakernote(TiffIfdMakernote* object) override;
+  //! Extend to the end of a binary array
+  void visitBinaryArray(TiffBinaryArray* object) override;
+  //! Nothing to do for an element of a binary array, the array extends it
+  void visitBinaryElement(TiffBinaryElement* object) override;
+  //@}
+
+  //! @name Accessors
+  //@{
+  //! Return the offset of the end of the data from its start
+  [[nodiscard]] size_t end() const {
+    return end_;
+  }
+  //@}
+
+ private:
+  //! Extend to the end of the IFD entry \em object, the next IFD pointer after it and its value
+  void extendEntry(const TiffEntryBase* object);
+  //! Extend to the end of \em size bytes at \em p, if they are in the data
+  void extend(const byte* p, size_t size);
+
+  const byte* pData_;  //!< Start of the data
+  size_t size_;        //!< Size of the data
+  size_t end_{};       //!< Offset of the end of the data, at most its size
+};  // class TiffExtent
+
 /*!
   @brief Copy all image tags from the source tree (the tree that is traversed) to a
          target tree, which is empty except for the root element provided in the
@@ -250,15 +312,22 @@ class TiffCopier : public TiffVisitor {
  */
 class TiffDecoder : public TiffVisitor {
  public:
+  /*!
+    @brief Makernote tags whose makernote was not read, with the position of
+           their Exifdatum, or the end of the Exif data if it was not decoded.
+   */
+  using UnreadMakernotes = std::vector<std::pair<const TiffMnEntry*, ExifData::iterator>>;
+
   //! @name Creators
   //@{
   /*!
     @brief Constructor, taking metadata containers to add the metadata to,
-           the root element of the composite to decode and a FindDecoderFct
-           function to get the decoder function for each tag.
+           the root element of the composite to decode, a FindDecoderFct
+           function to get the decoder function for each tag and the
+           filter for the embedded IPTC and XMP metadata.
    */
   TiffDecoder(ExifData& exifData, IptcData& iptcData, XmpData& xmpData, TiffComponent* pRoot,
-              FindDecoderFct findDecoderFct);
+              FindDecoderFct findDecoderFct, const ReadFilter& filter = {});
   TiffDecoder(const TiffDecoder&) = delete;
   TiffDecoder& operator=(const TiffDecoder&) = delete;
   //! Virtual destructor
@@ -300,6 +369,14 @@ class TiffDecoder : public TiffVisitor {
   void decodeCanonAFInfo(const TiffEntryBase* object);
   //@}
 
+  //! @name Accessors
+  //@{
+  //! Return the makernote tags whose makernote was not read, if the filter defers the makernote
+  [[nodiscard]] const UnreadMakernotes& unreadMakernotes() const {
+    return unreadMakernotes_;
+  }
+  //@}
+
  private:
   //! @name Manipulators
   //@{
@@ -315,13 +392,15 @@ class TiffDecoder : public TiffVisitor {
   //@}
 
   // DATA
-  ExifData& exifData_;             //!< Exif metadata container
-  IptcData& iptcData_;             //!< IPTC metadata container
-  XmpData& xmpData_;               //!< XMP metadata container
-  TiffComponent* pRoot_;           //!< Root element of the composite
-  FindDecoderFct findDecoderFct_;  //!< Ptr to the function to find special decoding functions
-  std::string make_;               //!< Camera make, determined from the tags to decode
-  bool decodedIptc_{false};        //!< Indicates if IPTC has been decoded yet
+  ExifData& exifData_;                 //!< Exif metadata container
+  IptcData& iptcData_;                 //!< IPTC metadata container
+  XmpData& xmpData_;                   //!< XMP metadata container
+  TiffComponent* pRoot_;               //!< Root element of the composite
+  FindDecoderFct findDecoderFct_;      //!< Ptr to the function to find special decoding functions
+  ReadFilter filter_;                  //!< Metadata to decode from embedded IPTC and XMP
+  std::string make_;                   //!< Camera make, determined from the tags to decode
+  bool decodedIptc_{false};            //!< Indicates if IPTC has been decoded yet
+  UnreadMakernotes unreadMakernotes_;  //!< Makernote tags whose makernote was not read
 
 };  // class TiffDecoder
 
@@ -485,6 +564,14 @@ class TiffEncoder : public TiffVisitor {
     This method is called from the constructor.
    */
   void encodeXmp();
+  /*!
+    @brief Return the first Exifdatum with \em group and \em idx, or
+           exifData_.end(). The index by group and idx is built on first
+           use, once per encoder.
+   */
+  ExifData::iterator findIdx(IfdId group, int idx);
+  //! Erase the Exifdatum at \em pos from exifData_ and from the index by group and idx
+  void erase(ExifData::iterator pos);
   //@}
 
   //! @name Accessors
@@ -507,6 +594,12 @@ class TiffEncoder : public TiffVisitor {
   [[nodiscard]] bool isImageTag(uint16_t tag, IfdId group) const;
   //@}
 
+  //! Index entry: the first Exifdatum with a group and idx and the number of entries with them
+  struct IdxEntry {
+    ExifData::iterator first_;  //!< Position of the first Exifdatum with the group and idx
+    size_t count_;              //!< Number of Exifdatum instances with the group and idx
+  };
+
   // DATA
   ExifData exifData_;                        //!< Copy of the Exif data to encode
   const IptcData& iptcData_;                 //!< IPTC data to encode, just a reference
@@ -523,6 +616,8 @@ class TiffEncoder : public TiffVisitor {
   std::string make_;                         //!< Camera make, determined from the tags to encode
   bool dirty_{false};                        //!< Signals if any tag is deleted or allocated
   WriteMethod writeMethod_{wmNonIntrusive};  //!< Write method used.
+  std::unordered_map<uint64_t, IdxEntry> idxIndex_;  //!< Exif data entries by group and idx
+  bool idxIndexed_{false};                           //!< Indicates if idxIndex_ has been built
 
 };  // class TiffEncoder
 
@@ -588,8 +683,16 @@ class TiffReader : public TiffVisitor {
     @param pRoot     Root element of the TIFF composite.
     @param state     State object for creation function, byte order and
                      base offset.
+    @param readMakernote False to leave the makernote as an undefined
+                     entry, without reading its IFD and binary arrays.
+    @param owner     Optional buffer which holds the data. Large undefined
+                     and byte values then refer to it instead of copying
+                     their data, so it must not change any more. Buffers
+                     larger than 256 KB are not lent, since a small value
+                     would keep all of the buffer alive.
    */
-  TiffReader(const byte* pData, size_t size, TiffComponent* pRoot, TiffRwState state);
+  TiffReader(const byte* pData, size_t size, TiffComponent* pRoot, TiffRwState state, bool readMakernote = true,
+             std::shared_ptr<const DataBuf> owner = nullptr);
   TiffReader(const TiffReader&) = delete;
   TiffReader& operator=(const TiffReader&) = delete;
 
@@ -677,6 +780,8 @@ class TiffReader : public TiffVisitor {
   IdxSeq idxSeq_;          //!< Sequences for group, used for the entry's idx
   PostList postList_;      //!< List of components with deferred reading
   bool postProc_{false};   //!< True in postProcessList()
+  bool readMakernote_;     //!< False to skip the makernote
+  std::shared_ptr<const DataBuf> owner_;  //!< Buffer which holds the data, if any
 };
 
 }  // namespace Internal
@@ -18,6 +18,14 @@
 #include <iomanip>
 #include <numeric>
 
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define EXV_SWAP_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define EXV_SWAP_NEON
+#endif
+
 #include <filesystem>
 namespace fs = std::filesystem;
 
@@ -476,6 +484,77 @@ size_t d2Data(byte* buf, double d, ByteOrder byteOrder) {
   return 8;
 }
 
+//! Copy \em count numbers of N bytes each from \em src to \em dst, reversing the bytes of each number
+template <size_t N>
+static void copySwapped(byte* dst, const byte* src, size_t count) {
+  const size_t len = count * N;
+  size_t i = 0;
+#if defined(EXV_SWAP_SSE2)
+  for (; i + 16 <= len; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+    if constexpr (N >= 4)
+      v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0xb1), 0xb1);
+    if constexpr (N == 8)
+      v = _mm_shuffle_epi32(v, 0xb1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+  }
+#elif defined(EXV_SWAP_NEON)
+  for (; i + 16 <= len; i += 16) {
+    uint8x16_t v = vld1q_u8(src + i);
+    if constexpr (N == 2)
+      v = vrev16q_u8(v);
+    else if constexpr (N == 4)
+      v = vrev32q_u8(v);
+    else
+      v = vrev64q_u8(v);
+    vst1q_u8(dst + i, v);
+  }
+#endif
+  for (; i < len; i += N) {
+    for (size_t k = 0; k < N; ++k)
+      dst[i + k] = src[i + N - 1 - k];
+  }
+}
+
+void copyValues(void* dst, const void* src, size_t count, size_t size, ByteOrder byteOrder) {
+  if (count == 0)
+    return;
+  auto d = static_cast<byte*>(dst);
+  auto s = static_cast<const byte*>(src);
+  if (size == 1 || (byteOrder == littleEndian) == (std::endian::native == std::endian::little)) {
+    Internal::enforce(size == 1 || size == 2 || size == 4 || size == 8, ErrorCode::kerUnsupportedDataAreaOffsetType);
+    std::memcpy(d, s, count * size);
+    return;
+  }
+  switch (size) {
+    case 2:
+      copySwapped<2>(d, s, count);
+      break;
+    case 4:
+      copySwapped<4>(d, s, count);
+      break;
+    case 8:
+      copySwapped<8>(d, s, count);
+      break;
+    default:
+      throw Error(ErrorCode::kerUnsupportedDataAreaOffsetType);
+  }
+}
+
+std::string toFixedString(double value, int precision) {
+#ifdef __cpp_lib_to_chars
+  char buf[64];
+  if (auto [ptr, ec] = std::to_chars(buf, buf + sizeof(buf), value, std::chars_format::fixed, precision);
+      ec == std::errc())
+    return {buf, ptr};
+#endif
+  // Numbers which are too long for the buffer
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(precision) << value;
+  return os.str();
+}
+
 void hexdump(std::ostream& os, const byte* buf, size_t len, size_t offset) {
   const size_t hexbase = 16;
   const std::string::size_type pos = 8 + (hexbase * 3) + 2;
@@ -75,6 +75,10 @@ int Value::setDataArea(const byte* /*buf*/, size_t /*len*/) {
 }
 
 std::string Value::toString() const {
+  return toString_();
+}
+
+std::string Value::toString_() const {
   std::ostringstream os;
   write(os);
   ok_ = !os.fail();
@@ -106,29 +110,58 @@ size_t DataValue::count() const {
 
 int DataValue::read(const byte* buf, size_t len, ByteOrder /*byteOrder*/) {
   // byteOrder not needed
-  value_.assign(buf, buf + len);
+  setValue(DataBuf(buf, len));
   return 0;
 }
 
 int DataValue::read(const std::string& buf) {
-  std::istringstream is(buf);
-  int tmp = 0;
-  ValueType val;
-  while (is >> tmp)
-    val.push_back(tmp);
-  if (!is.eof())
-    return 1;
-  value_ = std::move(val);
+  std::vector<int> numbers;
+  if (!parseNumbers(buf, numbers)) {
+    // Leave the input which parseNumbers() does not handle to a stream
+    numbers.clear();
+    std::istringstream is(buf);
+    int tmp = 0;
+    while (is >> tmp)
+      numbers.push_back(tmp);
+    if (!is.eof())
+      return 1;
+  }
+  DataBuf data(numbers.size());
+  std::copy(numbers.begin(), numbers.end(), data.begin());
+  setValue(std::move(data));
   return 0;
 }
 
+void DataValue::borrow(std::shared_ptr<const byte> buf, size_t len) {
+  value_ = len > 0 ? std::move(buf) : nullptr;
+  size_ = len;
+}
+
+void DataValue::setValue(DataBuf&& buf) {
+  size_ = buf.size();
+  if (size_ == 0) {
+    value_.reset();
+    return;
+  }
+  auto data = std::make_shared<const DataBuf>(std::move(buf));
+  value_ = std::shared_ptr<const byte>(data, data->c_data());
+}
+
+byte DataValue::at(size_t n) const {
+  if (n >= size_)
+    throw std::out_of_range("DataValue::at");
+  return value_.get()[n];
+}
+
 size_t DataValue::copy(byte* buf, ByteOrder /*byteOrder*/) const {
   // byteOrder not needed
-  return std::copy(value_.begin(), value_.end(), buf) - buf;
+  if (size_ > 0)
+    std::memcpy(buf, value_.get(), size_);
+  return size_;
 }
 
 size_t DataValue::size() const {
-  return value_.size();
+  return size_;
 }
 
 DataValue* DataValue::clone_() const {
@@ -136,36 +169,50 @@ DataValue* DataValue::clone_() const {
 }
 
 std::ostream& DataValue::write(std::ostream& os) const {
-  if (!value_.empty()) {
-    std::copy(value_.begin(), value_.end() - 1, std::ostream_iterator<int>(os, " "));
-    os << static_cast<int>(value_.back());
+  const byte* data = value_.get();
+  if (size_ > 0) {
+    std::copy(data, data + size_ - 1, std::ostream_iterator<int>(os, " "));
+    os << static_cast<int>(data[size_ - 1]);
   }
   return os;
 }
 
+std::string DataValue::toString_() const {
+  if (typeid(*this) != typeid(DataValue))
+    return Value::toString_();
+  ok_ = true;
+  std::string str;
+  for (size_t i = 0; i < size_; ++i) {
+    if (i > 0)
+      str += ' ';
+    appendNumber(str, static_cast<int>(value_.get()[i]));
+  }
+  return str;
+}
+
 std::string DataValue::toString(size_t n) const {
   ok_ = true;
-  return std::to_string(value_.at(n));
+  return std::to_string(at(n));
 }
 
 int64_t DataValue::toInt64(size_t n) const {
   ok_ = true;
-  return value_.at(n);
+  return at(n);
 }
 
 uint32_t DataValue::toUint32(size_t n) const {
   ok_ = true;
-  return value_.at(n);
+  return at(n);
 }
 
 float DataValue::toFloat(size_t n) const {
   ok_ = true;
-  return value_.at(n);
+  return at(n);
 }
 
 Rational DataValue::toRational(size_t n) const {
   ok_ = true;
-  return {value_.at(n), 1};
+  return {at(n), 1};
 }
 
 StringValueBase::StringValueBase(TypeId typeId, const std::string& buf) : Value(typeId) {
@@ -92,6 +92,7 @@ void WebPImage::setComment(const std::string&) {
 /* =========================================== */
 
 void WebPImage::writeMetadata() {
+  enforceCompleteMetadata();
   if (io_->open() != 0) {
     throw Error(ErrorCode::kerDataSourceOpenFailed, io_->path(), strError());
   }
@@ -469,6 +470,7 @@ void WebPImage::readMetadata() {
     throw Error(ErrorCode::kerNotAJpeg);
   }
   clearMetadata();
+  recordReadFilter();
 
   byte data[12];
   DataBuf chunkId(5);
@@ -645,7 +647,7 @@ void WebPImage::decodeChunks(uint32_t filesize) {
 
       if (pos != std::string::npos) {
         XmpData xmpData;
-        ByteOrder bo = ExifParser::decode(exifData_, payload.c_data(pos), payload.size() - pos);
+        ByteOrder bo = ExifParser::decode(exifData_, payload.c_data(pos), payload.size() - pos, readFilter());
         setByteOrder(bo);
       } else {
 #ifndef SUPPRESS_WARNINGS
@@ -656,7 +658,7 @@ void WebPImage::decodeChunks(uint32_t filesize) {
     } else if (equalsWebPTag(chunkId, WEBP_CHUNK_HEADER_XMP)) {
       io_->readOrThrow(payload.data(), payload.size(), Exiv2::ErrorCode::kerCorruptedMetadata);
       xmpPacket_.assign(payload.c_str(), payload.size());
-      if (!xmpPacket_.empty() && XmpParser::decode(xmpData_, xmpPacket_)) {
+      if (!xmpPacket_.empty() && XmpParser::decode(xmpData_, xmpPacket_, readFilter())) {
 #ifndef SUPPRESS_WARNINGS
         EXV_WARNING << "Failed to decode XMP metadata." << '\n';
 #endif
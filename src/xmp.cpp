@@ -615,9 +615,9 @@ void XmpParser::terminate() {
 #ifdef EXV_HAVE_XMP_TOOLKIT
   if (initialized_)
     SXMPMeta::Terminate();
-#else
-  initialized_ = false;
 #endif
+  // Let the next initialize() set up the toolkit again
+  initialized_ = false;
 }
 
 #ifdef EXV_HAVE_XMP_TOOLKIT
@@ -653,11 +653,11 @@ void XmpParser::unregisterNs(const std::string& /*ns*/) {
 }  // XmpParser::unregisterNs
 
 #ifdef EXV_HAVE_XMP_TOOLKIT
-int XmpParser::decode(XmpData& xmpData, const std::string& xmpPacket) {
+int XmpParser::decode(XmpData& xmpData, const std::string& xmpPacket, const ReadFilter& filter) {
   try {
     xmpData.clear();
     xmpData.setPacket(xmpPacket);
-    if (xmpPacket.empty())
+    if (xmpPacket.empty() || !filter.passesGroup("Xmp"))
       return 0;
 
     if (!initialize()) {
@@ -694,6 +694,8 @@ int XmpParser::decode(XmpData& xmpData, const std::string& xmpPacket) {
           prefix.pop_back();
           XmpProperties::registerNs(schemaNs, prefix);
         }
+        if (!filter.empty() && !filter.passesGroup("Xmp." + XmpProperties::prefix(schemaNs)))
+          iter.Skip(kXMP_IterSkipSubtree);
         continue;
       }
       auto key = makeXmpKey(schemaNs, propPath);
@@ -785,7 +787,7 @@ int XmpParser::decode(XmpData& xmpData, const std::string& xmpPacket) {
 #endif  // SUPPRESS_WARNINGS
 }  // XmpParser::decode
 #else
-int XmpParser::decode(XmpData& xmpData, const std::string& xmpPacket) {
+int XmpParser::decode(XmpData& xmpData, const std::string& xmpPacket, const ReadFilter& /*filter*/) {
   xmpData.clear();
   if (!xmpPacket.empty()) {
 #ifndef SUPPRESS_WARNINGS
@@ -811,11 +813,14 @@ int XmpParser::encode(std::string& xmpPacket, const XmpData& xmpData, uint16_t f
       return 2;
     }
     // Register custom namespaces with XMP-SDK
-    for (const auto& [xmp, uri] : XmpProperties::nsRegistry_) {
+    {
+      auto scopedReadLock = std::scoped_lock(XmpProperties::mutex_);
+      for (const auto& [xmp, uri] : XmpProperties::nsRegistry_) {
 #ifdef EXIV2_DEBUG_MESSAGES
-      std::cerr << "Registering " << uri.prefix_ << " : " << xmp << "\n";
+        std::cerr << "Registering " << uri.prefix_ << " : " << xmp << "\n";
 #endif
-      registerNs(xmp, uri.prefix_);
+        registerNs(xmp, uri.prefix_);
+      }
     }
     SXMPMeta meta;
     for (const auto& xmp : xmpData) {
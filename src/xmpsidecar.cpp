@@ -64,6 +64,7 @@ void XmpSidecar::readMetadata() {
     throw Error(ErrorCode::kerFailedToReadImageData);
   clearMetadata();
   xmpPacket_ = std::move(xmpPacket);
+  // The read filter is not applied, as the Exif and IPTC data are converted from the XMP data
   if (!xmpPacket_.empty() && XmpParser::decode(xmpData_, xmpPacket_)) {
 #ifndef SUPPRESS_WARNINGS
     EXV_WARNING << "Failed to decode XMP metadata.\n";
@@ -0,0 +1,37 @@
+# -*- coding: utf-8 -*-
+
+import system_tests
+
+
+class TestJobsOption(metaclass=system_tests.CaseMeta):
+
+    # The output of parallel jobs is written in the order of the files and
+    # the exit code is that of the first file which failed
+    filename_1 = "$data_path/Stonehenge.exv"
+    filename_2 = "$data_path/this-file-does-not-exist.jpg"
+    filename_3 = "$data_path/exiv2-bug480.jpg"
+    commands = [
+        "$exiv2 --jobs 3 -v -K Exif.Image.Model $filename_1 $filename_2 $filename_3",
+        "$exiv2 -j 2 -e a $filename_1 $filename_3",
+    ]
+    stdout = [
+        """File 1/3: $filename_1
+$filename_1  Exif.Image.Model                             Ascii      12  NIKON D5300
+File 2/3: $filename_2
+File 3/3: $filename_3
+""",
+        """Usage: exiv2 [ option [ arg ] ]+ [ action ] file ...
+
+Image metadata manipulation tool.
+""",
+    ]
+    stderr = [
+        """$filename_2: Failed to open the file
+$filename_3: No Exif data found in the file
+$filename_3: No IPTC data found in the file
+$filename_3: No XMP data found in the file
+""",
+        """exiv2: -j option requires -f with extract action
+""",
+    ]
+    retval = [255, 1]
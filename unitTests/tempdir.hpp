@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifndef TEMPDIR_HPP_
+#define TEMPDIR_HPP_
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+/*!
+  @brief Fixture for tests which write files. Each test gets an empty
+         directory of its own, which is removed with its contents when the
+         test ends, also if it fails.
+ */
+class TempDir : public testing::Test {
+ protected:
+  TempDir() {
+    const auto* test = testing::UnitTest::GetInstance()->current_test_info();
+    dir_ = std::filesystem::temp_directory_path() /
+           (std::string("exiv2-") + test->test_suite_name() + "-" + test->name());
+    std::filesystem::remove_all(dir_);
+    std::filesystem::create_directory(dir_);
+  }
+  ~TempDir() override {
+    std::error_code ec;
+    std::filesystem::remove_all(dir_, ec);
+  }
+  TempDir(const TempDir&) = delete;
+  TempDir& operator=(const TempDir&) = delete;
+
+  //! Return the directory
+  [[nodiscard]] const std::filesystem::path& dir() const {
+    return dir_;
+  }
+  //! Return the path of the file \em name in the directory
+  [[nodiscard]] std::string path(const std::string& name) const {
+    return (dir_ / name).string();
+  }
+  //! Copy \em name from the test data to the directory, return the path of the copy
+  [[nodiscard]] std::string copyTestData(const std::string& name) const {
+    const auto copy = path(name);
+    std::filesystem::copy_file(std::filesystem::path(TESTDATA_PATH) / name, copy);
+    return copy;
+  }
+
+ private:
+  std::filesystem::path dir_;  //!< The directory of the test
+};
+
+#endif  // TEMPDIR_HPP_
@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <exiv2/exiv2.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using namespace Exiv2;
+
+namespace {
+//! Return a buffer shared like the buffers which TiffReader lends its values
+std::shared_ptr<const DataBuf> sharedBuf(std::initializer_list<byte> bytes) {
+  return std::make_shared<const DataBuf>(std::data(bytes), bytes.size());
+}
+
+//! Return all the bytes of \em value as a string, which DataValue::toString(n) hides
+std::string str(const Value& value) {
+  return value.toString();
+}
+}  // namespace
+
+namespace {
+//! A value which writes its bytes in hexadecimal
+class HexValue : public DataValue {
+ public:
+  using DataValue::DataValue;
+  std::ostream& write(std::ostream& os) const override {
+    for (size_t i = 0; i < count(); ++i)
+      os << (i > 0 ? " " : "") << std::hex << toInt64(i) << std::dec;
+    return os;
+  }
+};
+
+//! A short value which writes its numbers in brackets
+class BracketedValue : public ValueType<uint16_t> {
+ public:
+  using ValueType<uint16_t>::ValueType;
+  std::ostream& write(std::ostream& os) const override {
+    return ValueType<uint16_t>::write(os << '[') << ']';
+  }
+};
+}  // namespace
+
+TEST(ADataValue, convertsSubclassesToStringsWithTheirWrite) {
+  const byte bytes[] = {1, 171};
+  HexValue hex;
+  ASSERT_EQ(0, hex.read(bytes, sizeof(bytes)));
+  ASSERT_EQ("1 ab", str(hex));
+
+  BracketedValue bracketed(300, unsignedShort);
+  ASSERT_EQ("[300]", str(bracketed));
+}
+
+TEST(ADataValue, readsACopyOfTheBytes) {
+  const byte bytes[] = {1, 2, 255};
+  DataValue value;
+  ASSERT_EQ(0, value.read(bytes, sizeof(bytes)));
+  ASSERT_EQ(3U, value.count());
+  ASSERT_EQ(3U, value.size());
+  ASSERT_EQ("1 2 255", str(value));
+  ASSERT_EQ(255, value.toInt64(2));
+  ASSERT_THROW(value.toInt64(3), std::out_of_range);
+}
+
+TEST(ADataValue, readsTheBytesFromAString) {
+  DataValue value;
+  ASSERT_EQ(0, value.read("0 1 2 3"));
+  ASSERT_EQ("0 1 2 3", str(value));
+  ASSERT_EQ(1, value.read("0 x"));
+  ASSERT_EQ(0, value.read(""));
+  ASSERT_EQ(0U, value.size());
+  ASSERT_EQ("", str(value));
+}
+
+TEST(ADataValue, keepsTheBufferItBorrows) {
+  auto buf = sharedBuf({0, 1, 2, 3, 4, 5});
+  const byte* data = buf->c_data(2);
+  DataValue value;
+  value.borrow(std::shared_ptr<const byte>(buf, data), 3);
+  buf.reset();
+  ASSERT_EQ(3U, value.size());
+  ASSERT_EQ("2 3 4", str(value));
+
+  byte copy[3] = {};
+  ASSERT_EQ(3U, value.copy(copy, invalidByteOrder));
+  ASSERT_TRUE(std::equal(copy, copy + 3, data));
+}
+
+TEST(ADataValue, sharesTheBytesWithItsCopiesUntilItReadsNewOnes) {
+  auto buf = sharedBuf({7, 8, 9});
+  DataValue value;
+  value.borrow(std::shared_ptr<const byte>(buf, buf->c_data()), buf->size());
+  const auto clone = value.clone();
+  ASSERT_EQ("7 8 9", str(*clone));
+
+  const byte bytes[] = {1, 2};
+  ASSERT_EQ(0, value.read(bytes, sizeof(bytes)));
+  ASSERT_EQ("1 2", str(value));
+  ASSERT_EQ("7 8 9", str(*clone));
+  ASSERT_EQ(7, buf->read_uint8(0));
+}
+
+#ifdef EXV_ENABLE_FILESYSTEM
+TEST(ADataValue, decodedFromASharedBufferEqualsADecodedCopy) {
+  auto buf = std::make_shared<const DataBuf>(readFile(TESTDATA_PATH "/IMG_1361.dng"));
+  ExifData copied;
+  ExifData borrowed;
+  IptcData iptcData;
+  XmpData xmpData;
+  TiffParser::decode(copied, iptcData, xmpData, buf->c_data(), buf->size());
+  TiffParser::decode(borrowed, iptcData, xmpData, buf, 0);
+  // The makernote and other large values refer to the buffer
+  ASSERT_LT(1, buf.use_count());
+  buf.reset();
+
+  ASSERT_EQ(copied.count(), borrowed.count());
+  auto it = borrowed.begin();
+  for (auto&& md : copied) {
+    ASSERT_EQ(md.key(), it->key());
+    ASSERT_EQ(md.size(), it->size());
+    std::vector<byte> lhs(md.size());
+    std::vector<byte> rhs(it->size());
+    md.copy(lhs.data(), littleEndian);
+    it->copy(rhs.data(), littleEndian);
+    ASSERT_EQ(lhs, rhs) << md.key();
+    ++it;
+  }
+}
+
+TEST(ADataValue, doesNotBorrowFromLargeBuffers) {
+  // A value would keep all of the buffer alive, like the raw image data
+  auto buf = std::make_shared<const DataBuf>(readFile(TESTDATA_PATH "/ReaganLargeTiff.tiff"));
+  ExifData exifData;
+  IptcData iptcData;
+  XmpData xmpData;
+  TiffParser::decode(exifData, iptcData, xmpData, buf, 0);
+  ASSERT_FALSE(exifData.empty());
+  ASSERT_EQ(1, buf.use_count());
+}
+#endif
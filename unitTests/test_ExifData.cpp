@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <exiv2/exif.hpp>
+
+#include <algorithm>
+
+using namespace Exiv2;
+
+TEST(ExifData, findKeyOnEmptyContainerReturnsEnd) {
+  ExifData exifData;
+  ASSERT_EQ(exifData.end(), exifData.findKey(ExifKey("Exif.Image.Make")));
+}
+
+TEST(ExifData, findKeyReturnsFirstOfDuplicates) {
+  ExifData exifData;
+  exifData["Exif.Image.Model"] = "Model";
+  Exifdatum make(ExifKey("Exif.Image.Make"));
+  make.setValue("first");
+  exifData.add(make);
+  make.setValue("second");
+  exifData.add(make);
+
+  auto pos = exifData.findKey(ExifKey("Exif.Image.Make"));
+  ASSERT_NE(exifData.end(), pos);
+  ASSERT_EQ("first", pos->toString());
+
+  exifData.erase(pos);
+  pos = exifData.findKey(ExifKey("Exif.Image.Make"));
+  ASSERT_NE(exifData.end(), pos);
+  ASSERT_EQ("second", pos->toString());
+
+  exifData.erase(pos);
+  ASSERT_EQ(exifData.end(), exifData.findKey(ExifKey("Exif.Image.Make")));
+  ASSERT_NE(exifData.end(), exifData.findKey(ExifKey("Exif.Image.Model")));
+}
+
+TEST(ExifData, operatorBracketDoesNotAddDuplicates) {
+  ExifData exifData;
+  exifData["Exif.Photo.ExposureTime"] = "1/100";
+  exifData["Exif.Photo.ExposureTime"] = "1/200";
+  ASSERT_EQ(1u, exifData.count());
+  ASSERT_EQ("1/200", exifData.findKey(ExifKey("Exif.Photo.ExposureTime"))->toString());
+}
+
+TEST(ExifData, findKeyDistinguishesGroups) {
+  ExifData exifData;
+  exifData["Exif.Image.ImageWidth"] = uint32_t(100);
+  exifData["Exif.Thumbnail.ImageWidth"] = uint32_t(10);
+  ASSERT_EQ(2u, exifData.count());
+  ASSERT_EQ(100, exifData.findKey(ExifKey("Exif.Image.ImageWidth"))->toInt64());
+  ASSERT_EQ(10, exifData.findKey(ExifKey("Exif.Thumbnail.ImageWidth"))->toInt64());
+}
+
+TEST(ExifData, findKeyAfterSortReturnsFirstInNewOrder) {
+  ExifData exifData;
+  exifData["Exif.Image.Model"] = "Model";
+  exifData["Exif.Image.Make"] = "Make";
+  Exifdatum model(ExifKey("Exif.Image.Model"));
+  model.setValue("Another model");
+  exifData.add(model);
+
+  exifData.sortByKey();
+  ASSERT_EQ("Exif.Image.Make", exifData.begin()->key());
+  ASSERT_EQ("Model", exifData.findKey(ExifKey("Exif.Image.Model"))->toString());
+  ASSERT_EQ("Make", exifData.findKey(ExifKey("Exif.Image.Make"))->toString());
+}
+
+TEST(ExifData, findKeyAfterRemoveIfErase) {
+  ExifData exifData;
+  exifData["Exif.Image.Make"] = "Make";
+  exifData["Exif.Thumbnail.Compression"] = uint16_t(6);
+  exifData["Exif.Image.Model"] = "Model";
+  exifData["Exif.Photo.ExposureTime"] = "1/100";
+
+  exifData.erase(std::remove_if(exifData.begin(), exifData.end(),
+                                [](const Exifdatum& md) { return md.ifdId() == IfdId::ifd1Id; }),
+                 exifData.end());
+  ASSERT_EQ(3u, exifData.count());
+  ASSERT_EQ(exifData.end(), exifData.findKey(ExifKey("Exif.Thumbnail.Compression")));
+  ASSERT_EQ("Make", exifData.findKey(ExifKey("Exif.Image.Make"))->toString());
+  ASSERT_EQ("Model", exifData.findKey(ExifKey("Exif.Image.Model"))->toString());
+  ASSERT_EQ("1/100", exifData.findKey(ExifKey("Exif.Photo.ExposureTime"))->toString());
+}
+
+TEST(ExifData, findKeyRepairsEntryOverwrittenThroughIterator) {
+  ExifData exifData;
+  exifData["Exif.Image.Make"] = "Make";
+  exifData["Exif.Image.Model"] = "Model";
+
+  Exifdatum artist(ExifKey("Exif.Image.Artist"));
+  artist.setValue("Artist");
+  *exifData.begin() = artist;
+
+  ASSERT_EQ(exifData.end(), exifData.findKey(ExifKey("Exif.Image.Make")));
+  ASSERT_EQ("Artist", exifData.findKey(ExifKey("Exif.Image.Artist"))->toString());
+  ASSERT_EQ("Model", exifData.findKey(ExifKey("Exif.Image.Model"))->toString());
+}
+
+TEST(ExifData, findKeyFindsTheNewKeyOfAnEntryOverwrittenThroughIterator) {
+  ExifData exifData;
+  exifData["Exif.Image.Make"] = "Make";
+  exifData["Exif.Image.Model"] = "Model";
+
+  Exifdatum artist(ExifKey("Exif.Image.Artist"));
+  artist.setValue("Artist");
+  *exifData.begin() = artist;
+
+  // Look up the new key before anything else, the const version first
+  const ExifData& constData = exifData;
+  ASSERT_EQ("Artist", constData.findKey(ExifKey("Exif.Image.Artist"))->toString());
+  ASSERT_EQ(constData.end(), constData.findKey(ExifKey("Exif.Image.Make")));
+  ASSERT_EQ("Artist", exifData.findKey(ExifKey("Exif.Image.Artist"))->toString());
+  ASSERT_EQ(exifData.end(), exifData.findKey(ExifKey("Exif.Image.Make")));
+  ASSERT_EQ("Model", exifData.findKey(ExifKey("Exif.Image.Model"))->toString());
+  exifData.erase(exifData.findKey(ExifKey("Exif.Image.Artist")));
+  ASSERT_EQ(exifData.end(), exifData.findKey(ExifKey("Exif.Image.Artist")));
+  ASSERT_EQ(1U, exifData.count());
+}
+
+TEST(ExifData, findKeyNoticesKeyChangesInTheContainerItWasMovedTo) {
+  ExifData original;
+  original["Exif.Image.Make"] = "Make";
+  original["Exif.Image.Model"] = "Model";
+  ExifData moved(std::move(original));
+  ExifData assigned;
+  assigned = std::move(moved);
+
+  Exifdatum artist(ExifKey("Exif.Image.Artist"));
+  artist.setValue("Artist");
+  *assigned.begin() = artist;
+  const ExifData& constData = assigned;
+  ASSERT_EQ(constData.end(), constData.findKey(ExifKey("Exif.Image.Make")));
+  ASSERT_EQ("Artist", constData.findKey(ExifKey("Exif.Image.Artist"))->toString());
+
+  // An entry copied out of the container doesn't refer to it
+  Exifdatum copy = *assigned.findKey(ExifKey("Exif.Image.Model"));
+  copy = artist;
+  ASSERT_EQ("Model", assigned.findKey(ExifKey("Exif.Image.Model"))->toString());
+}
+
+TEST(ExifData, copyHasIndependentIndex) {
+  ExifData exifData;
+  exifData["Exif.Image.Make"] = "Make";
+  ExifData copy(exifData);
+  exifData.clear();
+
+  ASSERT_EQ(exifData.end(), exifData.findKey(ExifKey("Exif.Image.Make")));
+  auto pos = copy.findKey(ExifKey("Exif.Image.Make"));
+  ASSERT_NE(copy.end(), pos);
+  ASSERT_EQ("Make", pos->toString());
+
+  ExifData assigned;
+  assigned = copy;
+  copy.erase(copy.begin());
+  ASSERT_EQ("Make", assigned.findKey(ExifKey("Exif.Image.Make"))->toString());
+
+  ExifData moved(std::move(assigned));
+  ASSERT_EQ("Make", moved.findKey(ExifKey("Exif.Image.Make"))->toString());
+}
@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <exiv2/error.hpp>
+#include <exiv2/exif.hpp>
+#include <exiv2/tags.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using namespace Exiv2;
+
+TEST(ExifKey, creationWithNonValidStringFormatThrows) {
+  for (auto key : {"Yeah", "Exif.Image", "Exif..Make", "Exif.Image.", "Iptc.Image.Make", "Exif.NoSuchGroup.Make"}) {
+    try {
+      ExifKey k(key);
+      FAIL() << key;
+    } catch (const Exiv2::Error& e) {
+      ASSERT_EQ(ErrorCode::kerInvalidKey, e.code());
+    }
+  }
+}
+
+TEST(ExifKey, createsKeyFromString) {
+  ExifKey key("Exif.Photo.ExposureTime");
+  ASSERT_EQ("Exif.Photo.ExposureTime", key.key());
+  ASSERT_STREQ("Exif", key.familyName());
+  ASSERT_EQ("Photo", key.groupName());
+  ASSERT_EQ("ExposureTime", key.tagName());
+  ASSERT_EQ(0x829a, key.tag());
+  ASSERT_EQ(IfdId::exifId, key.ifdId());
+  ASSERT_EQ(unsignedRational, key.defaultTypeId());
+}
+
+TEST(ExifKey, translatesHexTagNamesOfKnownTags) {
+  ExifKey key("Exif.Image.0x010f");
+  ASSERT_EQ("Exif.Image.Make", key.key());
+  ASSERT_EQ(0x010f, key.tag());
+}
+
+TEST(ExifKey, keepsHexTagNamesOfUnknownTags) {
+  ExifKey key("Exif.Image.0xfffe");
+  ASSERT_EQ("Exif.Image.0xfffe", key.key());
+  ASSERT_EQ("0xfffe", key.tagName());
+  ASSERT_EQ("", key.tagLabel());
+  ASSERT_EQ(ExifKey(0xfffe, "Image").key(), key.key());
+}
+
+TEST(ExifKey, createsKeyFromTagAndGroup) {
+  ExifKey key(0x9003, "Photo");
+  ASSERT_EQ("Exif.Photo.DateTimeOriginal", key.key());
+  ASSERT_THROW(ExifKey(0x9003, "NoSuchGroup"), Exiv2::Error);
+}
+
+TEST(ExifKey, copiesAreIndependent) {
+  ExifKey key("Exif.Canon.ModelID");
+  key.setIdx(7);
+  ExifKey copy(key);
+  ASSERT_EQ(key.key(), copy.key());
+  ASSERT_EQ(7, copy.idx());
+  copy = ExifKey("Exif.Image.Make");
+  copy.setIdx(1);
+  ASSERT_EQ("Exif.Canon.ModelID", key.key());
+  ASSERT_EQ(7, key.idx());
+  ASSERT_EQ("Exif.Image.Make", copy.clone()->key());
+}
+
+TEST(ExifKey, sortByKeyOrdersLikeTheKeyStrings) {
+  ExifData exifData;
+  for (auto key : {"Exif.Photo.ExposureTime", "Exif.Image.Model", "Exif.Image2.ImageWidth", "Exif.Image.0xfffe",
+                   "Exif.Image.Make", "Exif.Canon.ModelID", "Exif.Image.0x0001", "Exif.Photo.FNumber"}) {
+    exifData.add(ExifKey(key), nullptr);
+  }
+  exifData.sortByKey();
+  std::vector<std::string> keys;
+  for (auto&& md : exifData)
+    keys.push_back(md.key());
+  ASSERT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+  ASSERT_EQ(8u, keys.size());
+}
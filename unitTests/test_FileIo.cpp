@@ -2,7 +2,11 @@
 
 #include <gtest/gtest.h>
 #include "basicio.hpp"
+
+#include <filesystem>
+
 using namespace Exiv2;
+namespace fs = std::filesystem;
 
 namespace {
 constexpr auto imagePath = TESTDATA_PATH "/DSC_3079.jpg";
@@ -77,3 +81,28 @@ TEST(AFileIO, canSeekBeyondEOF) {
   ASSERT_FALSE(file.error());
   ASSERT_FALSE(file.eof());
 }
+
+TEST(AFileIO, writesTheRestOfAnotherFileIo) {
+  FileIo src(imagePath);
+  ASSERT_EQ(0, src.open());
+  ASSERT_EQ(0, src.seek(1000, BasicIo::beg));
+
+  const std::string copyPath = "test_FileIo_copy.jpg";
+  {
+    FileIo dst(copyPath);
+    ASSERT_EQ(0, dst.open("w+b"));
+    ASSERT_EQ(3u, dst.write(reinterpret_cast<const byte*>("abc"), 3));
+    ASSERT_EQ(118685UL - 1000, dst.write(src));
+    ASSERT_EQ(118685UL - 1000 + 3, dst.tell());
+    ASSERT_EQ(118685UL, src.tell());
+
+    // Compare the copy with the original
+    ASSERT_EQ(0, dst.seek(3, BasicIo::beg));
+    ASSERT_EQ(0, src.seek(1000, BasicIo::beg));
+    DataBuf expected = src.read(src.size() - 1000);
+    DataBuf copied = dst.read(dst.size() - 3);
+    ASSERT_EQ(expected.size(), copied.size());
+    ASSERT_EQ(0, expected.cmpBytes(0, copied.c_data(), copied.size()));
+  }
+  fs::remove(copyPath);
+}
@@ -143,6 +143,17 @@ TEST(TheImageFactory, loadInstancesDifferentImageTypes) {
   EXPECT_NO_THROW(ImageFactory::open(imagePath, false));
 }
 
+TEST(TheImageFactory, getTypeFromMemory) {
+  const byte jpeg[] = {0xff, 0xd8, 0xff, 0xe0, 0x00, 0x10};
+  EXPECT_EQ(ImageType::jpeg, ImageFactory::getType(jpeg, sizeof(jpeg)));
+
+  const std::string xmp = "\xef\xbb\xbf<?xpacket begin=\"\" id=\"W5M0MpCehiHzreSzNTczkc9d\"?>\n" + std::string(80, ' ');
+  EXPECT_EQ(ImageType::xmp, ImageFactory::getType(reinterpret_cast<const byte*>(xmp.data()), xmp.size()));
+
+  const std::string garbage(128, 'x');
+  EXPECT_EQ(ImageType::none, ImageFactory::getType(reinterpret_cast<const byte*>(garbage.data()), garbage.size()));
+}
+
 TEST(TheImageFactory, getsExpectedModesForJp2Images) {
   EXPECT_EQ(amNone, ImageFactory::checkMode(ImageType::jp2, mdNone));
   EXPECT_EQ(amReadWrite, ImageFactory::checkMode(ImageType::jp2, mdExif));
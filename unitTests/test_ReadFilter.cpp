@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <exiv2/exiv2.hpp>
+
+#include "tempdir.hpp"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace Exiv2;
+
+TEST(ReadFilter, passesKeysAndTheirGroups) {
+  ReadFilter filter;
+  ASSERT_TRUE(filter.passes("Exif.Image.Make"));
+  filter.addKey("Exif.Photo.ExposureTime");
+  filter.addGroup("Iptc.Application2");
+  filter.addGroup("Xmp");
+  ASSERT_TRUE(filter.passes("Exif.Photo.ExposureTime"));
+  ASSERT_FALSE(filter.passes("Exif.Photo.FNumber"));
+  ASSERT_TRUE(filter.passes("Iptc.Application2.Caption"));
+  ASSERT_FALSE(filter.passes("Iptc.Envelope.CharacterSet"));
+  ASSERT_TRUE(filter.passes("Xmp.dc.title"));
+
+  ASSERT_TRUE(filter.passesGroup("Exif"));
+  ASSERT_TRUE(filter.passesGroup("Exif.Photo"));
+  ASSERT_FALSE(filter.passesGroup("Exif.Nikon3"));
+  ASSERT_FALSE(filter.passesGroup("Exif.Pho"));
+  ASSERT_TRUE(filter.passesGroup("Iptc"));
+  ASSERT_FALSE(filter.passesGroup("Iptc.Envelope"));
+  ASSERT_TRUE(filter.passesGroup("Xmp.dc"));
+}
+
+#ifdef EXV_ENABLE_FILESYSTEM
+TEST(ReadFilter, decodesOnlyTheRequestedGroups) {
+  auto image = ImageFactory::open(TESTDATA_PATH "/exiv2-bug1062.jpg");
+  ReadFilter filter;
+  filter.addKey("Exif.Photo.ExposureTime");
+  filter.addKey("Iptc.Application2.Caption");
+  filter.addKey("Xmp.dc.description");
+  image->setReadFilter(filter);
+  image->readMetadata();
+
+  ASSERT_EQ("1/100 s", image->exifData()["Exif.Photo.ExposureTime"].print(&image->exifData()));
+  ASSERT_EQ(image->exifData().end(), image->exifData().findKey(ExifKey("Exif.Nikon3.Version")));
+  ASSERT_EQ("Mrs Johnson's Austin Office", image->iptcData()["Iptc.Application2.Caption"].toString());
+  ASSERT_EQ(image->iptcData().end(), image->iptcData().findKey(IptcKey("Iptc.Envelope.ModelVersion")));
+  ASSERT_EQ(1U, image->xmpData().count());
+  ASSERT_EQ("lang=\"x-default\" Mrs Johnson's Austin Office", image->xmpData()["Xmp.dc.description"].toString());
+
+  // A makernote group decodes the whole makernote
+  filter = {};
+  filter.addGroup("Exif.NikonLd3");
+  image->setReadFilter(filter);
+  image->readMetadata();
+  ASSERT_NE(image->exifData().end(), image->exifData().findKey(ExifKey("Exif.Nikon3.Version")));
+  ASSERT_TRUE(image->iptcData().empty());
+  ASSERT_TRUE(image->xmpData().empty());
+}
+
+TEST(ReadFilter, defersDecodingTheMakernote) {
+  auto eager = ImageFactory::open(TESTDATA_PATH "/exiv2-bug1062.jpg");
+  eager->readMetadata();
+  auto keys = [](const ExifData& exifData) {
+    std::vector<std::string> keys;
+    for (const auto& md : exifData)
+      keys.push_back(md.key() + "=" + md.toString());
+    return keys;
+  };
+
+  auto image = ImageFactory::open(TESTDATA_PATH "/exiv2-bug1062.jpg");
+  ReadFilter filter;
+  filter.setDeferMakernote(true);
+  image->setReadFilter(filter);
+  image->readMetadata();
+  const auto copy = image->exifData();
+  ASSERT_EQ("1/100 s", image->exifData()["Exif.Photo.ExposureTime"].print(&image->exifData()));
+  ASSERT_NE(image->exifData().end(), image->exifData().findKey(ExifKey("Exif.Nikon3.Version")));
+  ASSERT_EQ(keys(eager->exifData()), keys(image->exifData()));
+  ASSERT_EQ(eager->exifData().count(), copy.count());
+  ASSERT_EQ(keys(eager->exifData()), keys(copy));
+
+  // Erasing a datum before the makernote is decoded keeps the order
+  image->readMetadata();
+  auto& exifData = image->exifData();
+  exifData.erase(exifData.findKey(ExifKey("Exif.Photo.ExposureTime")));
+  eager->exifData().erase(eager->exifData().findKey(ExifKey("Exif.Photo.ExposureTime")));
+  ASSERT_EQ(keys(eager->exifData()), keys(exifData));
+}
+
+TEST(ReadFilter, countsAMakernoteWhichIsNotDecodedYetAsMetadata) {
+  auto image = ImageFactory::open(TESTDATA_PATH "/exiv2-bug1062.jpg");
+  ReadFilter filter;
+  filter.addKey("Exif.Photo.MakerNote");
+  filter.addGroup("Exif.Nikon3");
+  filter.setDeferMakernote(true);
+  image->setReadFilter(filter);
+  image->readMetadata();
+  auto& exifData = image->exifData();
+  ASSERT_FALSE(exifData.empty());
+  // Erasing the makernote tag decodes the makernote first
+  exifData.erase(exifData.findKey(ExifKey("Exif.Photo.MakerNote")));
+  ASSERT_FALSE(exifData.empty());
+  ASSERT_NE(exifData.end(), exifData.findKey(ExifKey("Exif.Nikon3.Version")));
+}
+
+class AFilteredImage : public TempDir {};
+
+TEST_F(AFilteredImage, isNotWrittenBack) {
+  for (auto name : {"exiv2-bug1062.jpg", "mini9.tif"}) {
+    const auto path = copyTestData(name);
+    const auto size = fs::file_size(path);
+    auto image = ImageFactory::open(path);
+    ReadFilter filter;
+    filter.addKey("Exif.Image.Model");
+    image->setReadFilter(filter);
+    image->readMetadata();
+    ASSERT_TRUE(image->partialMetadata());
+    image->exifData()["Exif.Image.Artist"] = "Exiv2";
+    try {
+      image->writeMetadata();
+      FAIL() << name << ": metadata read with a filter was written";
+    } catch (const Error& e) {
+      ASSERT_EQ(ErrorCode::kerPartialMetadata, e.code()) << name;
+    }
+    ASSERT_EQ(size, fs::file_size(path)) << name;
+
+    // Without a filter, or with one which only defers the makernote, the metadata is complete
+    filter = {};
+    filter.setDeferMakernote(true);
+    image->setReadFilter(filter);
+    image->readMetadata();
+    ASSERT_FALSE(image->partialMetadata());
+    image->exifData()["Exif.Image.Artist"] = "Exiv2";
+    image->writeMetadata();
+    image->setReadFilter({});
+    image->readMetadata();
+    ASSERT_EQ("Exiv2", image->exifData()["Exif.Image.Artist"].toString()) << name;
+  }
+}
+#endif
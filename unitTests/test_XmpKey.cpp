@@ -1,8 +1,14 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <gtest/gtest.h>
+#include <exiv2/error.hpp>
 #include <exiv2/properties.hpp>
 
+#include <atomic>
+#include <thread>
+#include <tuple>
+#include <vector>
+
 using namespace Exiv2;
 
 namespace {
@@ -11,6 +17,17 @@ const std::string expectedPrefix("prefix");
 const std::string expectedProperty("prop");
 const std::string expectedKey(expectedFamily + "." + expectedPrefix + "." + expectedProperty);
 const std::string notRegisteredValidKey("Xmp.noregistered.prop");
+
+//! Register the n-th example namespace with the prefix "v<n>"
+void registerExampleNs(int n) {
+  const auto number = std::to_string(n);
+  std::string ns = "http://ns.example.com/v";
+  ns += number;
+  ns += '/';
+  std::string prefix = "v";
+  prefix += number;
+  XmpProperties::registerNs(ns, prefix);
+}
 }  // namespace
 
 // Test Fixture which register a namespace with a prefix. This is needed to test the correct
@@ -76,3 +93,103 @@ TEST_F(AXmpKey, throwsWithNotRegisteredPrefix) {
 TEST_F(AXmpKey, throwsWithBadFormedKey) {
   ASSERT_THROW(XmpKey key(expectedProperty), std::exception);  // It should have the format ns.prefix.key
 }
+
+TEST(XmpProperties, reRegisteringPrefixUpdatesNamespace) {
+  XmpProperties::registerNs("http://ns.example.com/first/", "exv");
+  const XmpNsInfo* first = XmpProperties::lookupNsRegistry(XmpNsInfo::Prefix{"exv"});
+  ASSERT_NE(nullptr, first);
+  ASSERT_STREQ("http://ns.example.com/first/", first->ns_);
+  // Entries stay valid while their namespace is registered
+  XmpProperties::registerNs("http://ns.example.com/other/", "other");
+  ASSERT_EQ(first, XmpProperties::lookupNsRegistry(XmpNsInfo::Prefix{"exv"}));
+  ASSERT_STREQ("http://ns.example.com/first/", first->ns_);
+
+  XmpProperties::registerNs("http://ns.example.com/second", "exv");
+  ASSERT_EQ("http://ns.example.com/second/", XmpProperties::ns("exv"));
+  ASSERT_EQ("exv", XmpProperties::prefix("http://ns.example.com/second"));
+  ASSERT_EQ("", XmpProperties::prefix("http://ns.example.com/first/"));
+
+  XmpProperties::unregisterNs("http://ns.example.com/second/");
+  ASSERT_EQ(nullptr, XmpProperties::lookupNsRegistry(XmpNsInfo::Prefix{"exv"}));
+  ASSERT_THROW(XmpProperties::ns("exv"), Error);
+  ASSERT_EQ("dc", XmpProperties::prefix("http://purl.org/dc/elements/1.1/"));
+  XmpProperties::unregisterNs();
+}
+
+TEST(XmpProperties, lookupsRunConcurrentlyWithRegistration) {
+  XmpProperties::registerNs("http://ns.example.com/stable/", "stable");
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([] {
+      for (int i = 0; i < 2000; ++i) {
+        ASSERT_EQ("http://ns.example.com/stable/", XmpProperties::ns("stable"));
+        ASSERT_EQ("dc", XmpProperties::prefix("http://purl.org/dc/elements/1.1/"));
+        XmpKey key("Xmp.stable.prop");
+        ASSERT_EQ("stable", key.groupName());
+      }
+    });
+  }
+  for (int i = 0; i < 200; ++i)
+    registerExampleNs(i);
+  for (auto& reader : readers)
+    reader.join();
+  ASSERT_EQ("http://ns.example.com/v199/", XmpProperties::ns("v199"));
+  XmpProperties::unregisterNs();
+}
+
+TEST(XmpProperties, lookupsRunConcurrentlyWithUnregistration) {
+  std::atomic<bool> done{false};
+  std::atomic<int> started{0};
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([&done, &started] {
+      ++started;
+      while (!done) {
+        // The entry stays valid until the next lookup in this thread
+        if (auto xn = XmpProperties::lookupNsRegistry(XmpNsInfo::Prefix{"v1"})) {
+          ASSERT_STREQ("http://ns.example.com/v1/", xn->ns_);
+        }
+        ASSERT_EQ("dc", XmpProperties::prefix("http://purl.org/dc/elements/1.1/"));
+        std::ignore = XmpProperties::prefix("http://ns.example.com/v2/");
+      }
+    });
+  }
+  while (started < 4)
+    std::this_thread::yield();
+  for (int i = 0; i < 200; ++i) {
+    for (int n = 0; n < 4; ++n)
+      registerExampleNs(n);
+    XmpProperties::unregisterNs();
+  }
+  done = true;
+  for (auto& reader : readers)
+    reader.join();
+  ASSERT_EQ(nullptr, XmpProperties::lookupNsRegistry(XmpNsInfo::Prefix{"v1"}));
+}
+
+TEST(XmpProperties, propertyInfoOfKeys) {
+  auto title = XmpProperties::propertyInfo(XmpKey("Xmp.dc.title"));
+  ASSERT_NE(nullptr, title);
+  ASSERT_STREQ("title", title->name_);
+  ASSERT_EQ(langAlt, title->typeId_);
+  // Both prefixes of the IPTC Core schema share its property list
+  ASSERT_EQ(XmpProperties::propertyInfo(XmpKey("Xmp.iptc.Location")),
+            XmpProperties::propertyInfo(XmpKey("Xmp.Iptc4xmpCore.Location")));
+  ASSERT_EQ(nullptr, XmpProperties::propertyInfo(XmpKey("Xmp.dc.noSuchProperty")));
+  ASSERT_EQ(nullptr, XmpProperties::propertyInfo(XmpKey("xmpG", "A")));
+}
+
+TEST(XmpProperties, propertyInfoOfNestedKeys) {
+  auto regions = XmpProperties::propertyInfo(XmpKey("Xmp.MP.RegionInfo/MPRI:Regions"));
+  ASSERT_NE(nullptr, regions);
+  ASSERT_STREQ("Regions", regions->name_);
+  ASSERT_EQ(regions, XmpProperties::propertyInfo(XmpKey("Xmp.MP.RegionInfo/MPRI:Regions")));
+  auto rectangle = XmpProperties::propertyInfo(XmpKey("Xmp.MP.RegionInfo/MPRI:Regions[1]/MPReg:Rectangle"));
+  ASSERT_NE(nullptr, rectangle);
+  ASSERT_STREQ("Rectangle", rectangle->name_);
+  // Without a prefix, the innermost element is in the namespace of the key
+  auto creator = XmpProperties::propertyInfo(XmpKey("Xmp.dc.creator[1]/creator"));
+  ASSERT_NE(nullptr, creator);
+  ASSERT_STREQ("creator", creator->name_);
+  ASSERT_THROW(XmpProperties::propertyInfo(XmpKey("Xmp.MP.RegionInfo/unknown:Regions")), Error);
+}
@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <exiv2/batchreader.hpp>
+#include <exiv2/properties.hpp>
+#include <exiv2/xmp_exiv2.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace Exiv2;
+
+namespace {
+const std::string imagePath = TESTDATA_PATH "/DSC_3079.jpg";
+const std::string nonExistingImagePath = TESTDATA_PATH "/nonExisting.jpg";
+}  // namespace
+
+TEST(readMetadataBatch, returnsOneResultPerFile) {
+  std::vector<std::string> paths;
+  for (int i = 0; i < 16; ++i)
+    paths.push_back(i % 4 == 3 ? nonExistingImagePath : imagePath);
+
+  std::vector<int> seen(paths.size());
+  size_t errors = 0;
+  const size_t good = readMetadataBatch(paths, 4, mdExif, [&](BatchResult& result) {
+    ASSERT_LT(result.index_, paths.size());
+    ASSERT_EQ(paths[result.index_], result.path_);
+    ++seen[result.index_];
+    if (result.path_ == imagePath) {
+      ASSERT_TRUE(result.error_.empty());
+      ASSERT_EQ(ImageType::jpeg, result.imageType_);
+      ASSERT_FALSE(result.exifData_.empty());
+      ASSERT_NE(result.exifData_.end(), result.exifData_.findKey(ExifKey("Exif.Image.Make")));
+      ASSERT_TRUE(result.xmpData_.empty());
+    } else {
+      ASSERT_FALSE(result.error_.empty());
+      ++errors;
+    }
+  });
+  ASSERT_EQ(12u, good);
+  ASSERT_EQ(4u, errors);
+  for (int n : seen)
+    ASSERT_EQ(1, n);
+}
+
+TEST(readMetadataBatch, returnsOnlyRequestedFamilies) {
+  const size_t good = readMetadataBatch({imagePath}, 0, mdXmp | mdIptc, [](BatchResult& result) {
+    ASSERT_TRUE(result.error_.empty());
+    ASSERT_TRUE(result.exifData_.empty());
+    ASSERT_NE(result.iptcData_.end(), result.iptcData_.findKey(IptcKey("Iptc.Envelope.CharacterSet")));
+    ASSERT_NE(result.xmpData_.end(), result.xmpData_.findKey(XmpKey("Xmp.dc.subject")));
+  });
+  ASSERT_EQ(1u, good);
+  ASSERT_EQ(0u, readMetadataBatch({}, 2, mdExif, [](BatchResult&) { FAIL(); }));
+}
+
+TEST(readMetadataBatch, stopsAndRethrowsWhenTheCallbackThrows) {
+  std::vector<std::string> paths(64, imagePath);
+  size_t calls = 0;
+  ASSERT_THROW(readMetadataBatch(paths, 4, mdExif,
+                                 [&](BatchResult&) {
+                                   if (++calls == 3)
+                                     throw std::runtime_error("stop");
+                                 }),
+               std::runtime_error);
+  ASSERT_EQ(3u, calls);
+}
+
+TEST(readMetadataBatch, initializesTheXmpParserForEachBatch) {
+  std::vector<std::string> paths(8, imagePath);
+  for (int batch = 0; batch < 2; ++batch) {
+    size_t withXmp = 0;
+    ASSERT_EQ(paths.size(), readMetadataBatch(paths, 4, mdXmp, [&](BatchResult& result) {
+                ASSERT_TRUE(result.error_.empty()) << result.error_;
+                if (!result.xmpData_.empty())
+                  ++withXmp;
+              }));
+    ASSERT_EQ(paths.size(), withXmp);
+    // The next batch must not rely on the first one to initialize the parser
+    XmpParser::terminate();
+  }
+}
@@ -8,6 +8,7 @@
 
 // Auxiliary headers
 #include <cerrno>
+#include <chrono>
 #include <cstdio>
 #include <filesystem>
 #include <fstream>
@@ -122,6 +123,65 @@ TEST(AUri, parsesAndDecoreUrl) {
   Uri::Decode(uri);
 }
 
+#if defined(EXV_ENABLE_INIH) && defined(EXV_ENABLE_FILESYSTEM)
+namespace {
+//! Return the label of Canon lens type 65000, which only the configuration file defines
+std::string canonLens() {
+  ExifData exifData;
+  exifData["Exif.CanonCs.LensType"] = uint16_t{65000};
+  return exifData["Exif.CanonCs.LensType"].print(&exifData);
+}
+
+//! Write a configuration file to the current directory, where it is looked for first
+void writeConfig(const std::string& label) {
+  std::ofstream(".exiv2") << "[canon]\n65000=" << label << "\n";
+}
+}  // namespace
+
+TEST(preloadConfig, parsesTheConfigurationFileOnlyOnce) {
+  writeConfig("Cached lens");
+  const auto mtime = fs::last_write_time(".exiv2");
+  invalidateConfig();
+  ASSERT_TRUE(preloadConfig());
+  ASSERT_EQ("Cached lens", canonLens());
+  // The file is not parsed again as long as its modification time stays the same
+  writeConfig("Other lens");
+  fs::last_write_time(".exiv2", mtime);
+  ASSERT_TRUE(preloadConfig());
+  ASSERT_EQ("Cached lens", canonLens());
+  fs::remove(".exiv2");
+  invalidateConfig();
+}
+
+TEST(preloadConfig, reloadsTheConfigurationFileWhenItIsModified) {
+  writeConfig("Old lens");
+  invalidateConfig();
+  ASSERT_TRUE(preloadConfig());
+  ASSERT_EQ("Old lens", canonLens());
+  const auto mtime = fs::last_write_time(".exiv2");
+  writeConfig("New lens");
+  fs::last_write_time(".exiv2", mtime + std::chrono::seconds(2));
+  ASSERT_TRUE(preloadConfig());
+  ASSERT_EQ("New lens", canonLens());
+  fs::remove(".exiv2");
+  preloadConfig();
+  ASSERT_NE("New lens", canonLens());
+}
+
+TEST(invalidateConfig, makesTheNextLookupParseTheConfigurationFile) {
+  writeConfig("Cached lens");
+  const auto mtime = fs::last_write_time(".exiv2");
+  invalidateConfig();
+  ASSERT_TRUE(preloadConfig());
+  writeConfig("Other lens");
+  fs::last_write_time(".exiv2", mtime);
+  invalidateConfig();
+  ASSERT_EQ("Other lens", canonLens());
+  fs::remove(".exiv2");
+  invalidateConfig();
+}
+#endif
+
 #if 0
 //1122 This has been removed for v0.27.3
 //     On MinGW:
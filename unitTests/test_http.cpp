@@ -0,0 +1,284 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <exiv2/exiv2.hpp>
+#include <exiv2/http.hpp>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+/*!
+  @brief A local stand-in for an HTTP/1.1 server, which serves one file with
+         support for HEAD, range requests and keep-alive, and counts the
+         connections and requests it gets. With an idle timeout, it resets
+         connections which are idle for longer.
+ */
+class StandInServer {
+ public:
+  explicit StandInServer(std::string content, bool keepAlive = true,
+                         std::chrono::milliseconds idleTimeout = std::chrono::milliseconds::zero()) :
+      content_(std::move(content)), keepAlive_(keepAlive), idleTimeout_(idleTimeout) {
+    listenFd_ = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (bind(listenFd_, reinterpret_cast<sockaddr*>(&address), length) != 0 || listen(listenFd_, 16) != 0 ||
+        getsockname(listenFd_, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+      throw std::runtime_error("Failed to start the stand-in HTTP server");
+    }
+    port_ = ntohs(address.sin_port);
+    acceptor_ = std::thread([this] { acceptConnections(); });
+  }
+
+  ~StandInServer() {
+    shutdown(listenFd_, SHUT_RDWR);
+    close(listenFd_);
+    acceptor_.join();
+    {
+      std::lock_guard lock(mutex_);
+      for (int fd : clientFds_)
+        shutdown(fd, SHUT_RDWR);
+    }
+    for (auto& t : clients_)
+      t.join();
+    for (int fd : clientFds_)
+      close(fd);
+  }
+
+  StandInServer(const StandInServer&) = delete;
+  StandInServer& operator=(const StandInServer&) = delete;
+
+  [[nodiscard]] std::string url(const std::string& page) const {
+    return "http://127.0.0.1:" + std::to_string(port_) + page;
+  }
+  [[nodiscard]] size_t connections() const {
+    return connections_;
+  }
+  [[nodiscard]] size_t requests() const {
+    return requests_;
+  }
+
+ private:
+  void acceptConnections() {
+    for (int fd = accept(listenFd_, nullptr, nullptr); fd >= 0; fd = accept(listenFd_, nullptr, nullptr)) {
+      ++connections_;
+      std::lock_guard lock(mutex_);
+      clientFds_.push_back(fd);
+      clients_.emplace_back([this, fd] { serve(fd); });
+    }
+  }
+
+  void serve(int fd) {
+    if (idleTimeout_ > std::chrono::milliseconds::zero()) {
+      const auto ms = idleTimeout_.count();
+      timeval timeout = {static_cast<time_t>(ms / 1000), static_cast<suseconds_t>((ms % 1000) * 1000)};
+      setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    }
+    std::string in;
+    char buffer[4096];
+    bool open = true;
+    while (open) {
+      auto end = in.find("\r\n\r\n");
+      while (end == std::string::npos) {
+        auto n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) && in.empty()) {
+          reset(fd);
+          return;
+        }
+        if (n <= 0)
+          return;
+        in.append(buffer, n);
+        end = in.find("\r\n\r\n");
+      }
+      const std::string request = in.substr(0, end);
+      in.erase(0, end + 4);
+      ++requests_;
+
+      std::string status = "200 OK";
+      std::string body = content_;
+      std::string headers;
+      if (auto range = request.find("Range: bytes="); range != std::string::npos) {
+        size_t first = std::stoul(request.substr(range + 13));
+        size_t last = std::stoul(request.substr(request.find('-', range + 13) + 1));
+        last = std::min(last, content_.size() - 1);
+        status = "206 Partial Content";
+        body = content_.substr(first, last - first + 1);
+        headers += "Content-Range: bytes " + std::to_string(first) + "-" + std::to_string(last) + "/" +
+                   std::to_string(content_.size()) + "\r\n";
+      }
+      headers += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+      if (!keepAlive_) {
+        headers += "Connection: close\r\n";
+        open = false;
+      }
+      std::string response = "HTTP/1.1 " + status + "\r\n" + headers + "\r\n";
+      if (request.compare(0, 4, "HEAD") != 0)
+        response += body;
+      if (send(fd, response.data(), response.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(response.size()))
+        open = false;
+    }
+    shutdown(fd, SHUT_RDWR);
+  }
+
+  //! Close \em fd like a server which drops idle connections, so that the client gets EPIPE when it sends
+  void reset(int fd) {
+    shutdown(fd, SHUT_WR);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    linger abort = {1, 0};
+    setsockopt(fd, SOL_SOCKET, SO_LINGER, &abort, sizeof(abort));
+    std::lock_guard lock(mutex_);
+    clientFds_.erase(std::find(clientFds_.begin(), clientFds_.end(), fd));
+    close(fd);
+  }
+
+  std::string content_;
+  bool keepAlive_;
+  std::chrono::milliseconds idleTimeout_;
+  int listenFd_;
+  uint16_t port_;
+  std::atomic<size_t> connections_{0};
+  std::atomic<size_t> requests_{0};
+  std::mutex mutex_;
+  std::vector<int> clientFds_;
+  std::vector<std::thread> clients_;
+  std::thread acceptor_;
+};
+
+std::string readTestFile(const std::string& name) {
+  std::ifstream file(std::string(TESTDATA_PATH "/") + name, std::ios::binary);
+  return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+Exiv2::Dictionary requestFor(const StandInServer& server) {
+  const auto uri = Exiv2::Uri::Parse(server.url("/image.jpg"));
+  return {{"server", uri.Host}, {"port", uri.Port}, {"page", uri.Path}, {"verb", "GET"}};
+}
+}  // namespace
+
+TEST(HttpConnection, keepsTheConnectionOpenBetweenRequests) {
+  StandInServer server("0123456789");
+  Exiv2::HttpConnection connection;
+  for (int i = 0; i < 3; ++i) {
+    auto request = requestFor(server);
+    request["header"] = "Range: bytes=2-5";
+    Exiv2::Dictionary response;
+    std::string errors;
+    ASSERT_EQ(206, connection.request(request, response, errors));
+    ASSERT_EQ("2345", response["body"]);
+  }
+  ASSERT_EQ(1U, connection.connects());
+  ASSERT_EQ(3U, connection.requests());
+  ASSERT_EQ(1U, server.connections());
+}
+
+TEST(HttpConnection, reconnectsWhenTheServerClosesTheConnection) {
+  StandInServer server("0123456789", false);
+  Exiv2::HttpConnection connection;
+  for (int i = 0; i < 2; ++i) {
+    auto request = requestFor(server);
+    Exiv2::Dictionary response;
+    std::string errors;
+    ASSERT_EQ(200, connection.request(request, response, errors));
+    ASSERT_EQ("0123456789", response["body"]);
+  }
+  ASSERT_EQ(2U, connection.connects());
+  ASSERT_EQ(2U, server.connections());
+}
+
+TEST(HttpConnection, reconnectsWhenTheServerClosesAnIdleConnection) {
+  // Sending on the reset connection must fail, not raise SIGPIPE and end the process
+  StandInServer server("0123456789", true, std::chrono::milliseconds(50));
+  Exiv2::HttpConnection connection;
+  for (int i = 0; i < 2; ++i) {
+    auto request = requestFor(server);
+    Exiv2::Dictionary response;
+    std::string errors;
+    ASSERT_EQ(200, connection.request(request, response, errors));
+    ASSERT_EQ("0123456789", response["body"]);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  }
+  ASSERT_EQ(2U, connection.connects());
+  ASSERT_EQ(2U, server.connections());
+}
+
+TEST(HttpIo, fetchesAdjacentMissingBlocksWithOneRequest) {
+  const std::string content = readTestFile("Reagan.jpg");
+  StandInServer server(content);
+  Exiv2::HttpIo io(server.url("/Reagan.jpg"), 1024);
+  ASSERT_EQ(0, io.open());
+  Exiv2::DataBuf buf(5000);
+  ASSERT_EQ(5000U, io.read(buf.data(), buf.size()));
+  ASSERT_EQ(0, buf.cmpBytes(0, content.data(), buf.size()));
+  // HEAD for the size, one GET for the five blocks
+  ASSERT_EQ(2U, server.requests());
+  ASSERT_EQ(1U, server.connections());
+  ASSERT_EQ(2U, io.requests());
+}
+
+TEST(HttpIo, readsAheadWhileReadingSequentially) {
+  const std::string content = readTestFile("Reagan.jpg");
+  auto readStart = [&](size_t readahead) {
+    StandInServer server(content);
+    Exiv2::HttpIo io(server.url("/Reagan.jpg"), 1024);
+    io.setReadahead(readahead);
+    EXPECT_EQ(0, io.open());
+    Exiv2::DataBuf buf(100);
+    for (size_t offset = 0; offset + buf.size() <= 16 * 1024; offset += buf.size()) {
+      EXPECT_EQ(buf.size(), io.read(buf.data(), buf.size()));
+      EXPECT_EQ(0, buf.cmpBytes(0, content.data() + offset, buf.size()));
+    }
+    EXPECT_EQ(server.requests(), io.requests());
+    return io.requests();
+  };
+  // HEAD and one GET per block without readahead
+  ASSERT_EQ(17U, readStart(0));
+  ASSERT_LE(readStart(64 * 1024), 6U);
+}
+
+TEST(HttpIo, readsAheadLessAfterASeek) {
+  const std::string content = readTestFile("Reagan.jpg");
+  StandInServer server(content);
+  Exiv2::HttpIo io(server.url("/Reagan.jpg"), 1024);
+  ASSERT_EQ(0, io.open());
+  Exiv2::DataBuf buf(100);
+  size_t fetched = 0;
+  size_t sequential = 0;
+  for (size_t offset = 0; offset < 8 * 1024; offset += buf.size()) {
+    ASSERT_EQ(buf.size(), io.read(buf.data(), buf.size()));
+    if (io.bytesFetched() != fetched)
+      sequential = io.bytesFetched() - fetched;
+    fetched = io.bytesFetched();
+  }
+  io.seek(30000, Exiv2::BasicIo::beg);
+  ASSERT_EQ(buf.size(), io.read(buf.data(), buf.size()));
+  ASSERT_EQ(0, buf.cmpBytes(0, content.data() + 30000, buf.size()));
+  ASSERT_LT(io.bytesFetched() - fetched, sequential);
+}
+
+TEST(HttpIo, readsMetadataOverOneConnection) {
+  const std::string content = readTestFile("Reagan.jpg");
+  StandInServer server(content);
+  auto image = Exiv2::ImageFactory::open(server.url("/Reagan.jpg"));
+  image->readMetadata();
+  auto local = Exiv2::ImageFactory::open(TESTDATA_PATH "/Reagan.jpg");
+  local->readMetadata();
+  ASSERT_EQ(local->exifData().count(), image->exifData().count());
+  ASSERT_EQ(1U, server.connections());
+}
+#endif
@@ -4,6 +4,18 @@
 #include <exiv2/exiv2.hpp>
 #include <image_int.hpp>
 
+#include "tempdir.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+
+#ifdef __linux__
+#include <sys/xattr.h>
+#endif
+
+namespace fs = std::filesystem;
+
 using namespace Exiv2::Internal;
 using Exiv2::makeSlice;
 using Exiv2::Slice;
@@ -45,3 +57,81 @@ TEST(binaryToString, nonZeroStart) {
   // start @ index 3, read until end
   checkBinaryToString(makeSlice(b, 3, sizeof(b)), "...e..a");
 }
+
+class CreateTempFileFor : public TempDir {};
+
+TEST_F(CreateTempFileFor, createsAnEmptyFileNextToALocalFile) {
+  const auto path = copyTestData("DSC_3079.jpg");
+  Exiv2::FileIo io(path);
+  auto tempIo = createTempFileFor(io);
+  ASSERT_TRUE(tempIo);
+  ASSERT_TRUE(tempIo->isopen());
+  ASSERT_EQ(0u, tempIo->size());
+  ASSERT_EQ(fs::canonical(path).parent_path(), fs::path(tempIo->path()).parent_path());
+  ASSERT_NE(path, tempIo->path());
+}
+
+TEST_F(CreateTempFileFor, returnsNullForMemIoAndHardLinkedFiles) {
+  Exiv2::MemIo memIo;
+  ASSERT_FALSE(createTempFileFor(memIo));
+
+  const auto path = copyTestData("DSC_3079.jpg");
+  fs::create_hard_link(path, this->path("link.jpg"));
+  Exiv2::FileIo io(path);
+  ASSERT_FALSE(createTempFileFor(io));
+}
+
+TEST_F(CreateTempFileFor, returnsNullForSymbolicLinks) {
+  const auto path = copyTestData("smiley2.jpg");
+  const auto link = this->path("link.jpg");
+  std::error_code ec;
+  fs::create_symlink(path, link, ec);
+  if (ec)
+    GTEST_SKIP() << "No symbolic links: " << ec.message();
+  Exiv2::FileIo io(link);
+  ASSERT_FALSE(createTempFileFor(io));
+
+  // Writing through the link changes the file it points to
+  {
+    auto image = Exiv2::ImageFactory::open(link);
+    image->readMetadata();
+    image->exifData()["Exif.Image.Artist"] = "Exiv2";
+    image->writeMetadata();
+  }
+  ASSERT_TRUE(fs::is_symlink(link));
+  auto image = Exiv2::ImageFactory::open(path);
+  image->readMetadata();
+  ASSERT_EQ("Exiv2", image->exifData()["Exif.Image.Artist"].toString());
+}
+
+#ifdef __linux__
+TEST_F(CreateTempFileFor, returnsNullForFilesWithExtendedAttributes) {
+  const auto path = copyTestData("smiley2.jpg");
+  Exiv2::FileIo io(path);
+  auto tempIo = createTempFileFor(io);
+  ASSERT_TRUE(tempIo);
+  tempIo->close();
+  fs::remove(tempIo->path());
+
+  if (::setxattr(path.c_str(), "user.exiv2", "1", 1, 0) != 0)
+    GTEST_SKIP() << "No extended attributes: " << std::strerror(errno);
+  ASSERT_FALSE(createTempFileFor(io));
+}
+#endif
+
+TEST(findXmpPadding, findsTheWhitespaceBeforeThePacketTrailer) {
+  const auto padding = findXmpPadding("<?xpacket begin=''?><x:xmpmeta/>  \n <?xpacket end='w'?>");
+  ASSERT_TRUE(padding);
+  ASSERT_EQ(32U, padding->start_);
+  ASSERT_EQ(36U, padding->end_);
+  ASSERT_FALSE(findXmpPadding("<x:xmpmeta/>"));
+}
+
+TEST(resizeXmpPadding, growsAndShrinksThePadding) {
+  std::string packet = "<x:xmpmeta/>  <?xpacket end='w'?>";
+  ASSERT_TRUE(resizeXmpPadding(packet, 39));
+  ASSERT_EQ("<x:xmpmeta/>        <?xpacket end='w'?>", packet);
+  ASSERT_TRUE(resizeXmpPadding(packet, 31));
+  ASSERT_EQ("<x:xmpmeta/><?xpacket end='w'?>", packet);
+  ASSERT_FALSE(resizeXmpPadding(packet, 30));
+}
@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <exiv2/exiv2.hpp>
+
+#include "tempdir.hpp"
+
+#include <filesystem>
+#include <iterator>
+
+namespace fs = std::filesystem;
+using namespace Exiv2;
+
+#ifdef EXV_ENABLE_FILESYSTEM
+TEST(ExifScan, readsTheRequestedTagsOnly) {
+  auto image = ImageFactory::open(TESTDATA_PATH "/FurnaceCreekInn.jpg");
+  ExifScan scan;
+  scan.addKey("Exif.Image.Model");
+  scan.addKey("Exif.Photo.DateTimeOriginal");
+  scan.addKey("Exif.GPSInfo.GPSLatitude");
+  scan.addKey("Exif.Image.Artist");
+  ASSERT_THROW(scan.addKey("Exif.Nikon3.Version"), Error);
+  image->scanExif(scan);
+  ASSERT_TRUE(image->exifData().empty());
+
+  image->readMetadata();
+  const auto count = image->exifData().count();
+  image->scanExif(scan);
+  ASSERT_EQ(count, image->exifData().count());
+  for (const auto& key : scan.keys()) {
+    auto pos = image->exifData().findKey(ExifKey(key));
+    if (pos == image->exifData().end()) {
+      ASSERT_EQ(nullptr, scan.value(key));
+    } else {
+      ASSERT_NE(nullptr, scan.value(key));
+      ASSERT_EQ(pos->typeId(), scan.value(key)->typeId());
+      ASSERT_EQ(pos->toString(), scan.value(key)->toString());
+    }
+  }
+  ASSERT_NE(nullptr, scan.value("Exif.GPSInfo.GPSLatitude"));
+  ASSERT_EQ(nullptr, scan.value("Exif.Image.Make"));
+}
+
+class AJpegImage : public TempDir {};
+
+TEST_F(AJpegImage, isRewrittenThroughATemporaryFile) {
+  // The image has no XMP packet with padding, the metadata can't be written in place
+  const auto path = copyTestData("smiley2.jpg");
+  const auto size = fs::file_size(path);
+  {
+    auto image = ImageFactory::open(path);
+    image->readMetadata();
+    image->exifData()["Exif.Image.Artist"] = "Exiv2";
+    image->writeMetadata();
+    ASSERT_FALSE(image->writeResult().inPlace_);
+  }
+  auto image = ImageFactory::open(path);
+  image->readMetadata();
+  ASSERT_EQ("Exiv2", image->exifData()["Exif.Image.Artist"].toString());
+  ASSERT_GT(fs::file_size(path), size);
+  // Only the image itself is left in the directory, no temporary file
+  ASSERT_EQ(1, std::distance(fs::directory_iterator(dir()), fs::directory_iterator()));
+}
+
+TEST_F(AJpegImage, isPatchedInPlaceIfTheMetadataFits) {
+  // The XMP packet padding makes room for the new tag
+  const auto path = copyTestData("DSC_3079.jpg");
+  const auto link = this->path("link.jpg");
+  fs::create_hard_link(path, link);
+  const auto size = fs::file_size(path);
+  {
+    auto image = ImageFactory::open(path);
+    image->readMetadata();
+    image->exifData()["Exif.Image.Artist"] = "Exiv2";
+    image->writeMetadata();
+    ASSERT_TRUE(image->writeResult().inPlace_);
+  }
+  auto image = ImageFactory::open(link);
+  image->readMetadata();
+  ASSERT_EQ("Exiv2", image->exifData()["Exif.Image.Artist"].toString());
+  ASSERT_EQ(fs::file_size(path), size);
+  ASSERT_EQ(2U, fs::hard_link_count(path));
+}
+
+TEST_F(AJpegImage, reservesSpaceForLaterEditsInPlace) {
+  const auto path = copyTestData("smiley2.jpg");
+  {
+    auto image = ImageFactory::open(path);
+    image->readMetadata();
+    image->setWritePolicy({4096, 1024});
+    image->exifData()["Exif.Image.Artist"] = "Exiv2";
+    image->xmpData()["Xmp.dc.format"] = "image/jpeg";
+    image->writeMetadata();
+    ASSERT_FALSE(image->writeResult().inPlace_);
+    ASSERT_LE(4096U, image->writeResult().xmpPadding_);
+    ASSERT_EQ(1024U, image->writeResult().exifPadding_);
+  }
+  const auto size = fs::file_size(path);
+  {
+    auto image = ImageFactory::open(path);
+    image->readMetadata();
+    image->setWritePolicy({4096, 1024});
+    image->exifData()["Exif.Image.Artist"] = "The Exiv2 project";
+    image->exifData()["Exif.Image.Copyright"] = "Public domain";
+    image->writeMetadata();
+    ASSERT_TRUE(image->writeResult().inPlace_);
+    ASSERT_LT(0, image->writeResult().reserveUsed_);
+  }
+  ASSERT_EQ(fs::file_size(path), size);
+  auto image = ImageFactory::open(path);
+  image->readMetadata();
+  ASSERT_EQ("Public domain", image->exifData()["Exif.Image.Copyright"].toString());
+  ASSERT_EQ("image/jpeg", image->xmpData()["Xmp.dc.format"].toString());
+}
+#endif
@@ -1,5 +1,6 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <exiv2/exiv2.hpp>
 #include <exiv2/pngimage.hpp>
 #include "pngchunk_int.hpp"  // This is not part of the public API
 
@@ -180,3 +181,25 @@ TEST(isPngType, withMemIoInErroneousStatusThrows) {
     ASSERT_EQ(ErrorCode::kerInputDataReadFailed, e.code());
   }
 }
+
+#ifdef EXV_ENABLE_FILESYSTEM
+TEST(PngImage, scanExifLeavesTheMetadataUnchanged) {
+  auto image = ImageFactory::open(TESTDATA_PATH "/ReaganSmallPng.png");
+  image->readMetadata();
+  const auto exifCount = image->exifData().count();
+  const auto xmpCount = image->xmpData().count();
+  const auto width = image->pixelWidth();
+
+  ExifScan scan;
+  scan.addKey("Exif.Image.Model");
+  scan.addKey("Exif.Photo.BodySerialNumber");
+  image->scanExif(scan);
+  ASSERT_EQ("NIKON D1X", scan.value("Exif.Image.Model")->toString());
+  ASSERT_EQ(nullptr, scan.value("Exif.Photo.BodySerialNumber"));
+  ASSERT_EQ(exifCount, image->exifData().count());
+  ASSERT_EQ(xmpCount, image->xmpData().count());
+  ASSERT_EQ(width, image->pixelWidth());
+  ASSERT_FALSE(image->partialMetadata());
+  ASSERT_TRUE(image->readFilter().empty());
+}
+#endif
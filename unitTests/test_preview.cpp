@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <exiv2/exiv2.hpp>
+
+#include <algorithm>
+#include <cstdio>
+
+using namespace Exiv2;
+
+namespace {
+Image::UniquePtr openImage(const std::string& name) {
+  auto image = ImageFactory::open(std::string(TESTDATA_PATH "/") + name);
+  image->readMetadata();
+  return image;
+}
+}  // namespace
+
+TEST(PreviewManager, listsTheSizesOfThePreviewImages) {
+  // A native preview, JPEG previews in the Exif data and a TIFF preview
+  for (auto name : {"exiv2-photoshop.psd", "exiv2-nikon-d70.jpg", "ReaganLargeTiff.tiff"}) {
+    auto image = openImage(name);
+    PreviewManager manager(*image);
+    const auto list = manager.getPreviewProperties();
+    ASSERT_FALSE(list.empty()) << name;
+    for (auto&& props : list) {
+      ASSERT_EQ(props.size_, manager.getPreviewImage(props).size()) << name << " preview " << props.id_;
+    }
+  }
+}
+
+TEST(PreviewManager, returnsAViewOfAPreviewStoredInTheFile) {
+  auto image = openImage("exiv2-photoshop.psd");
+  PreviewManager manager(*image);
+  const auto list = manager.getPreviewProperties();
+  ASSERT_EQ(1U, list.size());
+  const PreviewImage copy = manager.getPreviewImage(list.front());
+  ASSERT_FALSE(copy.isView());
+
+  auto view = std::make_unique<PreviewImage>(manager.getPreviewImageView(list.front()));
+  ASSERT_TRUE(view->isView());
+  ASSERT_EQ(copy.size(), view->size());
+  ASSERT_TRUE(std::equal(copy.pData(), copy.pData() + copy.size(), view->pData()));
+
+  // The view keeps a mapping of its own, which copies of the view share
+  image->io().close();
+  image.reset();
+  const PreviewImage viewCopy = *view;
+  view.reset();
+  ASSERT_TRUE(viewCopy.isView());
+  ASSERT_TRUE(std::equal(copy.pData(), copy.pData() + copy.size(), viewCopy.pData()));
+}
+
+TEST(PreviewManager, returnsACopyOfAPreviewAssembledFromTheMetadata) {
+  auto image = openImage("ReaganLargeTiff.tiff");
+  PreviewManager manager(*image);
+  const auto list = manager.getPreviewProperties();
+  ASSERT_EQ(1U, list.size());
+  const PreviewImage copy = manager.getPreviewImage(list.front());
+  const PreviewImage view = manager.getPreviewImageView(list.front());
+  ASSERT_FALSE(view.isView());
+  ASSERT_EQ(copy.size(), view.size());
+  ASSERT_TRUE(std::equal(copy.pData(), copy.pData() + copy.size(), view.pData()));
+}
+
+TEST(PreviewManager, writesThePreviewImagesLikeTheCopies) {
+  for (auto name : {"exiv2-photoshop.psd", "exiv2-nikon-d70.jpg", "ReaganLargeTiff.tiff"}) {
+    auto image = openImage(name);
+    PreviewManager manager(*image);
+    for (auto&& props : manager.getPreviewProperties()) {
+      const PreviewImage copy = manager.getPreviewImage(props);
+      MemIo io;
+      ASSERT_EQ(copy.size(), manager.writePreviewImage(props, io)) << name << " preview " << props.id_;
+      ASSERT_EQ(copy.size(), io.size());
+      ASSERT_TRUE(std::equal(copy.pData(), copy.pData() + copy.size(), io.mmap())) << name << " preview " << props.id_;
+    }
+  }
+}
+
+#ifdef EXV_ENABLE_FILESYSTEM
+TEST(PreviewManager, writesThePreviewImagesToAFileDescriptor) {
+  for (auto name : {"exiv2-photoshop.psd", "ReaganLargeTiff.tiff"}) {
+    auto image = openImage(name);
+    PreviewManager manager(*image);
+    const auto list = manager.getPreviewProperties();
+    ASSERT_EQ(1U, list.size());
+    const PreviewImage copy = manager.getPreviewImage(list.front());
+
+    const std::string path = std::string(name) + "-preview.tmp";
+    FILE* fp = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(nullptr, fp);
+    const size_t written = manager.writePreviewImage(list.front(), fileno(fp));
+    std::fclose(fp);
+    const DataBuf buf = readFile(path);
+    std::remove(path.c_str());
+    ASSERT_EQ(copy.size(), written);
+    ASSERT_EQ(copy.size(), buf.size());
+    ASSERT_TRUE(std::equal(copy.pData(), copy.pData() + copy.size(), buf.c_data()));
+  }
+}
+#endif
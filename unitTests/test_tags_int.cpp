@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+#include <exiv2/exiv2.hpp>
+#include <tags_int.hpp>
+
+using namespace Exiv2::Internal;
+using Exiv2::GroupInfo;
+using Exiv2::IfdId;
+
+TEST(tagInfo, findsTagByNumber) {
+  auto ti = tagInfo(0x010f, IfdId::ifd0Id);
+  ASSERT_NE(nullptr, ti);
+  ASSERT_STREQ("Make", ti->name_);
+  // IFD0 and IFD1 share their tag list
+  ASSERT_EQ(ti, tagInfo(0x010f, IfdId::ifd1Id));
+}
+
+TEST(tagInfo, returnsEndOfListMarkerForUnknownTagNumber) {
+  auto ti = tagInfo(0xfffe, IfdId::exifId);
+  ASSERT_NE(nullptr, ti);
+  ASSERT_EQ(0xffff, ti->tag_);
+  ASSERT_EQ(nullptr, tagInfo(0x010f, IfdId::ifdIdNotSet));
+}
+
+TEST(tagInfo, findsTagByName) {
+  auto ti = tagInfo("ExposureTime", IfdId::exifId);
+  ASSERT_NE(nullptr, ti);
+  ASSERT_EQ(0x829a, ti->tag_);
+  ASSERT_EQ(nullptr, tagInfo("NoSuchTag", IfdId::exifId));
+  ASSERT_EQ(nullptr, tagInfo("", IfdId::exifId));
+  ASSERT_EQ(nullptr, tagInfo("ExposureTime", IfdId::ifdIdNotSet));
+}
+
+TEST(tagInfo, findsTagsOfAllGroups) {
+  for (auto gi = groupList(); gi->tagList_; ++gi) {
+    for (auto ti = gi->tagList_(); ti->tag_ != 0xffff; ++ti) {
+      auto byNumber = tagInfo(ti->tag_, gi->ifdId_);
+      ASSERT_NE(nullptr, byNumber);
+      ASSERT_EQ(ti->tag_, byNumber->tag_);
+      auto byName = tagInfo(ti->name_, gi->ifdId_);
+      ASSERT_NE(nullptr, byName);
+      ASSERT_STREQ(ti->name_, byName->name_);
+    }
+  }
+}
+
+TEST(groupId, mapsGroupNamesToIfdIds) {
+  ASSERT_EQ(IfdId::ifd0Id, groupId("Image"));
+  ASSERT_EQ(IfdId::exifId, groupId("Photo"));
+  ASSERT_EQ(IfdId::canonId, groupId("Canon"));
+  ASSERT_TRUE(isMakerIfd(groupId("Canon")));
+  ASSERT_EQ(IfdId::ifdIdNotSet, groupId("NoSuchGroup"));
+  ASSERT_EQ(IfdId::ifdIdNotSet, groupId(""));
+  for (auto gi = groupList(); gi->tagList_; ++gi) {
+    ASSERT_EQ(gi->ifdId_, groupId(groupName(gi->ifdId_)));
+    ASSERT_STREQ(gi->ifdName_, ifdName(gi->ifdId_));
+  }
+  ASSERT_STREQ("Unknown", groupName(IfdId::ifdIdNotSet));
+}
@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <exiv2/exiv2.hpp>
+
+#include "tempdir.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace Exiv2;
+
+TEST(ExifScan, readsTheTiffDataOfRawFormats) {
+  std::ifstream file(TESTDATA_PATH "/exiv2-bug1062.jpg", std::ios::binary);
+  const std::string data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+  const auto start = data.find(std::string("Exif\0\0", 6)) + 6;
+  std::vector<byte> tiff(data.begin() + start, data.end());
+
+  ExifScan scan;
+  scan.addKey("Exif.Image.Model");
+  scan.addKey("Exif.Photo.ExposureTime");
+  ASSERT_EQ(littleEndian, ExifParser::scan(scan, tiff.data(), tiff.size()));
+  ASSERT_EQ("NIKON D5300", scan.value("Exif.Image.Model")->toString());
+  ASSERT_EQ("10/1000", scan.value("Exif.Photo.ExposureTime")->toString());
+
+  // The headers of ORF and RW2 files differ from TIFF only in the magic number
+  for (auto [magic, parse] : {std::pair{0x4f52, &OrfParser::scan}, std::pair{0x0055, &Rw2Parser::scan}}) {
+    us2Data(tiff.data() + 2, static_cast<uint16_t>(magic), littleEndian);
+    scan.clear();
+    ASSERT_EQ(nullptr, scan.value("Exif.Image.Model"));
+    ASSERT_EQ(littleEndian, parse(scan, tiff.data(), tiff.size()));
+    ASSERT_EQ("NIKON D5300", scan.value("Exif.Image.Model")->toString());
+    ASSERT_EQ("10/1000", scan.value("Exif.Photo.ExposureTime")->toString());
+    ASSERT_THROW(TiffParser::scan(scan, tiff.data(), tiff.size()), Error);
+  }
+}
+
+#ifdef EXV_ENABLE_FILESYSTEM
+class ATiffImage : public TempDir {};
+
+TEST_F(ATiffImage, reservesSpaceForLaterEditsInPlace) {
+  const auto path = copyTestData("mini9.tif");
+  {
+    auto image = ImageFactory::open(path);
+    image->readMetadata();
+    image->setWritePolicy({4096, 0});
+    image->xmpData()["Xmp.dc.format"] = "image/tiff";
+    image->writeMetadata();
+    ASSERT_FALSE(image->writeResult().inPlace_);
+    ASSERT_LE(4096U, image->writeResult().xmpPadding_);
+    // The packet encoded for the file does not replace the state of the caller
+    ASSERT_TRUE(image->xmpData().xmpPacket().empty());
+    ASSERT_FALSE(image->xmpData().usePacket());
+  }
+  const auto size = fs::file_size(path);
+  {
+    auto image = ImageFactory::open(path);
+    image->readMetadata();
+    image->setWritePolicy({4096, 0});
+    const std::string packet = image->xmpData().xmpPacket();
+    ASSERT_FALSE(packet.empty());
+    image->xmpData()["Xmp.dc.source"] = "The Exiv2 project";
+    image->writeMetadata();
+    ASSERT_TRUE(image->writeResult().inPlace_);
+    ASSERT_LT(0, image->writeResult().reserveUsed_);
+    ASSERT_EQ(packet, image->xmpData().xmpPacket());
+  }
+  ASSERT_EQ(fs::file_size(path), size);
+  auto image = ImageFactory::open(path);
+  image->readMetadata();
+  ASSERT_EQ("The Exiv2 project", image->xmpData()["Xmp.dc.source"].toString());
+  ASSERT_EQ("image/tiff", image->xmpData()["Xmp.dc.format"].toString());
+}
+#endif
@@ -1,5 +1,6 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <exiv2/error.hpp>
 #include <exiv2/types.hpp>
 
 #include <gtest/gtest.h>
@@ -7,6 +8,7 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <iomanip>
 #include <limits>
 
 using namespace Exiv2;
@@ -127,6 +129,114 @@ TEST(DataBuf, readWriteEndianess) {
   ASSERT_EQ(buf.read_uint64(4 + 1 + 2 + 4, littleEndian), 0x08090a0b0c0d0e0fULL);
 }
 
+TEST(copyValues, convertsLikeTheFunctionsForSingleValues) {
+  std::array<byte, 8 * 40> data;
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<byte>(i * 7 + 1);
+
+  // Cover both the SIMD loops and the remainders after them
+  for (auto byteOrder : {littleEndian, bigEndian}) {
+    for (size_t count = 0; count <= 40; ++count) {
+      std::array<uint16_t, 40> us{};
+      copyValues(us.data(), data.data(), count, 2, byteOrder);
+      std::array<uint32_t, 40> ul{};
+      copyValues(ul.data(), data.data(), count, 4, byteOrder);
+      std::array<uint64_t, 40> ull{};
+      copyValues(ull.data(), data.data(), count, 8, byteOrder);
+      for (size_t i = 0; i < count; ++i) {
+        ASSERT_EQ(getUShort(data.data() + (2 * i), byteOrder), us[i]);
+        ASSERT_EQ(getULong(data.data() + (4 * i), byteOrder), ul[i]);
+        ASSERT_EQ(getULongLong(data.data() + (8 * i), byteOrder), ull[i]);
+      }
+      std::array<byte, 8 * 40> back{};
+      copyValues(back.data(), ull.data(), count, 8, byteOrder);
+      ASSERT_TRUE(std::equal(back.begin(), back.begin() + (8 * count), data.begin()));
+    }
+  }
+}
+
+TEST(copyValues, copiesBytesAndRejectsOtherSizes) {
+  const std::array<byte, 6> data{1, 2, 3, 4, 5, 6};
+  std::array<byte, 6> copy{};
+  copyValues(copy.data(), data.data(), data.size(), 1, bigEndian);
+  ASSERT_EQ(data, copy);
+  ASSERT_THROW(copyValues(copy.data(), data.data(), 2, 3, bigEndian), Error);
+  ASSERT_THROW(copyValues(copy.data(), data.data(), 2, 3, littleEndian), Error);
+}
+
+namespace {
+//! Parse \em str like ValueType::read() did with a stream only
+template <typename T>
+bool streamParse(const std::string& str, std::vector<T>& values) {
+  std::istringstream is(str);
+  T tmp;
+  while (is >> tmp)
+    values.push_back(tmp);
+  return is.eof();
+}
+
+template <typename T>
+void expectParsesLikeAStream(const std::string& str) {
+  std::vector<T> values;
+  if (!parseNumbers(str, values))
+    return;  // Left to the stream
+  std::vector<T> expected;
+  ASSERT_TRUE(streamParse(str, expected)) << str;
+  ASSERT_EQ(expected, values) << str;
+}
+
+template <typename T>
+void expectFormatsLikeAStream(T value, int precision) {
+  std::ostringstream os;
+  os << std::setprecision(precision) << value;
+  std::string str;
+  appendNumber(str, value, precision);
+  ASSERT_EQ(os.str(), str);
+}
+}  // namespace
+
+TEST(parseNumbers, parsesLikeAStream) {
+  for (std::string str : {"", " ", "0", "1 2 3", " 12\t\n34 ", "+5", "-5", "--5", "+-5", "+", "-", "1-2", "1+2",
+                          "007", "65535", "65536", "-32768", "-32769", "4294967295", "4294967296", "12abc", "1.5",
+                          ".5", "5.", "-.5", "1e5", "1E-5", "1e", "1e+", "inf", "nan", "0x10", "1/2", "1 / 2",
+                          "-1/3 4/5", "1/", "/2", "F2.8", "f2.8", "1/2/3", "2147483648/1", "1e-400", "1e400"}) {
+    expectParsesLikeAStream<uint16_t>(str);
+    expectParsesLikeAStream<int16_t>(str);
+    expectParsesLikeAStream<uint32_t>(str);
+    expectParsesLikeAStream<int32_t>(str);
+    expectParsesLikeAStream<float>(str);
+    expectParsesLikeAStream<double>(str);
+    expectParsesLikeAStream<URational>(str);
+    expectParsesLikeAStream<Rational>(str);
+  }
+  std::vector<URational> values;
+  ASSERT_TRUE(parseNumbers("1/3 -1/2", values));
+  ASSERT_EQ((std::vector<URational>{{1, 3}, {0xffffffff, 2}}), values);
+}
+
+TEST(appendNumber, formatsLikeAStream) {
+  for (int precision : {1, 2, 5, 6, 15}) {
+    for (double d : {0.0, -0.0, 1.0, 0.1, 2.8, 1.0 / 3, -2.0 / 3, 1e-7, 123456789.0, 1e300, 5e-324}) {
+      expectFormatsLikeAStream(d, precision);
+      expectFormatsLikeAStream(static_cast<float>(d), precision);
+    }
+  }
+  expectFormatsLikeAStream(std::numeric_limits<int32_t>::min(), 15);
+  expectFormatsLikeAStream(std::numeric_limits<uint32_t>::max(), 15);
+  expectFormatsLikeAStream(Rational{-2, 3}, 15);
+  expectFormatsLikeAStream(URational{1, 3}, 15);
+}
+
+TEST(toFixedString, formatsLikeAStream) {
+  for (int precision : {0, 1, 2}) {
+    for (double d : {0.0, 0.05, 0.25, 2.5, -1.35, 1234.5678, 1e20, 1e300}) {
+      std::ostringstream os;
+      os << std::fixed << std::setprecision(precision) << d;
+      ASSERT_EQ(os.str(), toFixedString(d, precision));
+    }
+  }
+}
+
 TEST(Rational, floatToRationalCast) {
   static const float floats[] = {0.5F, 0.015F, 0.0000625F};
 